@@ -34,21 +34,35 @@
 
 namespace CRP {
 
-CRPQuery::CRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
+template<template<class> class Queue>
+CRPQuery<Queue>::CRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
 	const count vectorSize = 2 * graph.getMaxEdgesInCell() + overlayGraph.numberOfVertices();
-	forwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0});
-	backwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0});	
+	forwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0, 0});
+	backwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0, 0});	
 	
-	forwardGraphPQ = MinIDQueue<IDKeyTriple>(2 * graph.getMaxEdgesInCell());
-	forwardOverlayGraphPQ = MinIDQueue<IDKeyTriple>(overlayGraph.numberOfVertices());
+	forwardGraphPQ = Queue<IDKeyTriple>(2 * graph.getMaxEdgesInCell());
+	forwardOverlayGraphPQ = Queue<IDKeyTriple>(overlayGraph.numberOfVertices());
 
-	backwardGraphPQ = MinIDQueue<IDKeyTriple>(2*graph.getMaxEdgesInCell());
-	backwardOverlayGraphPQ = MinIDQueue<IDKeyTriple>(overlayGraph.numberOfVertices());
+	backwardGraphPQ = Queue<IDKeyTriple>(2*graph.getMaxEdgesInCell());
+	backwardOverlayGraphPQ = Queue<IDKeyTriple>(overlayGraph.numberOfVertices());
 
 	currentRound = 0;
 }
 
-QueryResult CRPQuery::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
+template<template<class> class Queue>
+void CRPQuery<Queue>::nextRound() {
+	if (++currentRound == 0) {
+		// the counter wrapped around, so labels of old rounds would look current
+		for (index i = 0; i < forwardInfo.size(); ++i) {
+			forwardInfo[i].round = forwardInfo[i].stallRound = 0;
+			backwardInfo[i].round = backwardInfo[i].stallRound = 0;
+		}
+		currentRound = 1;
+	}
+}
+
+template<template<class> class Queue>
+QueryResult CRPQuery<Queue>::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
 	const BackwardEdge &backwardEdgeToStart = graph.getBackwardEdge(graph.getEntryOffset(sourceVertexId));
 	index sourceEdgeId = graph.getExitOffset(backwardEdgeToStart.tail) + backwardEdgeToStart.exitPoint;
 
@@ -58,8 +72,10 @@ QueryResult CRPQuery::vertexQuery(index sourceVertexId, index targetVertexId, in
 	return edgeQuery(sourceEdgeId, targetEdgeId, metricId);
 }
 
-QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
-	currentRound++;
+template<template<class> class Queue>
+QueryResult CRPQuery<Queue>::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
+	nextRound();
+	QUERY_STATS(const long long searchStart = get_micro_time();)
 
 	const index s = graph.getForwardEdge(sourceEdgeId).head;
 	const index sGlobalId = graph.getEntryOffset(s) + graph.getForwardEdge(sourceEdgeId).entryPoint;
@@ -81,15 +97,11 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 	assert(tBackwardId < 2*graph.getMaxEdgesInCell());
 
 	weight shortestPath = 2 * inf_weight;
-	for (index i = 0; i < overlayOffset; ++i) {
-			forwardInfo[i].dist = inf_weight;
-			backwardInfo[i].dist = inf_weight;
-	}
 
-	forwardInfo[sForwardId] = {0, currentRound, {s, sForwardId}};
+	forwardInfo[sForwardId] = {0, currentRound, 0, {s, sForwardId}};
 	forwardGraphPQ.push({sForwardId, s, 0});
 
-	backwardInfo[tBackwardId] = {0, currentRound, {t, tBackwardId}};
+	backwardInfo[tBackwardId] = {0, currentRound, 0, {t, tBackwardId}};
 	backwardGraphPQ.push({tBackwardId, t, 0});
 
 	VertexIdPair forwardMid;
@@ -104,6 +116,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 		if (minGraph < minOverlay) { // graph vertex
 			if (forwardGraphPQ.peekKey() < backwardGraphPQ.peekKey()) { // search forward
 				IDKeyTriple triple = forwardGraphPQ.pop();
+				QUERY_STATS(++stats.settledGraphVertices;)
 				index u = triple.vertexId;
 				index uId = triple.id;
 				turnorder entryPoint;
@@ -119,13 +132,16 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 				index offset = uId < graph.getMaxEdgesInCell()? forwardSOffset : forwardTOffset;
 				for (index j = 0, entryId = graph.getEntryOffset(u) - offset; entryId < graph.getEntryOffset(u) + uInDeg - offset; ++entryId, ++j) {
 					if (forwardInfo[entryId].round < currentRound) { // only if we do not have a valid distance label already
-						forwardInfo[entryId].dist = std::min(forwardInfo[entryId].dist, (weight) std::max(0, (int) forwardInfo[uId].dist + metrics[metricId].getMaxEntryTurnTableDiff(u, uOffset + j)));
+						QUERY_STATS(++stats.stalledLabels;)
+						forwardInfo[entryId].dist = std::min(getStallBound(forwardInfo[entryId]), (weight) std::max(0, (int) forwardInfo[uId].dist + metrics[metricId].getMaxEntryTurnTableDiff(u, uOffset + j)));
+						forwardInfo[entryId].stallRound = currentRound;
 					}
 				}
 			
 
 				assert(entryPoint < graph.getInDegree(u));
 				graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
+					QUERY_STATS(++stats.relaxedEdges;)
 					index v = e.head;
 					level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
 					weight edgeWeight = metrics[metricId].getWeight(e.attributes);
@@ -146,10 +162,11 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 							assert(graph.getMaxEdgesInCell() <= vId && vId < 2*graph.getMaxEdgesInCell());
 						}
 
-						if (forwardInfo[vId].round < currentRound && newDist > forwardInfo[vId].dist) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
+						if (forwardInfo[vId].round < currentRound && newDist > getStallBound(forwardInfo[vId])) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
 						
 						if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
 							forwardInfo[vId].dist = newDist;
+							QUERY_STATS(stats.countQueueOperation(forwardGraphPQ, vId);)
 							forwardGraphPQ.pushOrDecrease({vId, v, newDist});
 							forwardInfo[vId].round = currentRound;
 							forwardInfo[vId].parent = {u, uId};
@@ -162,6 +179,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 									weight newPathLength = forwardInfo[vId].dist + metrics[metricId].getTurnCosts(vType) + backwardInfo[exitId].dist;
 									if (newPathLength < shortestPath) {
 										shortestPath = newPathLength;
+										QUERY_STATS(++stats.meetingPointUpdates;)
 										forwardMid = {v, vId};
 										backwardMid = {v, exitId};
 									}
@@ -175,11 +193,13 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 						assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
 						if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
 							forwardInfo[vId].dist = newDist;
+							QUERY_STATS(stats.countQueueOperation(forwardOverlayGraphPQ, v);)
 							forwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, newDist});
 							forwardInfo[vId].round = currentRound;
 							forwardInfo[vId].parent = {u, uId};
 							if (backwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < shortestPath) {
 								shortestPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
+								QUERY_STATS(++stats.meetingPointUpdates;)
 								forwardMid = {v, vId};
 								backwardMid = {v, vId};
 							}
@@ -188,6 +208,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 				});
 			} else { // search backward
 				IDKeyTriple triple = backwardGraphPQ.pop();
+				QUERY_STATS(++stats.settledGraphVertices;)
 				index u = triple.vertexId;
 				index uId = triple.id;
 				turnorder exitPoint;
@@ -204,11 +225,14 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 				index offset = uId < graph.getMaxEdgesInCell()? backwardSOffset : backwardTOffset;
 				for (index j = 0, exitId = graph.getExitOffset(u) - offset; exitId < graph.getExitOffset(u) + uOutDeg - offset; ++exitId, ++j) {
 					if (backwardInfo[exitId].round < currentRound) { // only if we do not have a valid distance label already
-						backwardInfo[exitId].dist = std::min(backwardInfo[exitId].dist, (weight) std::max(0, (int) backwardInfo[uId].dist + metrics[metricId].getMaxExitTurnTableDiff(u, uOffset + j)));
+						QUERY_STATS(++stats.stalledLabels;)
+						backwardInfo[exitId].dist = std::min(getStallBound(backwardInfo[exitId]), (weight) std::max(0, (int) backwardInfo[uId].dist + metrics[metricId].getMaxExitTurnTableDiff(u, uOffset + j)));
+						backwardInfo[exitId].stallRound = currentRound;
 					}
 				}
 
 				graph.forInEdgesOf(u, exitPoint, [&](const BackwardEdge &e, index entryPoint, Graph::TURN_TYPE type) {
+					QUERY_STATS(++stats.relaxedEdges;)
 					index v = e.tail;
 					level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
 					weight edgeWeight = metrics[metricId].getWeight(e.attributes);
@@ -230,10 +254,11 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 						}
 
 
-						if (backwardInfo[vId].round < currentRound && newDist > backwardInfo[vId].dist) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
+						if (backwardInfo[vId].round < currentRound && newDist > getStallBound(backwardInfo[vId])) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
 						
 						if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
 							backwardInfo[vId].dist = newDist;
+							QUERY_STATS(stats.countQueueOperation(backwardGraphPQ, vId);)
 							backwardGraphPQ.pushOrDecrease({vId, v, newDist});
 							backwardInfo[vId].round = currentRound;
 							backwardInfo[vId].parent = {u, uId};
@@ -246,6 +271,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 									weight newPathLength = forwardInfo[entryId].dist + metrics[metricId].getTurnCosts(vType) + backwardInfo[vId].dist;
 									if (newPathLength < shortestPath) {
 										shortestPath = newPathLength;
+										QUERY_STATS(++stats.meetingPointUpdates;)
 										forwardMid = {v, entryId};
 										backwardMid = {v, vId};
 									}
@@ -259,11 +285,13 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 						assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
 						if (backwardInfo[vId].round < currentRound || backwardInfo[uId].dist + edgeWeight < backwardInfo[vId].dist) {
 							backwardInfo[vId].dist = backwardInfo[uId].dist + edgeWeight;
+							QUERY_STATS(stats.countQueueOperation(backwardOverlayGraphPQ, v);)
 							backwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, backwardInfo[vId].dist});
 							backwardInfo[vId].round = currentRound;
 							backwardInfo[vId].parent = {u, uId};
 							if (forwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < shortestPath) {
 								shortestPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
+								QUERY_STATS(++stats.meetingPointUpdates;)
 								forwardMid = {v, vId};
 								backwardMid = {v, vId};
 							}
@@ -279,7 +307,9 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 				const OverlayVertex& uVertex = overlayGraph.getVertex(u);
 				assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
 				level uQueryLevel = triple.vertexId;
+				QUERY_STATS(stats.countSettledOverlayVertex(uQueryLevel);)
 				overlayGraph.forOutNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
+					QUERY_STATS(++stats.relaxedEdges;)
 					weight newDist = forwardInfo[uId].dist + metrics[metricId].getCellWeight(wOffset);
 					if (newDist >= inf_weight) return;
 					index vId = v + overlayOffset;
@@ -292,6 +322,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 
 						if (backwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < shortestPath) {
 							shortestPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
+							QUERY_STATS(++stats.meetingPointUpdates;)
 							forwardMid = {vVertex.originalVertex, vId};
 							backwardMid = {vVertex.originalVertex, vId};
 						}
@@ -317,10 +348,11 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 								originalWId -= forwardTOffset;
 							}
 
-							if (forwardInfo[originalWId].round < currentRound && newDist > forwardInfo[originalWId].dist) return;  // we haven't seen originalWId yet and we cannot improve anything from this entryPoint
+							if (forwardInfo[originalWId].round < currentRound && newDist > getStallBound(forwardInfo[originalWId])) return;  // we haven't seen originalWId yet and we cannot improve anything from this entryPoint
 
 							if (forwardInfo[originalWId].round < currentRound || newDist < forwardInfo[originalWId].dist) {
 								forwardInfo[originalWId].dist = newDist;
+								QUERY_STATS(stats.countQueueOperation(forwardGraphPQ, originalWId);)
 								forwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
 								forwardInfo[originalWId].round = currentRound;
 								forwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
@@ -333,6 +365,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 										weight newPathLength = forwardInfo[originalWId].dist + metrics[metricId].getTurnCosts(wType) + backwardInfo[exitId].dist;
 										if (newPathLength < shortestPath) {
 											shortestPath = newPathLength;
+											QUERY_STATS(++stats.meetingPointUpdates;)
 											forwardMid = {originalW, originalWId};
 											backwardMid = {originalW, exitId};
 										}
@@ -344,11 +377,13 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 							index wId = w + overlayOffset;
 							if (forwardInfo[wId].round < currentRound || newDist < forwardInfo[wId].dist) {
 								forwardInfo[wId].dist = newDist;
+								QUERY_STATS(stats.countQueueOperation(forwardOverlayGraphPQ, w);)
 								forwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel, newDist});
 								forwardInfo[wId].round = currentRound;
 								forwardInfo[wId].parent = {vVertex.originalVertex, vId};
 								if (backwardInfo[wId].round == currentRound && forwardInfo[wId].dist + backwardInfo[wId].dist < shortestPath) {
 									shortestPath = forwardInfo[wId].dist + backwardInfo[wId].dist;
+									QUERY_STATS(++stats.meetingPointUpdates;)
 									forwardMid = {wVertex.originalVertex, wId};
 									backwardMid = {wVertex.originalVertex, wId};
 								}
@@ -363,9 +398,13 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 				const OverlayVertex& uVertex = overlayGraph.getVertex(u);
 				assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
 				level uQueryLevel = triple.vertexId; 
+				QUERY_STATS(stats.countSettledOverlayVertex(uQueryLevel);)
 
-				overlayGraph.forInNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
-					weight newDist = backwardInfo[uId].dist + metrics[metricId].getCellWeight(wOffset);
+				// without the transposed cell matrices, the weights of a column are read with a stride
+				const bool transposed = metrics[metricId].hasTransposedCellWeights();
+				overlayGraph.forInNeighborsOf(u, uQueryLevel, transposed, [&](index v, index wOffset) {
+					QUERY_STATS(++stats.relaxedEdges;)
+					weight newDist = backwardInfo[uId].dist + (transposed ? metrics[metricId].getTransposedCellWeight(wOffset) : metrics[metricId].getCellWeight(wOffset));
 					if (newDist >= inf_weight) return;
 					index vId = v + overlayOffset;
 					if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
@@ -376,6 +415,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 						const OverlayVertex& vVertex = overlayGraph.getVertex(v);
 						if (forwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < shortestPath) {
 							shortestPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
+							QUERY_STATS(++stats.meetingPointUpdates;)
 							forwardMid = {vVertex.originalVertex, vId};
 							backwardMid = {vVertex.originalVertex, vId};
 						}
@@ -399,10 +439,11 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 								originalWId -= backwardTOffset;
 							}
 
-							if (backwardInfo[originalWId].round < currentRound && newDist > backwardInfo[originalWId].dist) return;  // we haven't seen originalWId yet and we cannot improve anything from this exitPoint
+							if (backwardInfo[originalWId].round < currentRound && newDist > getStallBound(backwardInfo[originalWId])) return;  // we haven't seen originalWId yet and we cannot improve anything from this exitPoint
 
 							if (backwardInfo[originalWId].round < currentRound || newDist < backwardInfo[originalWId].dist) {
 								backwardInfo[originalWId].dist = newDist;
+								QUERY_STATS(stats.countQueueOperation(backwardGraphPQ, originalWId);)
 								backwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
 								backwardInfo[originalWId].round = currentRound;
 								backwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
@@ -415,6 +456,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 										weight newPathLength = forwardInfo[entryId].dist + metrics[metricId].getTurnCosts(wType) + backwardInfo[originalWId].dist;
 										if (newPathLength < shortestPath) {
 											shortestPath = newPathLength;
+											QUERY_STATS(++stats.meetingPointUpdates;)
 											forwardMid = {originalW, entryId};
 											backwardMid = {originalW, originalWId};
 										}
@@ -426,11 +468,13 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 							index wId = w + overlayOffset;
 							if (backwardInfo[wId].round < currentRound || newDist < backwardInfo[wId].dist) {
 								backwardInfo[wId].dist = newDist;
+								QUERY_STATS(stats.countQueueOperation(backwardOverlayGraphPQ, w);)
 								backwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel,  newDist});
 								backwardInfo[wId].round = currentRound;
 								backwardInfo[wId].parent = {vVertex.originalVertex, vId};
 								if (forwardInfo[wId].round == currentRound && forwardInfo[wId].dist + backwardInfo[wId].dist < shortestPath) {
 									shortestPath = forwardInfo[wId].dist + backwardInfo[wId].dist;
+									QUERY_STATS(++stats.meetingPointUpdates;)
 									forwardMid = {wVertex.originalVertex, wId};
 									backwardMid = {wVertex.originalVertex, wId};
 								}
@@ -441,6 +485,7 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 			}
 		}
 	}
+	QUERY_STATS(stats.searchTime = get_micro_time() - searchStart;)
 
 	forwardGraphPQ.clear();
 	backwardGraphPQ.clear();
@@ -448,12 +493,15 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 	backwardOverlayGraphPQ.clear();
 
 	if (shortestPath == 2 * inf_weight) {
-		return QueryResult({}, inf_weight);
+		return finishQuery(QueryResult({}, inf_weight));
 	}
 
 #ifdef QUERYTEST
-	return QueryResult({}, shortestPath);
+	return finishQuery(QueryResult({}, shortestPath));
 #endif
+	if (!unpackPaths) {
+		return finishQuery(QueryResult({}, shortestPath));
+	}
 	
 	// extract forward path
 	std::vector<index> overlayPath;
@@ -507,14 +555,21 @@ QueryResult CRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 	pv start = get_micro_time();
 #endif
 
+	QUERY_STATS(const long long unpackStart = get_micro_time();)
 	std::vector<index> unpackedPath = pathUnpacker.unpackPath(idPath, sCellNumber, tCellNumber, metricId);
+	QUERY_STATS(stats.unpackTime = get_micro_time() - unpackStart;)
 
 #ifdef UNPACKPATHTEST
 	index pathUnpackTime = get_micro_time() - start;
 	shortestPath = pathUnpackTime;
 #endif
 
-	return QueryResult(unpackedPath, shortestPath);
+	return finishQuery(QueryResult(unpackedPath, shortestPath));
 }
 
+template class CRPQuery<BinaryIDQueue>;
+template class CRPQuery<MinIDQueue>;
+template class CRPQuery<OctaryIDQueue>;
+template class CRPQuery<RadixIDQueue>;
+
 } /* namespace CRP */
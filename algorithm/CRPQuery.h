@@ -42,13 +42,22 @@
 
 namespace CRP {
 
+/**
+ * @tparam Queue the priority queue, instantiated for BinaryIDQueue, MinIDQueue, OctaryIDQueue and RadixIDQueue
+ */
+template<template<class> class Queue = MinIDQueue>
 class CRPQuery : public Query {
 private:
 	PathUnpacker& pathUnpacker;
 
+	/*
+	 * A label is only valid if its round is the current one, so nothing has to be reset between queries. Stalling
+	 * writes an upper bound into dist of labels that have not been reached yet and marks it with stallRound.
+	 */
 	struct VertexInfo {
 		weight dist;
 		count round;
+		count stallRound;
 		VertexIdPair parent;
 	};
 
@@ -57,10 +66,16 @@ private:
 
 	count currentRound;
 
-	MinIDQueue<IDKeyTriple> forwardGraphPQ;
-	MinIDQueue<IDKeyTriple> backwardGraphPQ;
-	MinIDQueue<IDKeyTriple> forwardOverlayGraphPQ;
-	MinIDQueue<IDKeyTriple> backwardOverlayGraphPQ;
+	Queue<IDKeyTriple> forwardGraphPQ;
+	Queue<IDKeyTriple> backwardGraphPQ;
+	Queue<IDKeyTriple> forwardOverlayGraphPQ;
+	Queue<IDKeyTriple> backwardOverlayGraphPQ;
+
+	inline weight getStallBound(const VertexInfo &info) const {
+		return info.stallRound == currentRound ? info.dist : inf_weight;
+	}
+
+	void nextRound();
 
 public:
 	CRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker);
@@ -68,6 +83,11 @@ public:
 	
 	virtual QueryResult edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId);
 	virtual QueryResult vertexQuery(index sourceVertexId, index targetVertexId, index metricId);
+
+	virtual void bindMetrics(const std::vector<Metric>& metrics) {
+		Query::bindMetrics(metrics);
+		pathUnpacker.bindMetrics(metrics);
+	}
 };
 
 } /* namespace CRP */
@@ -27,21 +27,34 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 #include "CRPQueryUni.h"
+#include "../timer.h"
 
 namespace CRP {
 
-CRPQueryUni::CRPQueryUni(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
+template<template<class> class Queue>
+CRPQueryUni<Queue>::CRPQueryUni(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
 	dist = std::vector<weight>(graph.numberOfEdges() + overlayGraph.numberOfVertices(), inf_weight);
 	round = std::vector<count>(graph.numberOfEdges() + overlayGraph.numberOfVertices(), 0);
 	parent = std::vector<VertexIdPair>(graph.numberOfEdges() + overlayGraph.numberOfVertices());
 	currentRound = 0;
-	graphPQ = MinIDQueue<IDKeyTriple>(graph.numberOfEdges());
-	overlayGraphPQ = MinIDQueue<IDKeyPair>(overlayGraph.numberOfVertices());
+	graphPQ = Queue<IDKeyTriple>(graph.numberOfEdges());
+	overlayGraphPQ = Queue<IDKeyPair>(overlayGraph.numberOfVertices());
 }
 
-QueryResult CRPQueryUni::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
+template<template<class> class Queue>
+void CRPQueryUni<Queue>::nextRound() {
+	if (++currentRound == 0) {
+		// the counter wrapped around, so labels of old rounds would look current
+		std::fill(round.begin(), round.end(), 0);
+		currentRound = 1;
+	}
+}
+
+template<template<class> class Queue>
+QueryResult CRPQueryUni<Queue>::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
 	const BackwardEdge& backwardEdgeToStart = graph.getBackwardEdge(graph.getEntryOffset(sourceVertexId));
 	index sourceEdgeId = graph.getExitOffset(backwardEdgeToStart.tail) + backwardEdgeToStart.exitPoint;
 
@@ -52,8 +65,10 @@ QueryResult CRPQueryUni::vertexQuery(index sourceVertexId, index targetVertexId,
 	return edgeQuery(sourceEdgeId, targetEdgeId, metricId);
 }
 
-QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
-	currentRound++;
+template<template<class> class Queue>
+QueryResult CRPQueryUni<Queue>::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
+	nextRound();
+	QUERY_STATS(const long long searchStart = get_micro_time();)
 	graphPQ.clear();
 	overlayGraphPQ.clear();
 
@@ -73,6 +88,7 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 	while (!graphPQ.empty() || !overlayGraphPQ.empty()) {
 		if (overlayGraphPQ.empty() || (!graphPQ.empty() && graphPQ.peek().key < overlayGraphPQ.peek().key)) { // graph vertex
 			IDKeyTriple triple = graphPQ.pop();
+			QUERY_STATS(++stats.settledGraphVertices;)
 			index u = triple.vertexId;
 			index uId = triple.id;
 			turnorder entryPoint = graph.getEntryOrder(u, uId);
@@ -83,10 +99,12 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 			if (u == t) {
 				if (dist[uId] < shortestPath) {
 					shortestPath = dist[uId];
+					QUERY_STATS(++stats.meetingPointUpdates;)
 					tId = uId;
 				}
 			}
 			graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
+				QUERY_STATS(++stats.relaxedEdges;)
 				index v = e.head;
 				level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
 				weight edgeWeight = metrics[metricId].getWeight(e.attributes);
@@ -100,6 +118,7 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 					index vId = graph.getEntryOffset(v) + e.entryPoint;
 					if (round[vId] < currentRound || newDist < dist[vId]) {
 						dist[vId] = newDist;
+						QUERY_STATS(stats.countQueueOperation(graphPQ, vId);)
 						graphPQ.pushOrDecrease({vId, v, newDist});
 						round[vId] = currentRound;
 						parent[vId] = {u, uId};
@@ -109,6 +128,7 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 					index vId = v + graph.numberOfEdges(); // add offset to differ between overlay and original graph vertices
 					if (round[vId] < currentRound || newDist < dist[vId]) {
 						dist[vId] = newDist;
+						QUERY_STATS(stats.countQueueOperation(overlayGraphPQ, v);)
 						overlayGraphPQ.pushOrDecrease({v, newDist});
 						round[vId] = currentRound;
 						parent[vId] = {u, uId};
@@ -121,7 +141,9 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 			if (round[uId] == currentRound && dist[uId] > shortestPath) break;
 
 			level uQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, overlayGraph.getVertex(u).cellNumber);
+			QUERY_STATS(stats.countSettledOverlayVertex(uQueryLevel);)
 			overlayGraph.forOutNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
+				QUERY_STATS(++stats.relaxedEdges;)
 				weight newDist = dist[uId] + metrics[metricId].getCellWeight(wOffset);
 				if (newDist >= inf_weight) return;
 				index vId = v + graph.numberOfEdges();
@@ -142,6 +164,7 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 						index originalWId = graph.getEntryOffset(originalW) + fEdge.entryPoint;
 						if (round[originalWId] < currentRound || newDist < dist[originalWId]) {
 							dist[originalWId] = newDist;
+							QUERY_STATS(stats.countQueueOperation(graphPQ, originalWId);)
 							graphPQ.pushOrDecrease({originalWId, originalW, newDist});
 							round[originalWId] = currentRound;
 							parent[originalWId] = {overlayGraph.getVertex(v).originalVertex, vId};
@@ -150,6 +173,7 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 						index wId = w + graph.numberOfEdges();
 						if (round[wId] < currentRound || newDist < dist[wId]) {
 							dist[wId] = newDist;
+							QUERY_STATS(stats.countQueueOperation(overlayGraphPQ, w);)
 							overlayGraphPQ.pushOrDecrease({w, newDist});
 							round[wId] = currentRound;
 							parent[wId] = {overlayGraph.getVertex(v).originalVertex, vId};
@@ -159,16 +183,20 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 			});
 		}
 	}
+	QUERY_STATS(stats.searchTime = get_micro_time() - searchStart;)
 	graphPQ.clear();
 	overlayGraphPQ.clear();
 
 	if (shortestPath == 2 * inf_weight) {
-		return QueryResult({}, inf_weight);
+		return finishQuery(QueryResult({}, inf_weight));
 	}
 
 #ifdef QUERYTEST
-	return QueryResult({}, shortestPath);
+	return finishQuery(QueryResult({}, shortestPath));
 #endif
+	if (!unpackPaths) {
+		return finishQuery(QueryResult({}, shortestPath));
+	}
 
 	std::vector<index> path;
 	std::vector<VertexIdPair> idPath;
@@ -189,16 +217,21 @@ QueryResult CRPQueryUni::edgeQuery(index sourceEdgeId, index targetEdgeId, index
 	pv start = get_micro_time();
 #endif
 
+	QUERY_STATS(const long long unpackStart = get_micro_time();)
 	std::vector<index> unpackedPath = pathUnpacker.unpackPath(idPath, sCellNumber, tCellNumber, metricId);
+	QUERY_STATS(stats.unpackTime = get_micro_time() - unpackStart;)
 
 #ifdef UNPACKPATHTEST
 	index pathUnpackTime = get_micro_time() - start;
 	shortestPath = pathUnpackTime;
 #endif
 
-	return QueryResult(unpackedPath, shortestPath);
+	return finishQuery(QueryResult(unpackedPath, shortestPath));
 }
 
-
+template class CRPQueryUni<BinaryIDQueue>;
+template class CRPQueryUni<MinIDQueue>;
+template class CRPQueryUni<OctaryIDQueue>;
+template class CRPQueryUni<RadixIDQueue>;
 
 } /* namespace CRP */
@@ -46,6 +46,10 @@ class PathUnpacker;
 
 namespace CRP {
 
+/**
+ * @tparam Queue the priority queue, instantiated for BinaryIDQueue, MinIDQueue, OctaryIDQueue and RadixIDQueue
+ */
+template<template<class> class Queue = MinIDQueue>
 class CRPQueryUni : public Query {
 private:
 	PathUnpacker& pathUnpacker;
@@ -55,8 +59,11 @@ private:
 	std::vector<VertexIdPair> parent;
 	count currentRound;
 
-	MinIDQueue<IDKeyTriple> graphPQ;
-	MinIDQueue<IDKeyPair> overlayGraphPQ;
+	Queue<IDKeyTriple> graphPQ;
+	Queue<IDKeyPair> overlayGraphPQ;
+
+	// labels are only valid if their round is the current one
+	void nextRound();
 
 public:
 	CRPQueryUni(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker);
@@ -64,6 +71,11 @@ public:
 	
 	virtual QueryResult edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId);
 	virtual QueryResult vertexQuery(index sourceVertexId, index targetVertexId, index metricId);
+
+	virtual void bindMetrics(const std::vector<Metric>& metrics) {
+		Query::bindMetrics(metrics);
+		pathUnpacker.bindMetrics(metrics);
+	}
 };
 
 } /* namespace CRP */
@@ -0,0 +1,225 @@
+/*
+ * ChainContraction.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ChainContraction.h"
+
+#include <algorithm>
+
+namespace CRP {
+
+ChainContraction::ChainContraction(const Graph &graph) : graph(graph), numRemoved(0) {
+}
+
+Graph ChainContraction::contract(EdgeGeometry &geometry) {
+	const count numVertices = graph.numberOfVertices();
+	removable.assign(numVertices, false);
+	for (index v = 0; v < numVertices; ++v) {
+		removable[v] = isRemovable(v);
+	}
+
+	// walk every chain once from one of its ends and keep a vertex wherever the length would overflow
+	std::vector<bool> visited(numVertices, false);
+	auto walkChains = [&](index s) {
+		for (index e = graph.getExitOffset(s); e < graph.getExitOffset(s) + graph.getOutDegree(s); ++e) {
+			index prev = s;
+			index cur = graph.getForwardEdge(e).head;
+			uint64_t length = getLength(graph.getForwardEdge(e).attributes);
+			while (removable[cur] && !visited[cur]) {
+				visited[cur] = true;
+				const index next = nextEdge(prev, cur);
+				const uint64_t edgeLength = getLength(graph.getForwardEdge(next).attributes);
+				if (length + edgeLength > maxLength) {
+					removable[cur] = false;
+					length = 0;
+				}
+				length += edgeLength;
+				prev = cur;
+				cur = graph.getForwardEdge(next).head;
+			}
+		}
+	};
+
+	for (index v = 0; v < numVertices; ++v) {
+		if (!removable[v]) walkChains(v);
+	}
+
+	// cycles that consist of removable vertices only keep one vertex
+	for (index v = 0; v < numVertices; ++v) {
+		if (removable[v] && !visited[v]) {
+			removable[v] = false;
+			walkChains(v);
+		}
+	}
+
+	// keep the first vertex of chains that would become loops or parallel edges until no such chain is left
+	bool changed = true;
+	std::vector<index> heads;
+	while (changed) {
+		changed = false;
+		for (index s = 0; s < numVertices; ++s) {
+			if (removable[s]) continue;
+			heads.clear();
+			for (index e = graph.getExitOffset(s); e < graph.getExitOffset(s) + graph.getOutDegree(s); ++e) {
+				uint64_t length;
+				index lastEdge;
+				index t = followChain(s, e, length, lastEdge, nullptr);
+				const index head = graph.getForwardEdge(e).head;
+				if (head != t && (t == s || std::find(heads.begin(), heads.end(), t) != heads.end())) {
+					removable[head] = false;
+					changed = true;
+					t = head;
+				}
+				heads.push_back(t);
+			}
+		}
+	}
+
+	std::vector<index> newId(numVertices, invalid_id);
+	std::vector<Vertex> vertices;
+	graph.forVertices([&](index v, const Vertex &vertex) {
+		if (!removable[v]) {
+			newId[v] = vertices.size();
+			vertices.push_back(vertex);
+		}
+	});
+	numRemoved = numVertices - vertices.size();
+
+	std::vector<ForwardEdge> forwardEdges;
+	std::vector<BackwardEdge> backwardEdges;
+	forwardEdges.reserve(graph.numberOfEdges());
+	backwardEdges.reserve(graph.numberOfEdges());
+	std::vector<Coordinate> points;
+	for (index s = 0; s < numVertices; ++s) {
+		if (removable[s]) continue;
+		vertices[newId[s]].firstOut = forwardEdges.size();
+		for (index e = graph.getExitOffset(s); e < graph.getExitOffset(s) + graph.getOutDegree(s); ++e) {
+			points.clear();
+			uint64_t length;
+			index lastEdge;
+			const index t = followChain(s, e, length, lastEdge, &points);
+			const ForwardEdge &first = graph.getForwardEdge(e);
+			forwardEdges.push_back({newId[t], graph.getForwardEdge(lastEdge).entryPoint, withLength(first.attributes, length)});
+
+			// a two-way chain is found from both ends, store its geometry once
+			if (!points.empty() && (graph.getOutDegree(first.head) == 1 || s < t)) {
+				geometry.addChain(graph.getCoordinate(s), graph.getCoordinate(t), points);
+			}
+		}
+	}
+
+	for (index t = 0; t < numVertices; ++t) {
+		if (removable[t]) continue;
+		vertices[newId[t]].firstIn = backwardEdges.size();
+		for (index b = graph.getEntryOffset(t); b < graph.getEntryOffset(t) + graph.getInDegree(t); ++b) {
+			index next = t;
+			index first = b;
+			uint64_t length = getLength(graph.getBackwardEdge(b).attributes);
+			index cur = graph.getBackwardEdge(b).tail;
+			while (removable[cur]) {
+				first = previousEdge(next, cur);
+				length += getLength(graph.getBackwardEdge(first).attributes);
+				next = cur;
+				cur = graph.getBackwardEdge(first).tail;
+			}
+			const BackwardEdge &edge = graph.getBackwardEdge(first);
+			backwardEdges.push_back({newId[cur], edge.exitPoint, withLength(edge.attributes, length)});
+		}
+	}
+
+	vertices.push_back({0, 0, (index) forwardEdges.size(), (index) backwardEdges.size(), {0, 0}});
+
+	return Graph(vertices, forwardEdges, backwardEdges, graph.getTurnTables());
+}
+
+bool ChainContraction::isRemovable(index v) const {
+	const index firstOut = graph.getExitOffset(v);
+	const index firstIn = graph.getEntryOffset(v);
+
+	if (graph.getInDegree(v) == 1 && graph.getOutDegree(v) == 1) {
+		const ForwardEdge &out = graph.getForwardEdge(firstOut);
+		const BackwardEdge &in = graph.getBackwardEdge(firstIn);
+		return in.tail != out.head && in.tail != v && out.head != v && sameType(in.attributes, out.attributes)
+				&& graph.getTurnType(v, (turnorder) 0, (turnorder) 0) == Graph::NONE;
+	}
+
+	if (graph.getInDegree(v) == 2 && graph.getOutDegree(v) == 2) {
+		const ForwardEdge &outA = graph.getForwardEdge(firstOut);
+		const ForwardEdge &outB = graph.getForwardEdge(firstOut + 1);
+		if (outA.head == outB.head || outA.head == v || outB.head == v) return false;
+
+		// entry point of the edge from the neighbor we leave to with outA
+		turnorder entryA;
+		if (graph.getBackwardEdge(firstIn).tail == outA.head) {
+			entryA = 0;
+		} else if (graph.getBackwardEdge(firstIn + 1).tail == outA.head) {
+			entryA = 1;
+		} else {
+			return false;
+		}
+		const turnorder entryB = 1 - entryA;
+		const BackwardEdge &inA = graph.getBackwardEdge(firstIn + entryA);
+		const BackwardEdge &inB = graph.getBackwardEdge(firstIn + entryB);
+		if (inB.tail != outB.head) return false;
+
+		return sameAttributes(inA.attributes, outA.attributes) && sameAttributes(inB.attributes, outB.attributes)
+				&& sameType(outA.attributes, outB.attributes)
+				&& graph.getTurnType(v, entryA, (turnorder) 1) == Graph::NONE && graph.getTurnType(v, entryB, (turnorder) 0) == Graph::NONE;
+	}
+
+	return false;
+}
+
+index ChainContraction::nextEdge(index prev, index cur) const {
+	const index firstOut = graph.getExitOffset(cur);
+	if (graph.getOutDegree(cur) == 1) return firstOut;
+	return graph.getForwardEdge(firstOut).head == prev ? firstOut + 1 : firstOut;
+}
+
+index ChainContraction::previousEdge(index next, index cur) const {
+	const index firstIn = graph.getEntryOffset(cur);
+	if (graph.getInDegree(cur) == 1) return firstIn;
+	return graph.getBackwardEdge(firstIn).tail == next ? firstIn + 1 : firstIn;
+}
+
+index ChainContraction::followChain(index s, index e, uint64_t &length, index &lastEdge, std::vector<Coordinate> *points) const {
+	index prev = s;
+	index cur = graph.getForwardEdge(e).head;
+	length = getLength(graph.getForwardEdge(e).attributes);
+	lastEdge = e;
+	while (removable[cur]) {
+		if (points != nullptr) {
+			points->push_back(graph.getCoordinate(cur));
+		}
+		lastEdge = nextEdge(prev, cur);
+		length += getLength(graph.getForwardEdge(lastEdge).attributes);
+		prev = cur;
+		cur = graph.getForwardEdge(lastEdge).head;
+	}
+	return cur;
+}
+
+} /* namespace CRP */
@@ -0,0 +1,107 @@
+/*
+ * ChainContraction.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALGORITHM_CHAINCONTRACTION_H_
+#define ALGORITHM_CHAINCONTRACTION_H_
+
+#include <vector>
+
+#include "../constants.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/EdgeGeometry.h"
+
+namespace CRP {
+
+/**
+ * Merges chains of degree-2 vertices into single edges. A vertex is removed if it lies inside a road without
+ * junction: it either has exactly one incoming and one outgoing edge from and to two different vertices, or
+ * edges in both directions to exactly two different neighbors. All edges at the vertex must have the same
+ * attributes apart from their length and passing through it must have turn type NONE.
+ *
+ * The merged edge gets the attributes of the first edge of the chain and the sum of the lengths. The order of
+ * the edges at the remaining vertices is kept, so their turn tables stay valid. A chain is not merged if it
+ * would become a loop, a second edge between the same vertices or too long for the length field.
+ */
+class ChainContraction {
+public:
+	ChainContraction(const Graph &graph);
+
+	/**
+	 * Computes the contracted graph. The coordinates of the removed vertices are added to @a geometry.
+	 * @param geometry receives one chain per merged edge (one for both directions of a two-way road)
+	 * @return the contracted graph
+	 */
+	Graph contract(EdgeGeometry &geometry);
+
+	inline count getNumberOfRemovedVertices() const {
+		return numRemoved;
+	}
+
+private:
+	static const uint64_t maxLength = (1 << 20) - 1;
+
+	const Graph &graph;
+	std::vector<bool> removable;
+	count numRemoved;
+
+	bool isRemovable(index v) const;
+
+	// the forward edge by which the chain leaves removable vertex cur after entering it from prev
+	index nextEdge(index prev, index cur) const;
+
+	// the backward edge by which the chain enters removable vertex cur when it is left towards next
+	index previousEdge(index next, index cur) const;
+
+	/**
+	 * Follows the chain that starts with forward edge @a e out of @a s up to the next vertex that is not removable.
+	 * @param length the sum of the edge lengths
+	 * @param lastEdge the last forward edge of the chain
+	 * @param points if not null, receives the coordinates of the removed vertices
+	 * @return the end vertex of the chain
+	 */
+	index followChain(index s, index e, uint64_t &length, index &lastEdge, std::vector<Coordinate> *points) const;
+
+	static inline uint64_t getLength(const EdgeAttributes &attributes) {
+		return attributes.stdAttributes >> 12;
+	}
+
+	static inline EdgeAttributes withLength(const EdgeAttributes &attributes, uint64_t length) {
+		return {(edgeAttr) ((length << 12) | (attributes.stdAttributes & 0xFFF)), attributes.maxHeight};
+	}
+
+	static inline bool sameAttributes(const EdgeAttributes &a, const EdgeAttributes &b) {
+		return a.stdAttributes == b.stdAttributes && a.maxHeight == b.maxHeight;
+	}
+
+	static inline bool sameType(const EdgeAttributes &a, const EdgeAttributes &b) {
+		return (a.stdAttributes & 0xFFF) == (b.stdAttributes & 0xFFF) && a.maxHeight == b.maxHeight;
+	}
+};
+
+} /* namespace CRP */
+
+#endif /* ALGORITHM_CHAINCONTRACTION_H_ */
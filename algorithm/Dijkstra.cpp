@@ -31,17 +31,30 @@
 #include <cassert>
 #include <string>
 
+#include "../timer.h"
+
 namespace CRP {
 
-Dijkstra::Dijkstra(const Graph &graph, const OverlayGraph &overlayGraph, const std::vector<Metric> &metrics) : Query(graph, overlayGraph, metrics) {
+template<template<class> class Queue>
+Dijkstra<Queue>::Dijkstra(const Graph &graph, const OverlayGraph &overlayGraph, const std::vector<Metric> &metrics) : Query(graph, overlayGraph, metrics) {
 	dist = std::vector<weight>(graph.numberOfEdges(), inf_weight);
 	round = std::vector<count>(graph.numberOfEdges(), 0);
 	parent = std::vector<VertexIdPair>(graph.numberOfEdges());
 	currentRound = 0;
-	graphPQ = MinIDQueue<IDKeyTriple>(graph.numberOfEdges());
+	graphPQ = Queue<IDKeyTriple>(graph.numberOfEdges());
 }
 
-QueryResult Dijkstra::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
+template<template<class> class Queue>
+void Dijkstra<Queue>::nextRound() {
+	if (++currentRound == 0) {
+		// the counter wrapped around, so labels of old rounds would look current
+		std::fill(round.begin(), round.end(), 0);
+		currentRound = 1;
+	}
+}
+
+template<template<class> class Queue>
+QueryResult Dijkstra<Queue>::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
 	BackwardEdge backwardEdgeToStart = graph.getBackwardEdge(graph.getEntryOffset(sourceVertexId));
 	index sourceEdgeId = graph.getExitOffset(backwardEdgeToStart.tail) + backwardEdgeToStart.exitPoint;
 
@@ -51,8 +64,10 @@ QueryResult Dijkstra::vertexQuery(index sourceVertexId, index targetVertexId, in
 	return edgeQuery(sourceEdgeId, targetEdgeId, metricId);
 }
 
-QueryResult Dijkstra::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
-	currentRound++;
+template<template<class> class Queue>
+QueryResult Dijkstra<Queue>::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
+	nextRound();
+	QUERY_STATS(const long long searchStart = get_micro_time();)
 	graphPQ.clear();
 
 	const index s = graph.getForwardEdge(sourceEdgeId).head;
@@ -68,6 +83,7 @@ QueryResult Dijkstra::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 
 	while (!graphPQ.empty()) {
 		IDKeyTriple triple = graphPQ.pop();
+		QUERY_STATS(++stats.settledGraphVertices;)
 		index u = triple.vertexId;
 		index uId = triple.id;
 		turnorder entryPoint = graph.getEntryOrder(u, uId);
@@ -78,11 +94,13 @@ QueryResult Dijkstra::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 			weight newShortestPath = dist[uId];
 			if (newShortestPath < shortestPath) {
 				shortestPath = newShortestPath;
+				QUERY_STATS(++stats.meetingPointUpdates;)
 				tId = uId;
 			}
 		}
 
 		graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
+			QUERY_STATS(++stats.relaxedEdges;)
 			index v = e.head;
 			weight edgeWeight = metrics[metricId].getWeight(e.attributes);
 			weight turnCosts = metrics[metricId].getTurnCosts(type);
@@ -94,15 +112,20 @@ QueryResult Dijkstra::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 			index vId = graph.getEntryOffset(v) + e.entryPoint;
 			if (round[vId] < currentRound || newDist < dist[vId]) {
 				dist[vId] = newDist;
+				QUERY_STATS(stats.countQueueOperation(graphPQ, vId);)
 				graphPQ.pushOrDecrease({vId, v, newDist});
 				round[vId] = currentRound;
 				parent[vId] = {u, uId};
 			}
 		});
 	}
+	QUERY_STATS(stats.searchTime = get_micro_time() - searchStart;)
 
 	if (shortestPath == 2 * inf_weight) {
-		return QueryResult({}, inf_weight);
+		return finishQuery(QueryResult({}, inf_weight));
+	}
+	if (!unpackPaths) {
+		return finishQuery(QueryResult({}, shortestPath));
 	}
 
 	std::vector<index> path;
@@ -115,7 +138,56 @@ QueryResult Dijkstra::edgeQuery(index sourceEdgeId, index targetEdgeId, index me
 
 	std::reverse(path.begin(), path.end());
 
-	return QueryResult(path, shortestPath);
+	return finishQuery(QueryResult(path, shortestPath));
 }
 
+template<template<class> class Queue>
+std::vector<index> Dijkstra<Queue>::computeSettleOrder(index sourceVertexId, index metricId) {
+	nextRound();
+	graphPQ.clear();
+
+	std::vector<bool> settled(graph.numberOfVertices(), false);
+	std::vector<index> order;
+
+	const index s = sourceVertexId;
+	const index sId = graph.getEntryOffset(s);
+	dist[sId] = 0;
+	round[sId] = currentRound;
+	graphPQ.push({sId, s, 0});
+
+	while (!graphPQ.empty()) {
+		IDKeyTriple triple = graphPQ.pop();
+		index u = triple.vertexId;
+		index uId = triple.id;
+		turnorder entryPoint = graph.getEntryOrder(u, uId);
+
+		if (!settled[u]) {
+			settled[u] = true;
+			order.push_back(u);
+		}
+
+		graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
+			index v = e.head;
+			weight turnCosts = u == s ? 0 : metrics[metricId].getTurnCosts(type);
+			weight newDist = dist[uId] + turnCosts + metrics[metricId].getWeight(e.attributes);
+
+			if (newDist >= inf_weight) return;
+
+			index vId = graph.getEntryOffset(v) + e.entryPoint;
+			if (round[vId] < currentRound || newDist < dist[vId]) {
+				dist[vId] = newDist;
+				graphPQ.pushOrDecrease({vId, v, newDist});
+				round[vId] = currentRound;
+			}
+		});
+	}
+
+	return order;
+}
+
+template class Dijkstra<BinaryIDQueue>;
+template class Dijkstra<MinIDQueue>;
+template class Dijkstra<OctaryIDQueue>;
+template class Dijkstra<RadixIDQueue>;
+
 } /* namespace CRP */
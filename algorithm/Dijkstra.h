@@ -40,6 +40,10 @@
 
 namespace CRP {
 
+/**
+ * @tparam Queue the priority queue, instantiated for BinaryIDQueue, MinIDQueue, OctaryIDQueue and RadixIDQueue
+ */
+template<template<class> class Queue = MinIDQueue>
 class Dijkstra : public Query {
 private:
 	std::vector<weight> dist;
@@ -47,7 +51,10 @@ private:
 	std::vector<VertexIdPair> parent;
 	count currentRound;
 
-	MinIDQueue<IDKeyTriple> graphPQ;
+	Queue<IDKeyTriple> graphPQ;
+
+	// labels are only valid if their round is the current one
+	void nextRound();
 
 public:
 	Dijkstra(const Graph &graph, const OverlayGraph &overlayGraph, const std::vector<Metric> &metrics);
@@ -56,6 +63,14 @@ public:
 	virtual QueryResult edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId);
 	virtual QueryResult vertexQuery(index sourceVertexId, index targetVertexId, index metricId);
 
+	/**
+	 * Runs Dijkstra from @a sourceVertexId without a target, starting on the same edge as vertexQuery. The position
+	 * of a vertex in the returned order is its Dijkstra rank with respect to the source.
+	 * @param sourceVertexId
+	 * @param metricId
+	 * @return all reachable vertices in the order in which they are settled for the first time, starting with the source
+	 */
+	std::vector<index> computeSettleOrder(index sourceVertexId, index metricId);
 
 };
 
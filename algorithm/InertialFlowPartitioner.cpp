@@ -0,0 +1,408 @@
+/*
+ * InertialFlowPartitioner.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "InertialFlowPartitioner.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace CRP {
+
+namespace {
+const int NUM_DIRECTIONS = 4;
+const std::string PREFIX = "inertial:";
+}
+
+InertialFlowPartitioner::InertialFlowPartitioner(const Graph& graph, float balance) : graph(graph), balance(std::min(balance, 0.5f)) {
+	buildUndirectedGraph();
+}
+
+bool InertialFlowPartitioner::isSpecification(const std::string& specification) {
+	return specification.compare(0, PREFIX.size(), PREFIX) == 0;
+}
+
+bool InertialFlowPartitioner::parseSpecification(const std::string& specification, std::vector<count>& maxCellSizes) {
+	if (!isSpecification(specification)) return false;
+	return MultiLevelPartition::parseCellSizes(specification.substr(PREFIX.size()), maxCellSizes);
+}
+
+void InertialFlowPartitioner::buildUndirectedGraph() {
+	const count numVertices = graph.numberOfVertices();
+	std::vector<index> firstEntry(numVertices + 1, 0);
+	graph.forEdges([&](index u, index v, index) {
+		if (u != v) {
+			++firstEntry[u + 1];
+			++firstEntry[v + 1];
+		}
+	});
+	std::partial_sum(firstEntry.begin(), firstEntry.end(), firstEntry.begin());
+
+	std::vector<index> entries(firstEntry.back());
+	std::vector<index> position(firstEntry.begin(), firstEntry.end() - 1);
+	graph.forEdges([&](index u, index v, index) {
+		if (u != v) {
+			entries[position[u]++] = v;
+			entries[position[v]++] = u;
+		}
+	});
+
+	// merge parallel and antiparallel edges, the capacity is the number of merged edges
+	std::vector<index> numNeighbors(numVertices + 1, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (index u = 0; u < numVertices; ++u) {
+		std::sort(entries.begin() + firstEntry[u], entries.begin() + firstEntry[u + 1]);
+		for (index k = firstEntry[u]; k < firstEntry[u + 1]; ++k) {
+			if (k == firstEntry[u] || entries[k] != entries[k - 1]) ++numNeighbors[u + 1];
+		}
+	}
+
+	firstNeighbor.resize(numVertices + 1);
+	std::partial_sum(numNeighbors.begin(), numNeighbors.end(), firstNeighbor.begin());
+	neighbors.resize(firstNeighbor.back());
+	neighborCapacity.resize(firstNeighbor.back());
+
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (index u = 0; u < numVertices; ++u) {
+		index pos = firstNeighbor[u];
+		for (index k = firstEntry[u]; k < firstEntry[u + 1]; ++k) {
+			if (k == firstEntry[u] || entries[k] != entries[k - 1]) {
+				neighbors[pos] = entries[k];
+				neighborCapacity[pos] = 1;
+				++pos;
+			} else {
+				++neighborCapacity[pos - 1];
+			}
+		}
+	}
+}
+
+MultiLevelPartition InertialFlowPartitioner::partition(const std::vector<count>& maxCellSizes) {
+	const count numVertices = graph.numberOfVertices();
+	const count numLevels = maxCellSizes.size();
+
+	std::vector<std::vector<index>> cells;
+	if (numVertices > 0) {
+		cells.push_back(std::vector<index>(numVertices));
+		std::iota(cells[0].begin(), cells[0].end(), 0);
+	}
+
+	std::vector<std::vector<index>> cellIds(numLevels, std::vector<index>(numVertices));
+	std::vector<index> cellOf(numVertices);
+	std::vector<index> localId(numVertices);
+
+	for (level l = numLevels - 1; l != static_cast<level>(-1); --l) {
+		while (true) {
+			std::vector<index> cellsToSplit;
+			for (index c = 0; c < cells.size(); ++c) {
+				if (cells[c].size() > maxCellSizes[l]) cellsToSplit.push_back(c);
+			}
+			if (cellsToSplit.empty()) break;
+
+#pragma omp parallel for schedule(dynamic)
+			for (index c = 0; c < cells.size(); ++c) {
+				for (index i = 0; i < cells[c].size(); ++i) {
+					cellOf[cells[c][i]] = c;
+					localId[cells[c][i]] = i;
+				}
+			}
+
+			std::vector<CellGraph> cellGraphs(cellsToSplit.size());
+#pragma omp parallel for schedule(dynamic)
+			for (index k = 0; k < cellsToSplit.size(); ++k) {
+				buildCellGraph(cells[cellsToSplit[k]], cellOf, localId, cellGraphs[k]);
+			}
+
+			// every direction of every cell is an independent task, so even the first bisection runs in parallel
+			std::vector<Cut> cuts(cellsToSplit.size() * NUM_DIRECTIONS);
+#pragma omp parallel for schedule(dynamic)
+			for (index t = 0; t < cuts.size(); ++t) {
+				cuts[t] = computeCut(cells[cellsToSplit[t / NUM_DIRECTIONS]], cellGraphs[t / NUM_DIRECTIONS], t % NUM_DIRECTIONS);
+			}
+			std::vector<CellGraph>().swap(cellGraphs);
+
+			// replace every split cell by its two halves, keeping the order of the cells
+			std::vector<std::vector<index>> newCells;
+			newCells.reserve(cells.size() + cellsToSplit.size());
+			index k = 0;
+			for (index c = 0; c < cells.size(); ++c) {
+				if (k == cellsToSplit.size() || cellsToSplit[k] != c) {
+					newCells.push_back(std::move(cells[c]));
+					continue;
+				}
+
+				const Cut* best = &cuts[k * NUM_DIRECTIONS];
+				for (int d = 1; d < NUM_DIRECTIONS; ++d) {
+					const Cut& cut = cuts[k * NUM_DIRECTIONS + d];
+					const count imbalance = std::max(cut.sourceSideSize, (count) cells[c].size() - cut.sourceSideSize);
+					const count bestImbalance = std::max(best->sourceSideSize, (count) cells[c].size() - best->sourceSideSize);
+					if (cut.cutSize < best->cutSize || (cut.cutSize == best->cutSize && imbalance < bestImbalance)) {
+						best = &cut;
+					}
+				}
+
+				std::vector<index> sourceSide;
+				std::vector<index> sinkSide;
+				sourceSide.reserve(best->sourceSideSize);
+				sinkSide.reserve(cells[c].size() - best->sourceSideSize);
+				for (index i = 0; i < cells[c].size(); ++i) {
+					if (best->sourceSide[i]) {
+						sourceSide.push_back(cells[c][i]);
+					} else {
+						sinkSide.push_back(cells[c][i]);
+					}
+				}
+				newCells.push_back(std::move(sourceSide));
+				newCells.push_back(std::move(sinkSide));
+				++k;
+			}
+			cells.swap(newCells);
+		}
+
+#pragma omp parallel for schedule(dynamic)
+		for (index c = 0; c < cells.size(); ++c) {
+			for (index v : cells[c]) {
+				cellIds[l][v] = c;
+			}
+		}
+	}
+
+	MultiLevelPartition mlp;
+	mlp.setNumberOfLevels(numLevels);
+	mlp.setNumberOfVertices(numVertices);
+	for (level l = 0; l < numLevels; ++l) {
+		mlp.setNumberOfCellsInLevel(l, numVertices > 0 ? *std::max_element(cellIds[l].begin(), cellIds[l].end()) + 1 : 0);
+	}
+	if (!mlp.computeBitmap()) return MultiLevelPartition();
+	for (index v = 0; v < numVertices; ++v) {
+		for (level l = 0; l < numLevels; ++l) {
+			mlp.setCell(l, v, cellIds[l][v]);
+		}
+	}
+
+	countBoundaryEdges(cellIds);
+	return mlp;
+}
+
+void InertialFlowPartitioner::buildCellGraph(const std::vector<index>& cell, const std::vector<index>& cellOf, const std::vector<index>& localId, CellGraph& cellGraph) const {
+	const count numVertices = cell.size();
+	const index cellId = cellOf[cell[0]];
+
+	cellGraph.firstArc.assign(numVertices + 1, 0);
+	for (index i = 0; i < numVertices; ++i) {
+		for (index k = firstNeighbor[cell[i]]; k < firstNeighbor[cell[i] + 1]; ++k) {
+			if (cellOf[neighbors[k]] == cellId) ++cellGraph.firstArc[i + 1];
+		}
+	}
+	std::partial_sum(cellGraph.firstArc.begin(), cellGraph.firstArc.end(), cellGraph.firstArc.begin());
+
+	const count numArcs = cellGraph.firstArc.back();
+	cellGraph.head.resize(numArcs);
+	cellGraph.capacity.resize(numArcs);
+	cellGraph.reverseArc.resize(numArcs);
+	for (index i = 0; i < numVertices; ++i) {
+		index arc = cellGraph.firstArc[i];
+		for (index k = firstNeighbor[cell[i]]; k < firstNeighbor[cell[i] + 1]; ++k) {
+			if (cellOf[neighbors[k]] == cellId) {
+				cellGraph.head[arc] = localId[neighbors[k]];
+				cellGraph.capacity[arc] = neighborCapacity[k];
+				++arc;
+			}
+		}
+	}
+
+	// the arcs of a vertex are sorted by the original id of their heads
+	for (index i = 0; i < numVertices; ++i) {
+		for (index arc = cellGraph.firstArc[i]; arc < cellGraph.firstArc[i + 1]; ++arc) {
+			const index j = cellGraph.head[arc];
+			auto it = std::lower_bound(cellGraph.head.begin() + cellGraph.firstArc[j], cellGraph.head.begin() + cellGraph.firstArc[j + 1], i,
+					[&](index lhs, index rhs) {
+				return cell[lhs] < cell[rhs];
+			});
+			assert(*it == i);
+			cellGraph.reverseArc[arc] = it - cellGraph.head.begin();
+		}
+	}
+}
+
+InertialFlowPartitioner::Cut InertialFlowPartitioner::computeCut(const std::vector<index>& cell, const CellGraph& cellGraph, int direction) const {
+	const count numVertices = cell.size();
+	assert(numVertices >= 2);
+
+	auto projection = [&](index i) {
+		const Coordinate coord = graph.getCoordinate(cell[i]);
+		switch (direction) {
+		case 0:
+			return coord.lon;
+		case 1:
+			return coord.lat;
+		case 2:
+			return coord.lat + coord.lon;
+		default:
+			return coord.lat - coord.lon;
+		}
+	};
+	auto isBefore = [&](index lhs, index rhs) {
+		const float lhsProjection = projection(lhs);
+		const float rhsProjection = projection(rhs);
+		return lhsProjection < rhsProjection || (lhsProjection == rhsProjection && lhs < rhs);
+	};
+
+	// the first vertices along the direction are sources, the last ones sinks
+	const count numTerminals = std::max<count>(1, balance * numVertices);
+	std::vector<index> order(numVertices);
+	std::iota(order.begin(), order.end(), 0);
+	std::nth_element(order.begin(), order.begin() + numTerminals, order.end(), isBefore);
+	std::nth_element(order.begin() + numTerminals, order.end() - numTerminals, order.end(), isBefore);
+
+	enum Terminal : uint8_t {NO_TERMINAL, SOURCE, SINK};
+	std::vector<uint8_t> terminal(numVertices, NO_TERMINAL);
+	for (index i = 0; i < numTerminals; ++i) {
+		terminal[order[i]] = SOURCE;
+		terminal[order[numVertices - 1 - i]] = SINK;
+	}
+	std::vector<index>().swap(order);
+
+	// Dinic's algorithm with all sources and sinks merged into a super source and super sink
+	std::vector<int> flow(cellGraph.head.size(), 0);
+	auto residual = [&](index arc) {
+		return cellGraph.capacity[arc] - flow[arc];
+	};
+
+	std::vector<int> dist(numVertices);
+	std::vector<index> queue;
+	queue.reserve(numVertices);
+	std::vector<index> currentArc(numVertices);
+	std::vector<index> path;
+	count cutSize = 0;
+
+	while (true) {
+		std::fill(dist.begin(), dist.end(), -1);
+		queue.clear();
+		for (index i = 0; i < numVertices; ++i) {
+			if (terminal[i] == SOURCE) {
+				dist[i] = 0;
+				queue.push_back(i);
+			}
+		}
+
+		bool sinkReached = false;
+		for (index q = 0; q < queue.size(); ++q) {
+			const index v = queue[q];
+			if (terminal[v] == SINK) {
+				sinkReached = true;
+				continue;
+			}
+			for (index arc = cellGraph.firstArc[v]; arc < cellGraph.firstArc[v + 1]; ++arc) {
+				const index w = cellGraph.head[arc];
+				if (dist[w] == -1 && residual(arc) > 0) {
+					dist[w] = dist[v] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+		if (!sinkReached) break;
+
+		// blocking flow
+		std::copy(cellGraph.firstArc.begin(), cellGraph.firstArc.end() - 1, currentArc.begin());
+		for (index s = 0; s < numVertices; ++s) {
+			if (terminal[s] != SOURCE) continue;
+
+			path.clear();
+			index v = s;
+			while (true) {
+				if (terminal[v] == SINK) {
+					int bottleneck = INT_MAX;
+					for (index arc : path) {
+						bottleneck = std::min(bottleneck, residual(arc));
+					}
+					for (index arc : path) {
+						flow[arc] += bottleneck;
+						flow[cellGraph.reverseArc[arc]] -= bottleneck;
+					}
+					cutSize += bottleneck;
+					path.clear();
+					v = s;
+					continue;
+				}
+
+				index& arc = currentArc[v];
+				while (arc < cellGraph.firstArc[v + 1] && !(residual(arc) > 0 && dist[cellGraph.head[arc]] == dist[v] + 1)) {
+					++arc;
+				}
+
+				if (arc == cellGraph.firstArc[v + 1]) {
+					// dead end, retreat
+					dist[v] = -1;
+					if (path.empty()) break;
+					v = cellGraph.head[cellGraph.reverseArc[path.back()]];
+					path.pop_back();
+				} else {
+					path.push_back(arc);
+					v = cellGraph.head[arc];
+				}
+			}
+		}
+	}
+
+	// the source side of the minimum cut are all vertices reachable from the sources in the residual graph
+	Cut cut;
+	cut.cutSize = cutSize;
+	cut.sourceSide.assign(numVertices, false);
+	queue.clear();
+	for (index i = 0; i < numVertices; ++i) {
+		if (terminal[i] == SOURCE) {
+			cut.sourceSide[i] = true;
+			queue.push_back(i);
+		}
+	}
+	for (index q = 0; q < queue.size(); ++q) {
+		const index v = queue[q];
+		for (index arc = cellGraph.firstArc[v]; arc < cellGraph.firstArc[v + 1]; ++arc) {
+			const index w = cellGraph.head[arc];
+			if (!cut.sourceSide[w] && residual(arc) > 0) {
+				cut.sourceSide[w] = true;
+				queue.push_back(w);
+			}
+		}
+	}
+	cut.sourceSideSize = queue.size();
+	assert(cut.sourceSideSize < numVertices);
+
+	return cut;
+}
+
+void InertialFlowPartitioner::countBoundaryEdges(const std::vector<std::vector<index>>& cellIds) {
+	boundaryEdges.assign(cellIds.size(), 0);
+	graph.forEdges([&](index u, index v, index) {
+		for (level l = 0; l < cellIds.size(); ++l) {
+			if (cellIds[l][u] != cellIds[l][v]) ++boundaryEdges[l];
+		}
+	});
+}
+
+} /* namespace CRP */
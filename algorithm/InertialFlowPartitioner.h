@@ -0,0 +1,120 @@
+/*
+ * InertialFlowPartitioner.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALGORITHM_INERTIALFLOWPARTITIONER_H_
+#define ALGORITHM_INERTIALFLOWPARTITIONER_H_
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+
+namespace CRP {
+
+/**
+ * Computes a nested multi-level partition with inertial flow: a cell is bisected by sorting its vertices
+ * along several directions of their coordinates, taking the first and last fraction of them as sources and
+ * sinks and computing a minimum edge cut between both with a max flow. The direction with the smallest cut
+ * is used. Cells are split until they have at most the maximum cell size of the level, starting at the
+ * highest level so that every cell is contained in a cell of the next higher level.
+ */
+class InertialFlowPartitioner {
+public:
+	/**
+	 * @param graph the graph to partition
+	 * @param balance fraction of the vertices of a cell that is used as sources and as sinks, at most 0.5
+	 */
+	InertialFlowPartitioner(const Graph& graph, float balance = 0.25f);
+
+	/**
+	 * Returns true if @a specification has the form inertial:SIZE1,SIZE2,... and asks for an inertial flow
+	 * partition instead of naming a partition file.
+	 */
+	static bool isSpecification(const std::string& specification);
+
+	/**
+	 * Parses a partition specification of the form inertial:SIZE1,SIZE2,... into the maximum cell sizes per level.
+	 * @param specification the specification
+	 * @param maxCellSizes the maximum cell sizes, starting with the lowest level
+	 * @return false if @a specification does not describe an inertial flow partition or its cell sizes are invalid
+	 */
+	static bool parseSpecification(const std::string& specification, std::vector<count>& maxCellSizes);
+
+	/**
+	 * Partitions the graph.
+	 * @param maxCellSizes the maximum number of vertices of a cell on each level, starting with the lowest level
+	 * @return the multi-level partition, or an empty one if its cell numbers do not fit into a pv
+	 */
+	MultiLevelPartition partition(const std::vector<count>& maxCellSizes);
+
+	/**
+	 * Returns the number of edges whose endpoints are in different cells on level @a l (starting at 0)
+	 * of the last computed partition.
+	 */
+	inline count getNumberOfBoundaryEdges(level l) const {
+		assert(l < boundaryEdges.size());
+		return boundaryEdges[l];
+	}
+
+private:
+	/** Induced subgraph of a cell in which every undirected edge is stored as two arcs. */
+	struct CellGraph {
+		std::vector<index> firstArc;
+		std::vector<index> head;
+		std::vector<index> reverseArc;
+		std::vector<int> capacity;
+	};
+
+	/** Result of the bisection of a cell along one direction. */
+	struct Cut {
+		count cutSize;
+		std::vector<bool> sourceSide;
+		count sourceSideSize;
+	};
+
+	const Graph& graph;
+	const float balance;
+
+	// undirected graph with the number of original edges between two vertices as capacity
+	std::vector<index> firstNeighbor;
+	std::vector<index> neighbors;
+	std::vector<int> neighborCapacity;
+
+	std::vector<count> boundaryEdges;
+
+	void buildUndirectedGraph();
+	void buildCellGraph(const std::vector<index>& cell, const std::vector<index>& cellOf, const std::vector<index>& localId, CellGraph& cellGraph) const;
+	Cut computeCut(const std::vector<index>& cell, const CellGraph& cellGraph, int direction) const;
+	void countBoundaryEdges(const std::vector<std::vector<index>>& cellIds);
+};
+
+} /* namespace CRP */
+
+#endif /* ALGORITHM_INERTIALFLOWPARTITIONER_H_ */
@@ -32,25 +32,81 @@
 #include <cassert>
 
 #include "../timer.h"
-#include "omp.h"
 
 namespace CRP {
 
-ParallelCRPQuery::ParallelCRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
+template<template<class> class Queue>
+ParallelCRPQuery<Queue>::ParallelCRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker) : Query(graph, overlayGraph, metrics), pathUnpacker(pathUnpacker) {
 	const count vectorSize = 2 * graph.getMaxEdgesInCell() + overlayGraph.numberOfVertices();
-	forwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0});
-	backwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0});
+	forwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0, 0});
+	backwardInfo = std::vector<VertexInfo>(vectorSize, {inf_weight, 0, 0});
+
+	forwardReached.reset(new std::atomic<uint64_t>[vectorSize]);
+	backwardReached.reset(new std::atomic<uint64_t>[vectorSize]);
+	for (index i = 0; i < vectorSize; ++i) {
+		forwardReached[i].store(0, std::memory_order_relaxed);
+		backwardReached[i].store(0, std::memory_order_relaxed);
+	}
 
-	forwardGraphPQ = MinIDQueue<IDKeyTriple>(2 * graph.getMaxEdgesInCell());
-	forwardOverlayGraphPQ = MinIDQueue<IDKeyTriple>(overlayGraph.numberOfVertices());
+	forwardGraphPQ = Queue<IDKeyTriple>(2 * graph.getMaxEdgesInCell());
+	forwardOverlayGraphPQ = Queue<IDKeyTriple>(overlayGraph.numberOfVertices());
 
-	backwardGraphPQ = MinIDQueue<IDKeyTriple>(2*graph.getMaxEdgesInCell());
-	backwardOverlayGraphPQ = MinIDQueue<IDKeyTriple>(overlayGraph.numberOfVertices());
+	backwardGraphPQ = Queue<IDKeyTriple>(2*graph.getMaxEdgesInCell());
+	backwardOverlayGraphPQ = Queue<IDKeyTriple>(overlayGraph.numberOfVertices());
 
 	currentRound = 0;
+
+	forwardMinKey.store(0, std::memory_order_relaxed);
+	backwardMinKey.store(0, std::memory_order_relaxed);
+	tentativeDistance.store(2 * inf_weight, std::memory_order_relaxed);
+
+	backwardSearchPending = false;
+	shutdown = false;
+	backwardWorker = std::thread(&ParallelCRPQuery::runBackwardWorker, this);
+}
+
+template<template<class> class Queue>
+ParallelCRPQuery<Queue>::~ParallelCRPQuery() {
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		shutdown = true;
+	}
+	workerStart.notify_one();
+	backwardWorker.join();
+}
+
+template<template<class> class Queue>
+void ParallelCRPQuery<Queue>::runBackwardWorker() {
+	std::unique_lock<std::mutex> lock(workerMutex);
+	while (true) {
+		workerStart.wait(lock, [this] { return backwardSearchPending || shutdown; });
+		if (shutdown) return;
+
+		lock.unlock();
+		backwardSearch();
+		lock.lock();
+
+		backwardSearchPending = false;
+		workerDone.notify_one();
+	}
+}
+
+template<template<class> class Queue>
+void ParallelCRPQuery<Queue>::nextRound() {
+	if (++currentRound == 0) {
+		// the counter wrapped around, so labels of old rounds would look current
+		for (index i = 0; i < forwardInfo.size(); ++i) {
+			forwardInfo[i].round = forwardInfo[i].stallRound = 0;
+			backwardInfo[i].round = backwardInfo[i].stallRound = 0;
+			forwardReached[i].store(0, std::memory_order_relaxed);
+			backwardReached[i].store(0, std::memory_order_relaxed);
+		}
+		currentRound = 1;
+	}
 }
 
-QueryResult ParallelCRPQuery::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
+template<template<class> class Queue>
+QueryResult ParallelCRPQuery<Queue>::vertexQuery(index sourceVertexId, index targetVertexId, index metricId) {
 	const BackwardEdge &backwardEdgeToStart = graph.getBackwardEdge(graph.getEntryOffset(sourceVertexId));
 	index sourceEdgeId = graph.getExitOffset(backwardEdgeToStart.tail) + backwardEdgeToStart.exitPoint;
 
@@ -60,403 +116,485 @@ QueryResult ParallelCRPQuery::vertexQuery(index sourceVertexId, index targetVert
 	return edgeQuery(sourceEdgeId, targetEdgeId, metricId);
 }
 
-QueryResult ParallelCRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
-	currentRound++;
-
-	const index s = graph.getForwardEdge(sourceEdgeId).head;
-	const index sGlobalId = graph.getEntryOffset(s) + graph.getForwardEdge(sourceEdgeId).entryPoint;
-	const pv sCellNumber = graph.getCellNumber(s);
-	const index t = graph.getBackwardEdge(targetEdgeId).tail;
-	const pv tCellNumber = graph.getCellNumber(t);
-	const index tGlobalId = graph.getExitOffset(t) + graph.getBackwardEdge(targetEdgeId).exitPoint;
-
-	const int forwardSOffset = graph.getBackwardEdgeCellOffset(s);
-	const int forwardTOffset = graph.getBackwardEdgeCellOffset(t) - graph.getMaxEdgesInCell();
-	const int backwardSOffset = graph.getForwardEdgeCellOffset(s);
-	const int backwardTOffset = graph.getForwardEdgeCellOffset(t) - graph.getMaxEdgesInCell();
-	const index overlayOffset = 2 * graph.getMaxEdgesInCell();
-
-
-	const index sForwardId = sGlobalId - forwardSOffset;
-	assert(sForwardId < graph.getMaxEdgesInCell());
-	const index tBackwardId = tGlobalId - ((sCellNumber == tCellNumber) ? backwardSOffset : backwardTOffset);
-	assert(tBackwardId < 2*graph.getMaxEdgesInCell());
-
-	weight shortestPath = 2 * inf_weight;
-	weight forwardPath = 2 * inf_weight;
-	weight backwardPath = 2 * inf_weight;
-	for (index i = 0; i < overlayOffset; ++i) {
-			forwardInfo[i].dist = inf_weight;
-			backwardInfo[i].dist = inf_weight;
-	}
-
-	forwardInfo[sForwardId] = {0, currentRound, {s, sForwardId}};
-	forwardGraphPQ.push({sForwardId, s, 0});
+/*
+ * Both directions stop as soon as the shortest path found so far is shorter than the sum of their queue minima. A
+ * direction only sees a published minimum of the other one that may be outdated, but since the minima never
+ * decrease this only delays stopping. If the queues of one direction run empty, all of its labels are final and
+ * every meeting point with them has been found, so the other direction can stop as well.
+ *
+ * Turns at s and t are free in both directions, so meeting points at s and t do not add turn costs either. Otherwise
+ * the forward search could stop at t before the backward search has scanned anything.
+ */
+template<template<class> class Queue>
+void ParallelCRPQuery<Queue>::forwardSearch() {
+	const index s = state.s;
+	const index t = state.t;
+	const pv sCellNumber = state.sCellNumber;
+	const pv tCellNumber = state.tCellNumber;
+	const int forwardSOffset = state.forwardSOffset;
+	const int forwardTOffset = state.forwardTOffset;
+	const int backwardSOffset = state.backwardSOffset;
+	const int backwardTOffset = state.backwardTOffset;
+	const index overlayOffset = state.overlayOffset;
+	const index metricId = state.metricId;
+
+	while (true) {
+		const weight minKey = std::min(forwardGraphPQ.peekKey(), forwardOverlayGraphPQ.peekKey());
+		forwardMinKey.store(minKey, std::memory_order_release);
+		if (canStop(minKey, backwardMinKey)) break;
+
+		if (forwardGraphPQ.peekKey() < forwardOverlayGraphPQ.peekKey()) { // graph vertex
+			IDKeyTriple triple = forwardGraphPQ.pop();
+			QUERY_STATS(++stats.settledGraphVertices;)
+			index u = triple.vertexId;
+			index uId = triple.id;
+			turnorder entryPoint;
+			if (uId < graph.getMaxEdgesInCell()) {
+				entryPoint = uId + forwardSOffset - graph.getEntryOffset(u);
+			} else {
+				entryPoint = uId + forwardTOffset - graph.getEntryOffset(u);
+			}
 
-	backwardInfo[tBackwardId] = {0, currentRound, {t, tBackwardId}};
-	backwardGraphPQ.push({tBackwardId, t, 0});
+			// stalling
+			count uInDeg = graph.getInDegree(u);
+			count uOffset = uInDeg * entryPoint;
+			index offset = uId < graph.getMaxEdgesInCell()? forwardSOffset : forwardTOffset;
+			for (index j = 0, entryId = graph.getEntryOffset(u) - offset; entryId < graph.getEntryOffset(u) + uInDeg - offset; ++entryId, ++j) {
+				if (forwardInfo[entryId].round < currentRound) { // only if we do not have a valid distance label already
+					QUERY_STATS(++stats.stalledLabels;)
+					forwardInfo[entryId].dist = std::min(getStallBound(forwardInfo[entryId]), (weight) std::max(0, (int) forwardInfo[uId].dist + metrics[metricId].getMaxEntryTurnTableDiff(u, uOffset + j)));
+					forwardInfo[entryId].stallRound = currentRound;
+				}
+			}
 
-	VertexIdPair forwardMid;
-	VertexIdPair backwardMid;
 
-#pragma omp parallel num_threads(2)
-	{
-		index threadId = omp_get_thread_num();
-		if (threadId == 0) { // forward
-			while (forwardGraphPQ.size() + forwardOverlayGraphPQ.size() > 0) {
-				if (std::min(forwardPath, backwardPath) < std::min(forwardGraphPQ.peekKey(), forwardOverlayGraphPQ.peekKey()) + std::min(backwardGraphPQ.peekKey(), backwardOverlayGraphPQ.peekKey())) break;
-
-				if (forwardGraphPQ.empty() && forwardOverlayGraphPQ.empty()) continue;
-				if (forwardGraphPQ.peekKey() < forwardOverlayGraphPQ.peekKey()) { // graph vertex
-					IDKeyTriple triple = forwardGraphPQ.pop();
-					index u = triple.vertexId;
-					index uId = triple.id;
-					turnorder entryPoint;
-					if (uId < graph.getMaxEdgesInCell()) {
-						entryPoint = uId + forwardSOffset - graph.getEntryOffset(u);
+			assert(entryPoint < graph.getInDegree(u));
+			graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
+				QUERY_STATS(++stats.relaxedEdges;)
+				index v = e.head;
+				level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
+				weight edgeWeight = metrics[metricId].getWeight(e.attributes);
+				weight turnCosts = metrics[metricId].getTurnCosts(type);
+				if (u == s) turnCosts = 0;
+				weight newDist = forwardInfo[uId].dist + edgeWeight + turnCosts;
+
+				if (newDist >= inf_weight) return;
+
+				if (vQueryLevel == 0) { // graph
+					index vId = graph.getEntryOffset(v) + e.entryPoint;
+					bool vInSCell = graph.getCellNumber(v) == sCellNumber;
+					if (vInSCell) {
+						vId -= forwardSOffset;
+						assert(vId < graph.getMaxEdgesInCell());
 					} else {
-						entryPoint = uId + forwardTOffset - graph.getEntryOffset(u);
+						vId -= forwardTOffset;
+						assert(graph.getMaxEdgesInCell() <= vId && vId < 2*graph.getMaxEdgesInCell());
 					}
 
-					// stalling
-					count uInDeg = graph.getInDegree(u);
-					count uOffset = uInDeg * entryPoint;
-					index offset = uId < graph.getMaxEdgesInCell()? forwardSOffset : forwardTOffset;
-					for (index j = 0, entryId = graph.getEntryOffset(u) - offset; entryId < graph.getEntryOffset(u) + uInDeg - offset; ++entryId, ++j) {
-						if (forwardInfo[entryId].round < currentRound) { // only if we do not have a valid distance label already
-							forwardInfo[entryId].dist = std::min(forwardInfo[entryId].dist, (weight) std::max(0, (int) forwardInfo[uId].dist + metrics[metricId].getMaxEntryTurnTableDiff(u, uOffset + j)));
+					if (forwardInfo[vId].round < currentRound && newDist > getStallBound(forwardInfo[vId])) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
+
+					if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
+						forwardInfo[vId].dist = newDist;
+						QUERY_STATS(stats.countQueueOperation(forwardGraphPQ, vId);)
+						forwardGraphPQ.pushOrDecrease({vId, v, newDist});
+						forwardInfo[vId].round = currentRound;
+						forwardInfo[vId].parent = {u, uId};
+						publish(forwardReached[vId], newDist);
+
+						// check whether we already visited an exit point
+						const index exitOffset = graph.getExitOffset(v) - (vInSCell ? backwardSOffset : backwardTOffset);
+						index exitId = exitOffset;
+						graph.forOutEdgesOf(v, e.entryPoint, [&](const ForwardEdge&, index vExitPoint, Graph::TURN_TYPE vType) {
+							const weight exitDist = getReachedDist(backwardReached[exitId]);
+							if (exitDist < inf_weight) {
+								updateShortestPath(newDist + (v == t ? 0 : metrics[metricId].getTurnCosts(vType)) + exitDist, {v, vId}, {v, exitId});
+							}
+							++exitId;
+						});
+					}
+				} else { // v is in another cell on another level
+					v = graph.getOverlayVertex(v, e.entryPoint, false);
+					index vId = v + overlayOffset;
+					assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
+					if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
+						forwardInfo[vId].dist = newDist;
+						QUERY_STATS(stats.countQueueOperation(forwardOverlayGraphPQ, v);)
+						forwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, newDist});
+						forwardInfo[vId].round = currentRound;
+						forwardInfo[vId].parent = {u, uId};
+						publish(forwardReached[vId], newDist);
+
+						const weight backwardDist = getReachedDist(backwardReached[vId]);
+						if (backwardDist < inf_weight) {
+							updateShortestPath(newDist + backwardDist, {v, vId}, {v, vId});
 						}
 					}
+				}
+			});
+		} else { // overlay vertex
+			IDKeyTriple triple = forwardOverlayGraphPQ.pop();
+			index u = triple.id;
+			index uId = u + overlayOffset;
+			const OverlayVertex& uVertex = overlayGraph.getVertex(u);
+			assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
+			level uQueryLevel = triple.vertexId;
+			QUERY_STATS(stats.countSettledOverlayVertex(uQueryLevel);)
+			overlayGraph.forOutNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
+				QUERY_STATS(++stats.relaxedEdges;)
+				weight newDist = forwardInfo[uId].dist + metrics[metricId].getCellWeight(wOffset);
+				if (newDist >= inf_weight) return;
+				index vId = v + overlayOffset;
+				if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
+					forwardInfo[vId].dist = newDist;
+					forwardInfo[vId].round = currentRound;
+					forwardInfo[vId].parent = {uVertex.originalVertex, uId};
+					publish(forwardReached[vId], newDist);
+
+					const OverlayVertex& vVertex = overlayGraph.getVertex(v);
+
+					const weight backwardDist = getReachedDist(backwardReached[vId]);
+					if (backwardDist < inf_weight) {
+						updateShortestPath(newDist + backwardDist, {vVertex.originalVertex, vId}, {vVertex.originalVertex, vId});
+					}
 
-
-					assert(entryPoint < graph.getInDegree(u));
-					graph.forOutEdgesOf(u, entryPoint, [&](const ForwardEdge &e, index exitPoint, Graph::TURN_TYPE type) {
-						index v = e.head;
-						level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
-						weight edgeWeight = metrics[metricId].getWeight(e.attributes);
-						weight turnCosts = metrics[metricId].getTurnCosts(type);
-						if (u == s) turnCosts = 0;
-						weight newDist = forwardInfo[uId].dist + edgeWeight + turnCosts;
-
-						if (newDist >= inf_weight) return;
-
-						if (vQueryLevel == 0) { // graph
-							index vId = graph.getEntryOffset(v) + e.entryPoint;
-							bool vInSCell = graph.getCellNumber(v) == sCellNumber;
-							if (vInSCell) {
-								vId -= forwardSOffset;
-								assert(vId < graph.getMaxEdgesInCell());
-							} else {
-								vId -= forwardTOffset;
-								assert(graph.getMaxEdgesInCell() <= vId && vId < 2*graph.getMaxEdgesInCell());
-							}
-
-							if (forwardInfo[vId].round < currentRound && newDist > forwardInfo[vId].dist) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
-
-							if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
-								forwardInfo[vId].dist = newDist;
-								forwardGraphPQ.pushOrDecrease({vId, v, newDist});
-								forwardInfo[vId].round = currentRound;
-								forwardInfo[vId].parent = {u, uId};
-
-								// check whether we already visited an exit point
-								const index exitOffset = graph.getExitOffset(v) - (vInSCell ? backwardSOffset : backwardTOffset);
-								index exitId = exitOffset;
-								graph.forOutEdgesOf(v, e.entryPoint, [&](const ForwardEdge&, index vExitPoint, Graph::TURN_TYPE vType) {
-									if (backwardInfo[exitId].round == currentRound) {
-										weight newPathLength = forwardInfo[vId].dist + metrics[metricId].getTurnCosts(vType) + backwardInfo[exitId].dist;
-										if (newPathLength < forwardPath) {
-											forwardPath = newPathLength;
-											forwardMid = {v, vId};
-											backwardMid = {v, exitId};
-										}
-									}
-									++exitId;
-								});
-							}
-						} else { // v is in another cell on another level
-							v = graph.getOverlayVertex(v, e.entryPoint, false);
-							index vId = v + overlayOffset;
-							assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
-							if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
-								forwardInfo[vId].dist = newDist;
-								forwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, newDist});
-								forwardInfo[vId].round = currentRound;
-								forwardInfo[vId].parent = {u, uId};
-								if (backwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < forwardPath) {
-									forwardPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
-									forwardMid = {v, vId};
-									backwardMid = {v, vId};
-								}
-							}
+					// traverse edge to next cell
+					const ForwardEdge &fEdge = graph.getForwardEdge(vVertex.originalEdge);
+					newDist = forwardInfo[vId].dist + metrics[metricId].getWeight(fEdge.attributes);
+
+					if (newDist >= inf_weight) return;
+
+					index w = vVertex.neighborOverlayVertex;
+					const OverlayVertex& wVertex = overlayGraph.getVertex(w);
+					level wQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, wVertex.cellNumber);
+
+					if (wQueryLevel == 0) { // we are back on the graph
+						assert(wVertex.cellNumber == sCellNumber || wVertex.cellNumber == tCellNumber);
+						bool wInSCell = wVertex.cellNumber == sCellNumber;
+						index originalW = wVertex.originalVertex;
+						index originalWId = graph.getEntryOffset(originalW) + fEdge.entryPoint;
+						if (wInSCell) {
+							originalWId -= forwardSOffset;
+						} else {
+							originalWId -= forwardTOffset;
 						}
-					});
-				} else { // overlay vertex
-					IDKeyTriple triple = forwardOverlayGraphPQ.pop();
-					index u = triple.id;
-					index uId = u + overlayOffset;
-					const OverlayVertex& uVertex = overlayGraph.getVertex(u);
-					assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
-					level uQueryLevel = triple.vertexId;
-					overlayGraph.forOutNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
-						weight newDist = forwardInfo[uId].dist + metrics[metricId].getCellWeight(wOffset);
-						if (newDist >= inf_weight) return;
-						index vId = v + overlayOffset;
-						if (forwardInfo[vId].round < currentRound || newDist < forwardInfo[vId].dist) {
-							forwardInfo[vId].dist = newDist;
-							forwardInfo[vId].round = currentRound;
-							forwardInfo[vId].parent = {uVertex.originalVertex, uId};
-
-							const OverlayVertex& vVertex = overlayGraph.getVertex(v);
-
-							// traverse edge to next cell
-							const ForwardEdge &fEdge = graph.getForwardEdge(vVertex.originalEdge);
-							newDist = forwardInfo[vId].dist + metrics[metricId].getWeight(fEdge.attributes);
-
-							if (newDist >= inf_weight) return;
-
-							index w = vVertex.neighborOverlayVertex;
-							const OverlayVertex& wVertex = overlayGraph.getVertex(w);
-							level wQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, wVertex.cellNumber);
-
-							if (wQueryLevel == 0) { // we are back on the graph
-								assert(wVertex.cellNumber == sCellNumber || wVertex.cellNumber == tCellNumber);
-								bool wInSCell = wVertex.cellNumber == sCellNumber;
-								index originalW = wVertex.originalVertex;
-								index originalWId = graph.getEntryOffset(originalW) + fEdge.entryPoint;
-								if (wInSCell) {
-									originalWId -= forwardSOffset;
-								} else {
-									originalWId -= forwardTOffset;
-								}
 
-								if (forwardInfo[originalWId].round < currentRound && newDist > forwardInfo[originalWId].dist) return;  // we haven't seen originalWId yet and we cannot improve anything from this entryPoint
-
-								if (forwardInfo[originalWId].round < currentRound || newDist < forwardInfo[originalWId].dist) {
-									forwardInfo[originalWId].dist = newDist;
-									forwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
-									forwardInfo[originalWId].round = currentRound;
-									forwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
-
-									// check whether we already visited an exit point
-									const index exitOffset = graph.getExitOffset(originalW) - (wInSCell ? backwardSOffset : backwardTOffset);
-									index exitId = exitOffset;
-									graph.forOutEdgesOf(originalW, fEdge.entryPoint, [&](const ForwardEdge&, index wExitPoint, Graph::TURN_TYPE wType) {
-										if (backwardInfo[exitId].round == currentRound) {
-											weight newPathLength = forwardInfo[originalWId].dist + metrics[metricId].getTurnCosts(wType) + backwardInfo[exitId].dist;
-											if (newPathLength < forwardPath) {
-												forwardPath = newPathLength;
-												forwardMid = {originalW, originalWId};
-												backwardMid = {originalW, exitId};
-											}
-										}
-										++exitId;
-									});
-								}
-							} else {
-								index wId = w + overlayOffset;
-								if (forwardInfo[wId].round < currentRound || newDist < forwardInfo[wId].dist) {
-									forwardInfo[wId].dist = newDist;
-									forwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel, newDist});
-									forwardInfo[wId].round = currentRound;
-									forwardInfo[wId].parent = {vVertex.originalVertex, vId};
-									if (backwardInfo[wId].round == currentRound && forwardInfo[wId].dist + backwardInfo[wId].dist < forwardPath) {
-										forwardPath = forwardInfo[wId].dist + backwardInfo[wId].dist;
-										forwardMid = {wVertex.originalVertex, wId};
-										backwardMid = {wVertex.originalVertex, wId};
-									}
+						if (forwardInfo[originalWId].round < currentRound && newDist > getStallBound(forwardInfo[originalWId])) return;  // we haven't seen originalWId yet and we cannot improve anything from this entryPoint
+
+						if (forwardInfo[originalWId].round < currentRound || newDist < forwardInfo[originalWId].dist) {
+							forwardInfo[originalWId].dist = newDist;
+							QUERY_STATS(stats.countQueueOperation(forwardGraphPQ, originalWId);)
+							forwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
+							forwardInfo[originalWId].round = currentRound;
+							forwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
+							publish(forwardReached[originalWId], newDist);
+
+							// check whether we already visited an exit point
+							const index exitOffset = graph.getExitOffset(originalW) - (wInSCell ? backwardSOffset : backwardTOffset);
+							index exitId = exitOffset;
+							graph.forOutEdgesOf(originalW, fEdge.entryPoint, [&](const ForwardEdge&, index wExitPoint, Graph::TURN_TYPE wType) {
+								const weight exitDist = getReachedDist(backwardReached[exitId]);
+								if (exitDist < inf_weight) {
+									updateShortestPath(newDist + (originalW == t ? 0 : metrics[metricId].getTurnCosts(wType)) + exitDist, {originalW, originalWId}, {originalW, exitId});
 								}
+								++exitId;
+							});
+						}
+					} else {
+						index wId = w + overlayOffset;
+						if (forwardInfo[wId].round < currentRound || newDist < forwardInfo[wId].dist) {
+							forwardInfo[wId].dist = newDist;
+							QUERY_STATS(stats.countQueueOperation(forwardOverlayGraphPQ, w);)
+							forwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel, newDist});
+							forwardInfo[wId].round = currentRound;
+							forwardInfo[wId].parent = {vVertex.originalVertex, vId};
+							publish(forwardReached[wId], newDist);
+
+							const weight backwardDist = getReachedDist(backwardReached[wId]);
+							if (backwardDist < inf_weight) {
+								updateShortestPath(newDist + backwardDist, {wVertex.originalVertex, wId}, {wVertex.originalVertex, wId});
 							}
 						}
-					});
+					}
+				}
+			});
+		}
+	}
+}
+
+template<template<class> class Queue>
+void ParallelCRPQuery<Queue>::backwardSearch() {
+	const index s = state.s;
+	const index t = state.t;
+	const pv sCellNumber = state.sCellNumber;
+	const pv tCellNumber = state.tCellNumber;
+	const int forwardSOffset = state.forwardSOffset;
+	const int forwardTOffset = state.forwardTOffset;
+	const int backwardSOffset = state.backwardSOffset;
+	const int backwardTOffset = state.backwardTOffset;
+	const index overlayOffset = state.overlayOffset;
+	const index metricId = state.metricId;
+
+	while (true) {
+		const weight minKey = std::min(backwardGraphPQ.peekKey(), backwardOverlayGraphPQ.peekKey());
+		backwardMinKey.store(minKey, std::memory_order_release);
+		if (canStop(minKey, forwardMinKey)) break;
+
+		if (backwardGraphPQ.peekKey() < backwardOverlayGraphPQ.peekKey()) { // graph vertex
+			IDKeyTriple triple = backwardGraphPQ.pop();
+			QUERY_STATS(++backwardStats.settledGraphVertices;)
+			index u = triple.vertexId;
+			index uId = triple.id;
+			turnorder exitPoint;
+			if (uId < graph.getMaxEdgesInCell()) {
+				exitPoint = uId + backwardSOffset - graph.getExitOffset(u);
+			} else {
+				exitPoint = uId + backwardTOffset - graph.getExitOffset(u);
+			}
+			assert(exitPoint < graph.getOutDegree(u));
+
+			// stalling
+			count uOutDeg = graph.getOutDegree(u);
+			count uOffset = uOutDeg * exitPoint;
+			index offset = uId < graph.getMaxEdgesInCell()? backwardSOffset : backwardTOffset;
+			for (index j = 0, exitId = graph.getExitOffset(u) - offset; exitId < graph.getExitOffset(u) + uOutDeg - offset; ++exitId, ++j) {
+				if (backwardInfo[exitId].round < currentRound) { // only if we do not have a valid distance label already
+					QUERY_STATS(++backwardStats.stalledLabels;)
+					backwardInfo[exitId].dist = std::min(getStallBound(backwardInfo[exitId]), (weight) std::max(0, (int) backwardInfo[uId].dist + metrics[metricId].getMaxExitTurnTableDiff(u, uOffset + j)));
+					backwardInfo[exitId].stallRound = currentRound;
 				}
 			}
-		} else { // threadId == 1 -> backward
-			while (backwardGraphPQ.size() + backwardOverlayGraphPQ.size() > 0) {
-				if (std::min(forwardPath, backwardPath) < std::min(forwardGraphPQ.peekKey(), forwardOverlayGraphPQ.peekKey()) + std::min(backwardGraphPQ.peekKey(), backwardOverlayGraphPQ.peekKey())) break;
-
-				if (backwardGraphPQ.empty() && backwardOverlayGraphPQ.empty()) continue;
-				if (backwardGraphPQ.peekKey() < backwardOverlayGraphPQ.peekKey()) { // graph vertex
-					IDKeyTriple triple = backwardGraphPQ.pop();
-					index u = triple.vertexId;
-					index uId = triple.id;
-					turnorder exitPoint;
-					if (uId < graph.getMaxEdgesInCell()) {
-						exitPoint = uId + backwardSOffset - graph.getExitOffset(u);
+
+			graph.forInEdgesOf(u, exitPoint, [&](const BackwardEdge &e, index entryPoint, Graph::TURN_TYPE type) {
+				QUERY_STATS(++backwardStats.relaxedEdges;)
+				index v = e.tail;
+				level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
+				weight edgeWeight = metrics[metricId].getWeight(e.attributes);
+				weight turnCosts = metrics[metricId].getTurnCosts(type);
+				if (u == t) turnCosts = 0;
+				weight newDist = backwardInfo[uId].dist + edgeWeight + turnCosts;
+
+				if (newDist >= inf_weight) return;
+
+				if (vQueryLevel == 0) { // graph
+					index vId = graph.getExitOffset(v) + e.exitPoint;
+					bool vInSCell = graph.getCellNumber(v) == sCellNumber;
+					if (vInSCell) {
+						vId -= backwardSOffset;
+						assert(vId < graph.getMaxEdgesInCell());
 					} else {
-						exitPoint = uId + backwardTOffset - graph.getExitOffset(u);
-					}
-					assert(exitPoint < graph.getOutDegree(u));
-
-					// stalling
-					count uOutDeg = graph.getOutDegree(u);
-					count uOffset = uOutDeg * exitPoint;
-					index offset = uId < graph.getMaxEdgesInCell()? backwardSOffset : backwardTOffset;
-					for (index j = 0, exitId = graph.getExitOffset(u) - offset; exitId < graph.getExitOffset(u) + uOutDeg - offset; ++exitId, ++j) {
-						if (backwardInfo[exitId].round < currentRound) { // only if we do not have a valid distance label already
-							backwardInfo[exitId].dist = std::min(backwardInfo[exitId].dist, (weight) std::max(0, (int) backwardInfo[uId].dist + metrics[metricId].getMaxExitTurnTableDiff(u, uOffset + j)));
-						}
+						vId -= backwardTOffset;
+						assert(graph.getMaxEdgesInCell() <= vId && vId < 2*graph.getMaxEdgesInCell());
 					}
 
-					graph.forInEdgesOf(u, exitPoint, [&](const BackwardEdge &e, index entryPoint, Graph::TURN_TYPE type) {
-						index v = e.tail;
-						level vQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, graph.getCellNumber(v));
-						weight edgeWeight = metrics[metricId].getWeight(e.attributes);
-						weight turnCosts = metrics[metricId].getTurnCosts(type);
-						if (u == t) turnCosts = 0;
-						weight newDist = backwardInfo[uId].dist + edgeWeight + turnCosts;
-
-						if (newDist >= inf_weight) return;
-
-						if (vQueryLevel == 0) { // graph
-							index vId = graph.getExitOffset(v) + e.exitPoint;
-							bool vInSCell = graph.getCellNumber(v) == sCellNumber;
-							if (vInSCell) {
-								vId -= backwardSOffset;
-								assert(vId < graph.getMaxEdgesInCell());
-							} else {
-								vId -= backwardTOffset;
-								assert(graph.getMaxEdgesInCell() <= vId && vId < 2*graph.getMaxEdgesInCell());
-							}
 
+					if (backwardInfo[vId].round < currentRound && newDist > getStallBound(backwardInfo[vId])) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
 
-							if (backwardInfo[vId].round < currentRound && newDist > backwardInfo[vId].dist) return; // we haven't seen vId yet and we cannot improve anything from this entryPoint
-
-							if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
-								backwardInfo[vId].dist = newDist;
-								backwardGraphPQ.pushOrDecrease({vId, v, newDist});
-								backwardInfo[vId].round = currentRound;
-								backwardInfo[vId].parent = {u, uId};
-
-								// check whether we already visited an entry point
-								const index entryOffset = graph.getEntryOffset(v) - (vInSCell ? forwardSOffset : forwardTOffset);
-								index entryId = entryOffset;
-								graph.forInEdgesOf(v, e.exitPoint, [&](const BackwardEdge&, index vEntryPoint, Graph::TURN_TYPE vType) {
-									if (forwardInfo[entryId].round == currentRound) {
-										weight newPathLength = forwardInfo[entryId].dist + metrics[metricId].getTurnCosts(vType) + backwardInfo[vId].dist;
-										if (newPathLength < backwardPath) {
-											backwardPath = newPathLength;
-											forwardMid = {v, entryId};
-											backwardMid = {v, vId};
-										}
-									}
-									++entryId;
-								});
-							}
-						} else { // v is in another cell on another level
-							v = graph.getOverlayVertex(v, e.exitPoint, true);
-							index vId = v + overlayOffset;
-							assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
-							if (backwardInfo[vId].round < currentRound || backwardInfo[uId].dist + edgeWeight < backwardInfo[vId].dist) {
-								backwardInfo[vId].dist = backwardInfo[uId].dist + edgeWeight;
-								backwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, backwardInfo[vId].dist});
-								backwardInfo[vId].round = currentRound;
-								backwardInfo[vId].parent = {u, uId};
-								if (forwardInfo[vId].round == currentRound && forwardInfo[vId].dist + backwardInfo[vId].dist < backwardPath) {
-									backwardPath = forwardInfo[vId].dist + backwardInfo[vId].dist;
-									forwardMid = {v, vId};
-									backwardMid = {v, vId};
-								}
+					if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
+						backwardInfo[vId].dist = newDist;
+						QUERY_STATS(backwardStats.countQueueOperation(backwardGraphPQ, vId);)
+						backwardGraphPQ.pushOrDecrease({vId, v, newDist});
+						backwardInfo[vId].round = currentRound;
+						backwardInfo[vId].parent = {u, uId};
+						publish(backwardReached[vId], newDist);
+
+						// check whether we already visited an entry point
+						const index entryOffset = graph.getEntryOffset(v) - (vInSCell ? forwardSOffset : forwardTOffset);
+						index entryId = entryOffset;
+						graph.forInEdgesOf(v, e.exitPoint, [&](const BackwardEdge&, index vEntryPoint, Graph::TURN_TYPE vType) {
+							const weight entryDist = getReachedDist(forwardReached[entryId]);
+							if (entryDist < inf_weight) {
+								updateShortestPath(entryDist + (v == s ? 0 : metrics[metricId].getTurnCosts(vType)) + newDist, {v, entryId}, {v, vId});
 							}
+							++entryId;
+						});
+					}
+				} else { // v is in another cell on another level
+					v = graph.getOverlayVertex(v, e.exitPoint, true);
+					index vId = v + overlayOffset;
+					assert(overlayOffset <= vId && vId < overlayOffset + overlayGraph.numberOfVertices());
+					if (backwardInfo[vId].round < currentRound || backwardInfo[uId].dist + edgeWeight < backwardInfo[vId].dist) {
+						backwardInfo[vId].dist = backwardInfo[uId].dist + edgeWeight;
+						QUERY_STATS(backwardStats.countQueueOperation(backwardOverlayGraphPQ, v);)
+						backwardOverlayGraphPQ.pushOrDecrease({v, vQueryLevel, backwardInfo[vId].dist});
+						backwardInfo[vId].round = currentRound;
+						backwardInfo[vId].parent = {u, uId};
+						publish(backwardReached[vId], backwardInfo[vId].dist);
+
+						const weight forwardDist = getReachedDist(forwardReached[vId]);
+						if (forwardDist < inf_weight) {
+							updateShortestPath(forwardDist + backwardInfo[vId].dist, {v, vId}, {v, vId});
 						}
-					});
-				} else { // overlay vertex
-					IDKeyTriple triple = backwardOverlayGraphPQ.pop();
-					index u = triple.id;
-					index uId = u + overlayOffset;
-					const OverlayVertex& uVertex = overlayGraph.getVertex(u);
-					assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
-					level uQueryLevel = triple.vertexId;
-
-					overlayGraph.forInNeighborsOf(u, uQueryLevel, [&](index v, index wOffset) {
-						weight newDist = backwardInfo[uId].dist + metrics[metricId].getCellWeight(wOffset);
-						if (newDist >= inf_weight) return;
-						index vId = v + overlayOffset;
-						if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
-							backwardInfo[vId].dist = newDist;
-							backwardInfo[vId].round = currentRound;
-							backwardInfo[vId].parent = {uVertex.originalVertex, uId};
-
-							const OverlayVertex& vVertex = overlayGraph.getVertex(v);
-
-							// traverse edge to next cell
-							const BackwardEdge &bEdge = graph.getBackwardEdge(vVertex.originalEdge);
-							newDist = backwardInfo[vId].dist + metrics[metricId].getWeight(bEdge.attributes);
-							if (newDist >= inf_weight) return;
-
-							index w = vVertex.neighborOverlayVertex;
-							const OverlayVertex& wVertex = overlayGraph.getVertex(w);
-							level wQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, wVertex.cellNumber);
-							if (wQueryLevel == 0) { // we are back on the graph
-								assert(wVertex.cellNumber == sCellNumber || wVertex.cellNumber == tCellNumber);
-								bool wInSCell = wVertex.cellNumber == sCellNumber;
-								index originalW = wVertex.originalVertex;
-								index originalWId = graph.getExitOffset(originalW) + bEdge.exitPoint;
-								if (wInSCell) {
-									originalWId -= backwardSOffset;
-								} else {
-									originalWId -= backwardTOffset;
-								}
+					}
+				}
+			});
+		} else { // overlay vertex
+			IDKeyTriple triple = backwardOverlayGraphPQ.pop();
+			index u = triple.id;
+			index uId = u + overlayOffset;
+			const OverlayVertex& uVertex = overlayGraph.getVertex(u);
+			assert(graph.getCellNumber(uVertex.originalVertex) == uVertex.cellNumber);
+			level uQueryLevel = triple.vertexId;
+			QUERY_STATS(backwardStats.countSettledOverlayVertex(uQueryLevel);)
+
+			// without the transposed cell matrices, the weights of a column are read with a stride
+			const bool transposed = metrics[metricId].hasTransposedCellWeights();
+			overlayGraph.forInNeighborsOf(u, uQueryLevel, transposed, [&](index v, index wOffset) {
+				QUERY_STATS(++backwardStats.relaxedEdges;)
+				weight newDist = backwardInfo[uId].dist + (transposed ? metrics[metricId].getTransposedCellWeight(wOffset) : metrics[metricId].getCellWeight(wOffset));
+				if (newDist >= inf_weight) return;
+				index vId = v + overlayOffset;
+				if (backwardInfo[vId].round < currentRound || newDist < backwardInfo[vId].dist) {
+					backwardInfo[vId].dist = newDist;
+					backwardInfo[vId].round = currentRound;
+					backwardInfo[vId].parent = {uVertex.originalVertex, uId};
+					publish(backwardReached[vId], newDist);
+
+					const OverlayVertex& vVertex = overlayGraph.getVertex(v);
+
+					const weight forwardDist = getReachedDist(forwardReached[vId]);
+					if (forwardDist < inf_weight) {
+						updateShortestPath(forwardDist + newDist, {vVertex.originalVertex, vId}, {vVertex.originalVertex, vId});
+					}
 
-								if (backwardInfo[originalWId].round < currentRound && newDist > backwardInfo[originalWId].dist) return;  // we haven't seen originalWId yet and we cannot improve anything from this exitPoint
-
-								if (backwardInfo[originalWId].round < currentRound || newDist < backwardInfo[originalWId].dist) {
-									backwardInfo[originalWId].dist = newDist;
-									backwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
-									backwardInfo[originalWId].round = currentRound;
-									backwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
-
-									// check whether we already visited an entry point
-									const index entryOffset = graph.getEntryOffset(originalW) - (wInSCell ? forwardSOffset : forwardTOffset);
-									index entryId = entryOffset;
-									graph.forInEdgesOf(originalW, bEdge.exitPoint, [&](const BackwardEdge&, index wEntryPoint, Graph::TURN_TYPE wType) {
-										if (forwardInfo[entryId].round == currentRound) {
-											weight newPathLength = forwardInfo[entryId].dist + metrics[metricId].getTurnCosts(wType) + backwardInfo[originalWId].dist;
-											if (newPathLength < backwardPath) {
-												backwardPath = newPathLength;
-												forwardMid = {originalW, entryId};
-												backwardMid = {originalW, originalWId};
-											}
-										}
-										++entryId;
-									});
-								}
-							} else {
-								index wId = w + overlayOffset;
-								if (backwardInfo[wId].round < currentRound || newDist < backwardInfo[wId].dist) {
-									backwardInfo[wId].dist = newDist;
-									backwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel,  newDist});
-									backwardInfo[wId].round = currentRound;
-									backwardInfo[wId].parent = {vVertex.originalVertex, vId};
-									if (forwardInfo[wId].round == currentRound && forwardInfo[wId].dist + backwardInfo[wId].dist < backwardPath) {
-										backwardPath = forwardInfo[wId].dist + backwardInfo[wId].dist;
-										forwardMid = {wVertex.originalVertex, wId};
-										backwardMid = {wVertex.originalVertex, wId};
-									}
+					// traverse edge to next cell
+					const BackwardEdge &bEdge = graph.getBackwardEdge(vVertex.originalEdge);
+					newDist = backwardInfo[vId].dist + metrics[metricId].getWeight(bEdge.attributes);
+					if (newDist >= inf_weight) return;
+
+					index w = vVertex.neighborOverlayVertex;
+					const OverlayVertex& wVertex = overlayGraph.getVertex(w);
+					level wQueryLevel = overlayGraph.getQueryLevel(sCellNumber, tCellNumber, wVertex.cellNumber);
+					if (wQueryLevel == 0) { // we are back on the graph
+						assert(wVertex.cellNumber == sCellNumber || wVertex.cellNumber == tCellNumber);
+						bool wInSCell = wVertex.cellNumber == sCellNumber;
+						index originalW = wVertex.originalVertex;
+						index originalWId = graph.getExitOffset(originalW) + bEdge.exitPoint;
+						if (wInSCell) {
+							originalWId -= backwardSOffset;
+						} else {
+							originalWId -= backwardTOffset;
+						}
+
+						if (backwardInfo[originalWId].round < currentRound && newDist > getStallBound(backwardInfo[originalWId])) return;  // we haven't seen originalWId yet and we cannot improve anything from this exitPoint
+
+						if (backwardInfo[originalWId].round < currentRound || newDist < backwardInfo[originalWId].dist) {
+							backwardInfo[originalWId].dist = newDist;
+							QUERY_STATS(backwardStats.countQueueOperation(backwardGraphPQ, originalWId);)
+							backwardGraphPQ.pushOrDecrease({originalWId, originalW, newDist});
+							backwardInfo[originalWId].round = currentRound;
+							backwardInfo[originalWId].parent = {vVertex.originalVertex, vId};
+							publish(backwardReached[originalWId], newDist);
+
+							// check whether we already visited an entry point
+							const index entryOffset = graph.getEntryOffset(originalW) - (wInSCell ? forwardSOffset : forwardTOffset);
+							index entryId = entryOffset;
+							graph.forInEdgesOf(originalW, bEdge.exitPoint, [&](const BackwardEdge&, index wEntryPoint, Graph::TURN_TYPE wType) {
+								const weight entryDist = getReachedDist(forwardReached[entryId]);
+								if (entryDist < inf_weight) {
+									updateShortestPath(entryDist + (originalW == s ? 0 : metrics[metricId].getTurnCosts(wType)) + newDist, {originalW, entryId}, {originalW, originalWId});
 								}
+								++entryId;
+							});
+						}
+					} else {
+						index wId = w + overlayOffset;
+						if (backwardInfo[wId].round < currentRound || newDist < backwardInfo[wId].dist) {
+							backwardInfo[wId].dist = newDist;
+							QUERY_STATS(backwardStats.countQueueOperation(backwardOverlayGraphPQ, w);)
+							backwardOverlayGraphPQ.pushOrDecrease({w, wQueryLevel,  newDist});
+							backwardInfo[wId].round = currentRound;
+							backwardInfo[wId].parent = {vVertex.originalVertex, vId};
+							publish(backwardReached[wId], newDist);
+
+							const weight forwardDist = getReachedDist(forwardReached[wId]);
+							if (forwardDist < inf_weight) {
+								updateShortestPath(forwardDist + newDist, {wVertex.originalVertex, wId}, {wVertex.originalVertex, wId});
 							}
 						}
-					});
+					}
 				}
-			}
+			});
 		}
 	}
+}
+
+template<template<class> class Queue>
+QueryResult ParallelCRPQuery<Queue>::edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId) {
+	nextRound();
+	QUERY_STATS(const long long searchStart = get_micro_time();)
+
+	const index s = graph.getForwardEdge(sourceEdgeId).head;
+	const index sGlobalId = graph.getEntryOffset(s) + graph.getForwardEdge(sourceEdgeId).entryPoint;
+	const pv sCellNumber = graph.getCellNumber(s);
+	const index t = graph.getBackwardEdge(targetEdgeId).tail;
+	const pv tCellNumber = graph.getCellNumber(t);
+	const index tGlobalId = graph.getExitOffset(t) + graph.getBackwardEdge(targetEdgeId).exitPoint;
+
+	const int forwardSOffset = graph.getBackwardEdgeCellOffset(s);
+	const int forwardTOffset = graph.getBackwardEdgeCellOffset(t) - graph.getMaxEdgesInCell();
+	const int backwardSOffset = graph.getForwardEdgeCellOffset(s);
+	const int backwardTOffset = graph.getForwardEdgeCellOffset(t) - graph.getMaxEdgesInCell();
+	const index overlayOffset = 2 * graph.getMaxEdgesInCell();
+
+
+	const index sForwardId = sGlobalId - forwardSOffset;
+	assert(sForwardId < graph.getMaxEdgesInCell());
+	const index tBackwardId = tGlobalId - ((sCellNumber == tCellNumber) ? backwardSOffset : backwardTOffset);
+	assert(tBackwardId < 2*graph.getMaxEdgesInCell());
+
+	state = {s, t, sCellNumber, tCellNumber, forwardSOffset, forwardTOffset, backwardSOffset, backwardTOffset, overlayOffset, metricId};
+
+	forwardInfo[sForwardId] = {0, currentRound, 0, {s, sForwardId}};
+	forwardGraphPQ.push({sForwardId, s, 0});
+	publish(forwardReached[sForwardId], 0);
+
+	backwardInfo[tBackwardId] = {0, currentRound, 0, {t, tBackwardId}};
+	backwardGraphPQ.push({tBackwardId, t, 0});
+	publish(backwardReached[tBackwardId], 0);
+
+	forwardMinKey.store(0, std::memory_order_relaxed);
+	backwardMinKey.store(0, std::memory_order_relaxed);
+	tentativeDistance.store(2 * inf_weight, std::memory_order_relaxed);
+
+	// the searches only look for meeting points when they update a label, so the start labels are compared here;
+	// both sit at t, where no turn costs are added
+	if (s == t) {
+		updateShortestPath(0, {s, sForwardId}, {t, tBackwardId});
+	}
+
+	// the worker sees everything written above since it takes workerMutex before it starts
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		backwardSearchPending = true;
+	}
+	workerStart.notify_one();
+
+	forwardSearch();
+
+	{
+		std::unique_lock<std::mutex> lock(workerMutex);
+		workerDone.wait(lock, [this] { return !backwardSearchPending; });
+	}
+	QUERY_STATS(stats += backwardStats; backwardStats = QueryStats();)
+	QUERY_STATS(stats.searchTime = get_micro_time() - searchStart;)
 
 	forwardGraphPQ.clear();
 	forwardOverlayGraphPQ.clear();
 	backwardGraphPQ.clear();
 	backwardOverlayGraphPQ.clear();
 
-	shortestPath = std::min(forwardPath, backwardPath);
-	if (shortestPath > inf_weight) shortestPath = inf_weight;
+	weight shortestPath = std::min(tentativeDistance.load(std::memory_order_relaxed), inf_weight);
 
 	if (shortestPath == inf_weight) {
-		return QueryResult({}, inf_weight);
+		return finishQuery(QueryResult({}, inf_weight));
 	}
 
 #ifdef QUERYTEST
-	return QueryResult({}, shortestPath);
+	return finishQuery(QueryResult({}, shortestPath));
 #endif
+	if (!unpackPaths) {
+		return finishQuery(QueryResult({}, shortestPath));
+	}
 
 	// extract forward path
 	std::vector<index> overlayPath;
@@ -510,14 +648,21 @@ QueryResult ParallelCRPQuery::edgeQuery(index sourceEdgeId, index targetEdgeId,
 	pv start = get_micro_time();
 #endif
 
+	QUERY_STATS(const long long unpackStart = get_micro_time();)
 	std::vector<index> unpackedPath = pathUnpacker.unpackPath(idPath, sCellNumber, tCellNumber, metricId);
+	QUERY_STATS(stats.unpackTime = get_micro_time() - unpackStart;)
 
 #ifdef UNPACKPATHTEST
 	index pathUnpackTime = get_micro_time() - start;
 	shortestPath = pathUnpackTime;
 #endif
 
-	return QueryResult(unpackedPath, shortestPath);
+	return finishQuery(QueryResult(unpackedPath, shortestPath));
 }
 
+template class ParallelCRPQuery<BinaryIDQueue>;
+template class ParallelCRPQuery<MinIDQueue>;
+template class ParallelCRPQuery<OctaryIDQueue>;
+template class ParallelCRPQuery<RadixIDQueue>;
+
 } /* namespace CRP */
@@ -29,7 +29,11 @@
 #ifndef ALGORITHM_PARALLEL_CRPQUERY_H_
 #define ALGORITHM_PARALLEL_CRPQUERY_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "../constants.h"
@@ -43,32 +47,137 @@
 
 namespace CRP {
 
+/**
+ * Bidirectional CRP query that runs the forward search on the calling thread and the backward search on a worker
+ * thread owned by the query object. The worker lives as long as the query and sleeps between queries, so a query
+ * neither starts threads nor spins. Each direction keeps its labels for itself and publishes dist and round of
+ * every label update to the other direction, which uses them to find meeting points.
+ *
+ * A query object must only be used by one thread at a time.
+ *
+ * @tparam Queue the priority queue, instantiated for BinaryIDQueue, MinIDQueue, OctaryIDQueue and RadixIDQueue
+ */
+template<template<class> class Queue = MinIDQueue>
 class ParallelCRPQuery : public Query {
 private:
 	PathUnpacker& pathUnpacker;
 
+	/*
+	 * A label is only valid if its round is the current one, so nothing has to be reset between queries. Stalling
+	 * writes an upper bound into dist of labels that have not been reached yet and marks it with stallRound.
+	 */
 	struct VertexInfo {
 		weight dist;
 		count round;
+		count stallRound;
 		VertexIdPair parent;
 	};
 
 	std::vector<VertexInfo> forwardInfo;
 	std::vector<VertexInfo> backwardInfo;
 
+	/*
+	 * The published labels of both directions with the round in the upper and dist in the lower 32 bits, so that
+	 * both are read at once. Stores and loads are sequentially consistent: if both directions reach the two ends of
+	 * a meeting point at the same time, at least one of them sees the label of the other.
+	 */
+	std::unique_ptr<std::atomic<uint64_t>[]> forwardReached;
+	std::unique_ptr<std::atomic<uint64_t>[]> backwardReached;
+
 	count currentRound;
 
-	MinIDQueue<IDKeyTriple> forwardGraphPQ;
-	MinIDQueue<IDKeyTriple> backwardGraphPQ;
-	MinIDQueue<IDKeyTriple> forwardOverlayGraphPQ;
-	MinIDQueue<IDKeyTriple> backwardOverlayGraphPQ;
+	Queue<IDKeyTriple> forwardGraphPQ;
+	Queue<IDKeyTriple> backwardGraphPQ;
+	Queue<IDKeyTriple> forwardOverlayGraphPQ;
+	Queue<IDKeyTriple> backwardOverlayGraphPQ;
+
+	// the current query, written by the calling thread before the worker is woken up
+	struct SearchState {
+		index s;
+		index t;
+		pv sCellNumber;
+		pv tCellNumber;
+		int forwardSOffset;
+		int forwardTOffset;
+		int backwardSOffset;
+		int backwardTOffset;
+		index overlayOffset;
+		index metricId;
+	} state;
+
+	// the smallest key of each direction, inf_weight once its queues ran empty
+	std::atomic<weight> forwardMinKey;
+	std::atomic<weight> backwardMinKey;
+
+	// length of the shortest path found so far, only decreases during a query. The meeting point is written while holding midMutex
+	std::atomic<weight> tentativeDistance;
+	std::mutex midMutex;
+	VertexIdPair forwardMid;
+	VertexIdPair backwardMid;
+
+#ifdef QUERYSTATS
+	// statistics of the backward search, merged into stats after each query. Meeting point updates of both directions
+	// are counted in stats while holding midMutex.
+	QueryStats backwardStats;
+#endif
+
+	std::thread backwardWorker;
+	std::mutex workerMutex;
+	std::condition_variable workerStart;
+	std::condition_variable workerDone;
+	bool backwardSearchPending;
+	bool shutdown;
+
+	inline weight getStallBound(const VertexInfo &info) const {
+		return info.stallRound == currentRound ? info.dist : inf_weight;
+	}
+
+	inline void publish(std::atomic<uint64_t> &reached, weight dist) {
+		reached.store(((uint64_t) currentRound << 32) | dist);
+	}
+
+	/** @return the distance published in @a reached, inf_weight if the label was not reached in this query */
+	inline weight getReachedDist(const std::atomic<uint64_t> &reached) const {
+		const uint64_t label = reached.load();
+		return (count) (label >> 32) == currentRound ? (weight) label : inf_weight;
+	}
+
+	inline void updateShortestPath(weight length, const VertexIdPair &forwardMid, const VertexIdPair &backwardMid) {
+		if (length >= tentativeDistance.load(std::memory_order_relaxed)) return;
+		std::lock_guard<std::mutex> lock(midMutex);
+		if (length < tentativeDistance.load(std::memory_order_relaxed)) {
+			tentativeDistance.store(length, std::memory_order_release);
+			QUERY_STATS(++stats.meetingPointUpdates;)
+			this->forwardMid = forwardMid;
+			this->backwardMid = backwardMid;
+		}
+	}
+
+	/** @return true if the direction with queue minimum @a minKey can stop, see forwardSearch */
+	inline bool canStop(weight minKey, const std::atomic<weight> &otherMinKey) const {
+		const weight otherKey = otherMinKey.load(std::memory_order_acquire);
+		return minKey == inf_weight || otherKey == inf_weight || tentativeDistance.load(std::memory_order_acquire) < minKey + otherKey;
+	}
+
+	void nextRound();
+	void forwardSearch();
+	void backwardSearch();
+	void runBackwardWorker();
 
 public:
 	ParallelCRPQuery(const Graph& graph, const OverlayGraph& overlayGraph, const std::vector<Metric>& metrics, PathUnpacker& pathUnpacker);
-	virtual ~ParallelCRPQuery() = default;
+	virtual ~ParallelCRPQuery();
+
+	ParallelCRPQuery(const ParallelCRPQuery &other) = delete;
+	ParallelCRPQuery& operator=(const ParallelCRPQuery &other) = delete;
 	
 	virtual QueryResult edgeQuery(index sourceEdgeId, index targetEdgeId, index metricId);
 	virtual QueryResult vertexQuery(index sourceVertexId, index targetVertexId, index metricId);
+
+	virtual void bindMetrics(const std::vector<Metric>& metrics) {
+		Query::bindMetrics(metrics);
+		pathUnpacker.bindMetrics(metrics);
+	}
 };
 
 } /* namespace CRP */
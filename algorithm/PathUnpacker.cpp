@@ -41,6 +41,14 @@ PathUnpacker::PathUnpacker(const Graph& graph, const OverlayGraph& overlayGraph,
 		metrics(metrics), dist(graph.numberOfEdges() + overlayGraph.numberOfVertices()), round(graph.numberOfEdges() + overlayGraph.numberOfVertices(), 0),
 		parent(graph.numberOfEdges() + overlayGraph.numberOfVertices()), currentRound(1), graphPQ(graph.numberOfEdges()), overlayGraphPQ(overlayGraph.numberOfVertices()) {}
 
+void PathUnpacker::nextRound() {
+	if (++currentRound == 0) {
+		// the counter wrapped around, so labels of old rounds would look current
+		std::fill(round.begin(), round.end(), 0);
+		currentRound = 1;
+	}
+}
+
 std::vector<index> PathUnpacker::unpackPath(const std::vector<VertexIdPair> &packedPath, pv sourceCellNumber, pv targetCellNumber, index metricId) {
 	std::vector<index> result;
 
@@ -79,7 +87,7 @@ void PathUnpacker::unpackPathInOverlayCell(index sourceId, index targetId, level
 	assert(truncatedCellNumber == overlayGraph.getLevelInfo().truncateToLevel(overlayGraph.getVertex(targetId).cellNumber, l));
 
 	assert(overlayGraphPQ.empty());
-	currentRound++;
+	nextRound();
 	dist[sourceId] = 0;
 	round[sourceId] = currentRound;
 	overlayGraphPQ.push({sourceId, 0}); // the queue contains only entry overlay vertices and the target exit overlay vertex
@@ -153,7 +161,7 @@ void PathUnpacker::unpackPathInLowestLevelCell(index sourceId, index targetId, i
 	assert(graph.getCellNumber(graph.getBackwardEdge(targetId).tail) == cellNumber);
 
 	assert(graphPQ.empty());
-	currentRound++;
+	nextRound();
 	dist[sourceId] = 0;
 	round[sourceId] = currentRound;
 	graphPQ.push({sourceId, sourceVertex, 0});
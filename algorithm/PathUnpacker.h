@@ -37,6 +37,7 @@
 #include "../datastructures/id_queue.h"
 #include "../datastructures/OverlayWeights.h"
 #include "../metrics/Metric.h"
+#include "../metrics/MetricRegistry.h"
 
 namespace CRP {
 
@@ -53,10 +54,19 @@ public:
 	 * @return the unpacked path
 	 */
 	std::vector<index> unpackPath(const std::vector<VertexIdPair> &packedPath, pv sourceCellNumber, pv targetCellNumber, index metricId);
+
+	/**
+	 * Lets all following calls to unpackPath use @a metrics.
+	 * @param metrics
+	 */
+	inline void bindMetrics(const std::vector<Metric>& metrics) {
+		this->metrics.bind(metrics);
+	}
+
 private:
 	const Graph &graph;
 	const OverlayGraph &overlayGraph;
-	const std::vector<Metric> &metrics;
+	MetricView metrics;
 
 	std::vector<weight> dist;
 	std::vector<count> round;
@@ -66,6 +76,9 @@ private:
 	MinIDQueue<IDKeyTriple> graphPQ;
 	MinIDQueue<IDKeyPair> overlayGraphPQ;
 
+	// labels are only valid if their round is the current one
+	void nextRound();
+
 	/**
 	 * Calculates the shortest path from the source overlay vertex to the target inside an overlay cell. The source
 	 * has to be an entry overlay vertex and the target must be an exit overlay vertex of the same cell.
@@ -32,7 +32,9 @@
 #include "../datastructures/OverlayGraph.h"
 #include "../datastructures/QueryResult.h"
 #include "../metrics/Metric.h"
+#include "../metrics/MetricRegistry.h"
 
+#include <utility>
 #include <vector>
 
 namespace CRP {
@@ -67,10 +69,43 @@ public:
 	 */
 	virtual QueryResult vertexQuery(index sourceVertexId, index targetVertexId, index metricId) = 0;
 
+	/**
+	 * Lets all following queries use @a metrics. The metrics must stay alive until the last of these queries
+	 * returns, e.g. by holding the MetricRegistry::Snapshot they were taken from.
+	 * @param metrics
+	 */
+	virtual void bindMetrics(const std::vector<Metric>& metrics) {
+		this->metrics.bind(metrics);
+	}
+
+	/**
+	 * Lets the following queries only compute the weight of the shortest path if @a unpackPaths is false. The
+	 * returned path is empty then, which saves extracting and unpacking it.
+	 * @param unpackPaths
+	 */
+	inline void setUnpackPaths(bool unpackPaths) {
+		this->unpackPaths = unpackPaths;
+	}
+
 protected:
 	const Graph& graph;
 	const OverlayGraph& overlayGraph;
-	const std::vector<Metric>& metrics;
+	MetricView metrics;
+	bool unpackPaths = true;
+
+#ifdef QUERYSTATS
+	// statistics of the running query
+	QueryStats stats;
+#endif
+
+	/**
+	 * Attaches the statistics of the running query to @a result if compiled with QUERYSTATS and starts new ones.
+	 * Query algorithms return all results through this.
+	 */
+	inline QueryResult finishQuery(QueryResult &&result) {
+		QUERY_STATS(result.stats = std::move(stats); stats = QueryStats();)
+		return std::move(result);
+	}
 };
 
 } /* namespace CRP */
@@ -0,0 +1,205 @@
+/*
+ * StronglyConnectedComponents.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "StronglyConnectedComponents.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace CRP {
+
+namespace {
+
+struct TurnTableHasher {
+	std::size_t operator()(const std::vector<Graph::TURN_TYPE> &table) const {
+		std::size_t seed = 0;
+		for (Graph::TURN_TYPE turnType : table) {
+			seed ^= turnType + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+};
+
+}
+
+StronglyConnectedComponents::StronglyConnectedComponents(const Graph &graph) : graph(graph), numComponents(0), largestComponent(invalid_id) {
+}
+
+void StronglyConnectedComponents::run() {
+	const count numEdges = graph.numberOfEdges();
+	component.assign(numEdges, invalid_id);
+	componentSizes.clear();
+	numComponents = 0;
+	largestComponent = invalid_id;
+
+	// an edge is on the Tarjan stack if it has a number but no component yet
+	std::vector<index> number(numEdges, invalid_id);
+	std::vector<index> lowLink(numEdges);
+	std::vector<index> tarjanStack;
+	index nextNumber = 0;
+
+	// replaces the recursion, exit is the next exit point at the head of edge to look at
+	struct Frame {
+		index edge;
+		index exit;
+	};
+	std::vector<Frame> callStack;
+
+	auto visit = [&](index e) {
+		number[e] = lowLink[e] = nextNumber++;
+		tarjanStack.push_back(e);
+		callStack.push_back({e, 0});
+	};
+
+	for (index root = 0; root < numEdges; ++root) {
+		if (number[root] != invalid_id) continue;
+		visit(root);
+
+		while (!callStack.empty()) {
+			Frame &frame = callStack.back();
+			const index e = frame.edge;
+			const ForwardEdge &edge = graph.getForwardEdge(e);
+			const index v = edge.head;
+
+			if (frame.exit < graph.getOutDegree(v)) {
+				const index exit = frame.exit++;
+				if (!isAllowed(graph.getTurnType(v, edge.entryPoint, (turnorder) exit))) continue;
+				const index f = graph.getExitOffset(v) + exit;
+				if (number[f] == invalid_id) {
+					visit(f);
+				} else if (component[f] == invalid_id) {
+					lowLink[e] = std::min(lowLink[e], number[f]);
+				}
+				continue;
+			}
+
+			callStack.pop_back();
+			if (lowLink[e] == number[e]) {
+				count size = 0;
+				index f;
+				do {
+					f = tarjanStack.back();
+					tarjanStack.pop_back();
+					component[f] = numComponents;
+					size++;
+				} while (f != e);
+				componentSizes.push_back(size);
+				if (largestComponent == invalid_id || size > componentSizes[largestComponent]) {
+					largestComponent = numComponents;
+				}
+				numComponents++;
+			}
+			if (!callStack.empty()) {
+				const index parent = callStack.back().edge;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[e]);
+			}
+		}
+	}
+}
+
+Graph StronglyConnectedComponents::extractLargestComponent() const {
+	const count numVertices = graph.numberOfVertices();
+	std::vector<index> newId(numVertices, invalid_id);
+	index numKept = 0;
+	for (index v = 0; v < numVertices; ++v) {
+		for (index e = graph.getExitOffset(v); e < graph.getExitOffset(v) + graph.getOutDegree(v); ++e) {
+			if (component[e] == largestComponent) {
+				newId[v] = numKept++;
+				break;
+			}
+		}
+	}
+
+	// new exit order of every forward edge and new entry order of every backward edge that is kept
+	std::vector<index> newExit(graph.numberOfEdges(), invalid_id);
+	std::vector<index> newEntry(graph.numberOfEdges(), invalid_id);
+	for (index v = 0; v < numVertices; ++v) {
+		if (newId[v] == invalid_id) continue;
+		index exit = 0;
+		for (index e = graph.getExitOffset(v); e < graph.getExitOffset(v) + graph.getOutDegree(v); ++e) {
+			if (newId[graph.getForwardEdge(e).head] != invalid_id) newExit[e] = exit++;
+		}
+		index entry = 0;
+		for (index e = graph.getEntryOffset(v); e < graph.getEntryOffset(v) + graph.getInDegree(v); ++e) {
+			if (newId[graph.getBackwardEdge(e).tail] != invalid_id) newEntry[e] = entry++;
+		}
+	}
+
+	std::vector<Vertex> vertices;
+	std::vector<ForwardEdge> forwardEdges;
+	std::vector<BackwardEdge> backwardEdges;
+	std::vector<Graph::TURN_TYPE> turnTables;
+	std::unordered_map<std::vector<Graph::TURN_TYPE>, index, TurnTableHasher> tableOffsets;
+	std::vector<Graph::TURN_TYPE> table;
+	vertices.reserve(numKept + 1);
+
+	graph.forVertices([&](index v, const Vertex &vertex) {
+		if (newId[v] == invalid_id) return;
+		const index firstOut = forwardEdges.size();
+		const index firstIn = backwardEdges.size();
+
+		for (index e = graph.getExitOffset(v); e < graph.getExitOffset(v) + graph.getOutDegree(v); ++e) {
+			if (newExit[e] == invalid_id) continue;
+			const ForwardEdge &edge = graph.getForwardEdge(e);
+			const index entry = newEntry[graph.getEntryOffset(edge.head) + edge.entryPoint];
+			forwardEdges.push_back({newId[edge.head], (turnorder) entry, edge.attributes});
+		}
+		for (index e = graph.getEntryOffset(v); e < graph.getEntryOffset(v) + graph.getInDegree(v); ++e) {
+			if (newEntry[e] == invalid_id) continue;
+			const BackwardEdge &edge = graph.getBackwardEdge(e);
+			const index exit = newExit[graph.getExitOffset(edge.tail) + edge.exitPoint];
+			backwardEdges.push_back({newId[edge.tail], (turnorder) exit, edge.attributes});
+		}
+
+		// restrict the turn table to the rows and columns of the remaining edges
+		table.clear();
+		for (index entry = 0; entry < graph.getInDegree(v); ++entry) {
+			if (newEntry[graph.getEntryOffset(v) + entry] == invalid_id) continue;
+			for (index exit = 0; exit < graph.getOutDegree(v); ++exit) {
+				if (newExit[graph.getExitOffset(v) + exit] == invalid_id) continue;
+				table.push_back(graph.getTurnType(v, (turnorder) entry, (turnorder) exit));
+			}
+		}
+
+		auto it = tableOffsets.find(table);
+		index turnTablePtr;
+		if (it != tableOffsets.end()) {
+			turnTablePtr = it->second;
+		} else {
+			turnTablePtr = turnTables.size();
+			tableOffsets.insert(std::make_pair(table, turnTablePtr));
+			turnTables.insert(turnTables.end(), table.begin(), table.end());
+		}
+
+		vertices.push_back({0, turnTablePtr, firstOut, firstIn, vertex.coord});
+	});
+	vertices.push_back({0, 0, (index) forwardEdges.size(), (index) backwardEdges.size(), {0, 0}});
+
+	return Graph(vertices, forwardEdges, backwardEdges, turnTables);
+}
+
+} /* namespace CRP */
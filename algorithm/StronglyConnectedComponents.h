@@ -0,0 +1,93 @@
+/*
+ * StronglyConnectedComponents.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALGORITHM_STRONGLYCONNECTEDCOMPONENTS_H_
+#define ALGORITHM_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <vector>
+
+#include "../constants.h"
+#include "../datastructures/Graph.h"
+
+namespace CRP {
+
+/**
+ * Computes the strongly connected components of the turn-expanded graph with an iterative version of Tarjan's
+ * algorithm. The vertices of the turn-expanded graph are the forward edges of @a graph, and there is an arc from
+ * edge (u, v) to edge (v, w) if the turn between them is neither NO_ENTRY nor U_TURN. All metrics give these turns
+ * infinite costs (ProfileFunction rejects profiles with finite costs for them), so a query can only get from one edge
+ * to another if both are in the same component.
+ */
+class StronglyConnectedComponents {
+public:
+	StronglyConnectedComponents(const Graph &graph);
+
+	void run();
+
+	inline count getNumberOfComponents() const {
+		return numComponents;
+	}
+
+	/** @return the component of forward edge @a e */
+	inline index getComponent(index e) const {
+		assert(e < component.size());
+		return component[e];
+	}
+
+	inline index getLargestComponent() const {
+		return largestComponent;
+	}
+
+	inline count getSizeOfComponent(index c) const {
+		assert(c < componentSizes.size());
+		return componentSizes[c];
+	}
+
+	/**
+	 * Builds the subgraph of all vertices that have an outgoing edge in the largest component. Every vertex of this
+	 * subgraph can reach every other one. All edges between the remaining vertices are kept, even if they are not in
+	 * the largest component themselves, since they can still be the first or last edge of a shortest path. The order
+	 * of the vertices and of their edges does not change.
+	 * @return the subgraph of the largest component
+	 */
+	Graph extractLargestComponent() const;
+
+private:
+	const Graph &graph;
+	std::vector<index> component;
+	std::vector<count> componentSizes;
+	count numComponents;
+	index largestComponent;
+
+	static inline bool isAllowed(Graph::TURN_TYPE turnType) {
+		return turnType != Graph::NO_ENTRY && turnType != Graph::U_TURN;
+	}
+};
+
+} /* namespace CRP */
+
+#endif /* ALGORITHM_STRONGLYCONNECTEDCOMPONENTS_H_ */
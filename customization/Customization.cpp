@@ -30,22 +30,29 @@
 #include <memory>
 #include <string>
 
+#include "../datastructures/CustomizationStats.h"
 #include "../datastructures/Graph.h"
 #include "../datastructures/OverlayGraph.h"
 #include "../datastructures/OverlayWeights.h"
+#include "../datastructures/id_queue.h"
 #include "../io/GraphIO.h"
-#include "../metrics/DistanceFunction.h"
-#include "../metrics/HopFunction.h"
+#include "../metrics/CostFunctionFactory.h"
 #include "../metrics/Metric.h"
-#include "../metrics/TimeFunction.h"
 
 using namespace std;
 
-
+/** Inserts ".<metricName>" before the extension of @a fileName if several metrics are computed. */
+string statsFileName(const string &fileName, const string &metricName, bool multipleMetrics) {
+	if (!multipleMetrics) return fileName;
+	size_t dot = fileName.find_last_of('.');
+	size_t slash = fileName.find_last_of('/');
+	if (dot == string::npos || (slash != string::npos && dot < slash)) return fileName + "." + metricName;
+	return fileName.substr(0, dot) + "." + metricName + fileName.substr(dot);
+}
 
 int main(int argc, char* argv[]) {
-	if (argc != 5) {
-		std::cout << "Usage: " << argv[0] << " path_to_graph path_to_overlay_graph metric_output_path metric_type" << std::endl;
+	if (argc < 5) {
+		std::cout << "Usage: " << argv[0] << " path_to_graph path_to_overlay_graph metric_output_path metric_type [--stats=<file.json|file.csv>] [--trace=<file.json>] [--queue=<heap2|heap4|heap8|radix>]" << std::endl;
 		return 1;
 	}
 
@@ -54,10 +61,39 @@ int main(int argc, char* argv[]) {
 	string metricPath(argv[3]);
 	string metricType(argv[4]);
 
+	string statsFile;
+	string traceFile;
+	CRP::QUEUE_TYPE queueType = CRP::QUATERNARY_HEAP;
+	for (int i = 5; i < argc; ++i) {
+		string arg(argv[i]);
+		if (arg.compare(0, 8, "--stats=") == 0) {
+			statsFile = arg.substr(8);
+		} else if (arg.compare(0, 8, "--trace=") == 0) {
+			traceFile = arg.substr(8);
+		} else if (arg.compare(0, 8, "--queue=") == 0) {
+			if (!CRP::parseQueueType(arg.substr(8), queueType)) {
+				cout << "unknown queue " << arg.substr(8) << std::endl;
+				return 1;
+			}
+		} else {
+			cout << "unknown option " << arg << std::endl;
+			return 1;
+		}
+	}
+
 	unordered_map<string, unique_ptr<CRP::CostFunction>> costFunctions;
-	costFunctions["hop"] = unique_ptr<CRP::CostFunction>(new CRP::HopFunction());
-	costFunctions["dist"] = unique_ptr<CRP::CostFunction>(new CRP::DistanceFunction());
-	costFunctions["time"] = unique_ptr<CRP::CostFunction>(new CRP::TimeFunction());
+	if (metricType == "all") {
+		for (string type : {"hop", "dist", "time"}) {
+			costFunctions[type] = CRP::createCostFunction(type);
+		}
+	} else {
+		unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+		if (!costFunction) {
+			cout << "unknown metric" << std::endl;
+			return 0;
+		}
+		costFunctions[CRP::getMetricName(metricType)] = std::move(costFunction);
+	}
 
 	CRP::Graph graph;
 	CRP::OverlayGraph overlayGraph;
@@ -67,24 +103,23 @@ int main(int argc, char* argv[]) {
 	cout << "reading overlay graph" << endl;
 	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
 
-	if (metricType == "all") {
-		for (auto &pair : costFunctions) {
-			CRP::Metric m(graph, overlayGraph, std::move(pair.second));
-			std::ofstream stream(metricPath + pair.first);
-			CRP::Metric::write(stream, m);
-			stream.close();
-		}
-	} else {
-		auto it = costFunctions.find(metricType);
-		if (it == costFunctions.end()) {
-			cout << "unknown metric" << std::endl;
-			return 0;
-		}
-
-		CRP::Metric m(graph, overlayGraph, std::move(it->second));
-		std::ofstream stream(metricPath + it->first);
+	const bool multipleMetrics = costFunctions.size() > 1;
+	for (auto &pair : costFunctions) {
+		CRP::CustomizationStats stats;
+		const bool recordStats = !statsFile.empty() || !traceFile.empty();
+		CRP::Metric m(graph, overlayGraph, std::move(pair.second), recordStats ? &stats : nullptr, queueType);
+		std::ofstream stream(metricPath + pair.first);
 		CRP::Metric::write(stream, m);
 		stream.close();
+
+		if (!statsFile.empty()) {
+			string fileName = statsFileName(statsFile, pair.first, multipleMetrics);
+			if (!stats.write(fileName)) cout << "could not write " << fileName << std::endl;
+		}
+		if (!traceFile.empty()) {
+			string fileName = statsFileName(traceFile, pair.first, multipleMetrics);
+			if (!stats.writeTrace(fileName)) cout << "could not write " << fileName << std::endl;
+		}
 	}
 
 	return 0;
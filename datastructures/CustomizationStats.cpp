@@ -0,0 +1,170 @@
+/*
+ * CustomizationStats.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CustomizationStats.h"
+#include "../timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include "omp.h"
+
+namespace CRP {
+
+CustomizationStats::CustomizationStats() : origin(get_micro_time()) {
+}
+
+long long CustomizationStats::now() const {
+	return get_micro_time() - origin;
+}
+
+void CustomizationStats::beginLevel(level l) {
+	const count numThreads = omp_get_max_threads();
+	if (cellsPerThread.size() < numThreads) {
+		cellsPerThread.resize(numThreads);
+	}
+	LevelStats stats = {l, numThreads, 0, now(), 0, 0, 0, 0};
+	levels.push_back(stats);
+}
+
+void CustomizationStats::endLevel(level l) {
+	assert(!levels.empty() && levels.back().l == l);
+	LevelStats &stats = levels.back();
+	stats.endTime = now();
+	for (const auto &cells : cellsPerThread) {
+		for (const CellStats &cell : cells) {
+			if (cell.l != l) continue;
+			stats.numCells++;
+			stats.busyTime += cell.getTime();
+			stats.pops += cell.pops;
+			stats.scannedArcs += cell.scannedArcs;
+		}
+	}
+}
+
+std::vector<CellStats> CustomizationStats::getCells() const {
+	std::vector<CellStats> cells;
+	for (const auto &threadCells : cellsPerThread) {
+		cells.insert(cells.end(), threadCells.begin(), threadCells.end());
+	}
+	std::sort(cells.begin(), cells.end(), [](const CellStats &a, const CellStats &b) {
+		return a.l < b.l || (a.l == b.l && a.startTime < b.startTime);
+	});
+	return cells;
+}
+
+bool CustomizationStats::writeJSON(const std::string &fileName, count numSlowestCells) const {
+	std::ofstream stream(fileName);
+	if (!stream.is_open()) return false;
+
+	std::vector<CellStats> cells = getCells();
+	long long totalTime = levels.empty() ? 0 : levels.back().endTime - levels.front().startTime;
+
+	stream << "{\n  \"total_time_us\": " << totalTime << ",\n  \"levels\": [";
+	for (index i = 0; i < levels.size(); ++i) {
+		const LevelStats &stats = levels[i];
+
+		// histogram of cell times with buckets [2^k, 2^(k+1)) microseconds
+		std::vector<count> histogram;
+		for (const CellStats &cell : cells) {
+			if (cell.l != stats.l) continue;
+			index bucket = 0;
+			while ((1ll << (bucket + 1)) <= cell.getTime()) ++bucket;
+			if (histogram.size() <= bucket) histogram.resize(bucket + 1, 0);
+			histogram[bucket]++;
+		}
+
+		stream << (i > 0 ? "," : "") << "\n    {\"level\": " << (int) stats.l << ", \"threads\": " << stats.numThreads
+				<< ", \"cells\": " << stats.numCells << ", \"wall_time_us\": " << stats.getWallTime() << ", \"busy_time_us\": " << stats.busyTime
+				<< ", \"utilization\": " << stats.getUtilization() << ", \"pops\": " << stats.pops << ", \"scanned_arcs\": " << stats.scannedArcs
+				<< ",\n     \"cell_time_histogram\": [";
+		for (index b = 0; b < histogram.size(); ++b) {
+			stream << (b > 0 ? ", " : "") << "{\"min_us\": " << (b == 0 ? 0 : 1ll << b) << ", \"max_us\": " << (1ll << (b + 1)) << ", \"cells\": " << histogram[b] << "}";
+		}
+		stream << "]}";
+	}
+	stream << "\n  ],\n  \"slowest_cells\": [";
+
+	std::sort(cells.begin(), cells.end(), [](const CellStats &a, const CellStats &b) {
+		return a.getTime() > b.getTime();
+	});
+	for (index i = 0; i < std::min<count>(numSlowestCells, cells.size()); ++i) {
+		const CellStats &cell = cells[i];
+		stream << (i > 0 ? "," : "") << "\n    {\"level\": " << (int) cell.l << ", \"cell\": " << cell.cellNumber << ", \"entry_points\": "
+				<< cell.numEntryPoints << ", \"exit_points\": " << cell.numExitPoints << ", \"time_us\": " << cell.getTime() << ", \"pops\": "
+				<< cell.pops << ", \"scanned_arcs\": " << cell.scannedArcs << ", \"thread\": " << cell.threadId << "}";
+	}
+	stream << "\n  ]\n}\n";
+
+	return true;
+}
+
+bool CustomizationStats::writeCSV(const std::string &fileName) const {
+	std::ofstream stream(fileName);
+	if (!stream.is_open()) return false;
+
+	stream << "level,cell,entry_points,exit_points,thread,start_us,time_us,pops,scanned_arcs\n";
+	for (const CellStats &cell : getCells()) {
+		stream << (int) cell.l << "," << cell.cellNumber << "," << cell.numEntryPoints << "," << cell.numExitPoints << "," << cell.threadId
+				<< "," << cell.startTime << "," << cell.getTime() << "," << cell.pops << "," << cell.scannedArcs << "\n";
+	}
+
+	return true;
+}
+
+bool CustomizationStats::writeTrace(const std::string &fileName) const {
+	std::ofstream stream(fileName);
+	if (!stream.is_open()) return false;
+
+	stream << "{\"traceEvents\": [";
+	bool first = true;
+	for (const LevelStats &stats : levels) {
+		stream << (first ? "" : ",") << "\n{\"name\": \"level " << (int) stats.l << "\", \"cat\": \"level\", \"ph\": \"X\", \"ts\": " << stats.startTime
+				<< ", \"dur\": " << stats.getWallTime() << ", \"pid\": 0, \"tid\": \"levels\", \"args\": {\"cells\": " << stats.numCells
+				<< ", \"utilization\": " << stats.getUtilization() << "}}";
+		first = false;
+	}
+	for (const CellStats &cell : getCells()) {
+		stream << (first ? "" : ",") << "\n{\"name\": \"cell " << cell.cellNumber << "\", \"cat\": \"level " << (int) cell.l << "\", \"ph\": \"X\", \"ts\": "
+				<< cell.startTime << ", \"dur\": " << cell.getTime() << ", \"pid\": 0, \"tid\": " << cell.threadId << ", \"args\": {\"entry_points\": "
+				<< cell.numEntryPoints << ", \"exit_points\": " << cell.numExitPoints << ", \"pops\": " << cell.pops << "}}";
+		first = false;
+	}
+	stream << "\n]}\n";
+
+	return true;
+}
+
+bool CustomizationStats::write(const std::string &fileName) const {
+	const std::string csv = ".csv";
+	if (fileName.size() >= csv.size() && fileName.compare(fileName.size() - csv.size(), csv.size(), csv) == 0) {
+		return writeCSV(fileName);
+	}
+	return writeJSON(fileName);
+}
+
+} /* namespace CRP */
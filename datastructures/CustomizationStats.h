@@ -0,0 +1,142 @@
+/*
+ * CustomizationStats.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DATASTRUCTURES_CUSTOMIZATIONSTATS_H_
+#define DATASTRUCTURES_CUSTOMIZATIONSTATS_H_
+
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+
+namespace CRP {
+
+/**
+ * Measurements of the customization of one cell. Times are in microseconds since the start of the customization.
+ */
+struct CellStats {
+	level l;
+	pv cellNumber;
+	count numEntryPoints;
+	count numExitPoints;
+	index threadId;
+	long long startTime;
+	long long endTime;
+	count pops;
+	count scannedArcs;
+
+	inline long long getTime() const {
+		return endTime - startTime;
+	}
+};
+
+/**
+ * Aggregated measurements of one level. The utilization is the fraction of the wall time the threads spent
+ * customizing cells.
+ */
+struct LevelStats {
+	level l;
+	count numThreads;
+	count numCells;
+	long long startTime;
+	long long endTime;
+	long long busyTime;
+	count pops;
+	count scannedArcs;
+
+	inline long long getWallTime() const {
+		return endTime - startTime;
+	}
+
+	inline double getUtilization() const {
+		return getWallTime() > 0 ? (double) busyTime / (double) (getWallTime() * numThreads) : 1.0;
+	}
+};
+
+/**
+ * Collects per-level and per-cell measurements of a customization. Cells are recorded per thread without
+ * synchronization; beginLevel and endLevel must be called outside of parallel regions.
+ */
+class CustomizationStats {
+public:
+	CustomizationStats();
+
+	void beginLevel(level l);
+	void endLevel(level l);
+
+	/**
+	 * Records a customized cell. Called from the thread with @a cell.threadId.
+	 * @param cell
+	 */
+	inline void addCell(const CellStats &cell) {
+		cellsPerThread[cell.threadId].push_back(cell);
+	}
+
+	/** Returns the microseconds since the customization started. */
+	long long now() const;
+
+	inline const std::vector<LevelStats>& getLevels() const {
+		return levels;
+	}
+
+	/** Returns all recorded cells ordered by level and start time. */
+	std::vector<CellStats> getCells() const;
+
+	/**
+	 * Writes the per-level summary, per-cell time histograms and the @a numSlowestCells slowest cells as JSON.
+	 * @param fileName
+	 * @param numSlowestCells
+	 */
+	bool writeJSON(const std::string &fileName, count numSlowestCells = 20) const;
+
+	/**
+	 * Writes one line per cell as CSV.
+	 * @param fileName
+	 */
+	bool writeCSV(const std::string &fileName) const;
+
+	/**
+	 * Writes levels and cells as Chrome trace events (see chrome://tracing), one track per thread.
+	 * @param fileName
+	 */
+	bool writeTrace(const std::string &fileName) const;
+
+	/**
+	 * Writes JSON or CSV depending on the extension of @a fileName.
+	 * @param fileName
+	 */
+	bool write(const std::string &fileName) const;
+
+private:
+	long long origin;
+	std::vector<LevelStats> levels;
+	std::vector<std::vector<CellStats>> cellsPerThread;
+};
+
+} /* namespace CRP */
+
+#endif /* DATASTRUCTURES_CUSTOMIZATIONSTATS_H_ */
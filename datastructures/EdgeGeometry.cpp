@@ -0,0 +1,98 @@
+/*
+ * EdgeGeometry.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "EdgeGeometry.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace CRP {
+
+void EdgeGeometry::addChain(const Coordinate &tail, const Coordinate &head, const std::vector<Coordinate> &points) {
+	const EndPoints chain = {tail, head};
+	if (chainIndex.find(chain) != chainIndex.end()) return;
+
+	chainIndex.insert(std::make_pair(chain, endPoints.size()));
+	endPoints.push_back(chain);
+	this->points.insert(this->points.end(), points.begin(), points.end());
+	firstPoint.push_back(this->points.size());
+}
+
+bool EdgeGeometry::write(const std::string &outputFileName) const {
+	std::ofstream file(outputFileName);
+	if (!file.is_open()) return false;
+
+	// one line per chain: the number of removed vertices, then the coordinates of tail, removed vertices and head
+	file << std::setprecision(16);
+	file << numberOfChains() << std::endl;
+	for (index c = 0; c < numberOfChains(); ++c) {
+		file << firstPoint[c+1] - firstPoint[c] << " " << endPoints[c].tail.lat << " " << endPoints[c].tail.lon;
+		for (index i = firstPoint[c]; i < firstPoint[c+1]; ++i) {
+			file << " " << points[i].lat << " " << points[i].lon;
+		}
+		file << " " << endPoints[c].head.lat << " " << endPoints[c].head.lon << std::endl;
+	}
+
+	return true;
+}
+
+bool EdgeGeometry::read(const std::string &inputFileName) {
+	std::ifstream file(inputFileName);
+	if (!file.is_open()) return false;
+
+	endPoints.clear();
+	firstPoint.assign(1, 0);
+	points.clear();
+	chainIndex.clear();
+
+	std::string line;
+	if (!std::getline(file, line)) return false;
+	const count numChains = std::stoul(line);
+	endPoints.reserve(numChains);
+	firstPoint.reserve(numChains + 1);
+
+	std::vector<Coordinate> chainPoints;
+	for (index c = 0; c < numChains; ++c) {
+		if (!std::getline(file, line)) return false;
+		std::istringstream stream(line);
+		count numPoints;
+		Coordinate tail, head;
+		stream >> numPoints >> tail.lat >> tail.lon;
+		chainPoints.resize(numPoints);
+		for (Coordinate &point : chainPoints) {
+			stream >> point.lat >> point.lon;
+		}
+		stream >> head.lat >> head.lon;
+		if (stream.fail()) return false;
+		addChain(tail, head, chainPoints);
+	}
+
+	return true;
+}
+
+} /* namespace CRP */
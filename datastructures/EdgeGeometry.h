@@ -0,0 +1,123 @@
+/*
+ * EdgeGeometry.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DATASTRUCTURES_EDGEGEOMETRY_H_
+#define DATASTRUCTURES_EDGEGEOMETRY_H_
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../constants.h"
+#include "Graph.h"
+
+namespace CRP {
+
+/**
+ * Stores the coordinates of the vertices that were removed when a chain of degree-2 vertices was merged
+ * into a single edge. A chain is identified by the coordinates of its two end vertices, since these survive
+ * renumbering the vertices of the graph. A chain of a two-way road is stored once and found in both directions.
+ */
+class EdgeGeometry {
+public:
+	EdgeGeometry() = default;
+
+	/**
+	 * Adds a chain between the vertices at @a tail and @a head.
+	 * @param points the coordinates of the removed vertices in order from @a tail to @a head
+	 */
+	void addChain(const Coordinate &tail, const Coordinate &head, const std::vector<Coordinate> &points);
+
+	inline count numberOfChains() const {
+		return firstPoint.size() - 1;
+	}
+
+	inline count numberOfPoints() const {
+		return points.size();
+	}
+
+	/**
+	 * Calls @a handle on the coordinates of all removed vertices between @a tail and @a head, in this order.
+	 * Nothing is done if the edge was not a chain.
+	 * @param handle must handle a Coordinate
+	 */
+	template <typename L> void forIntermediatePoints(const Coordinate &tail, const Coordinate &head, L handle) const;
+
+	bool write(const std::string &outputFileName) const;
+
+	bool read(const std::string &inputFileName);
+
+private:
+	struct EndPoints {
+		Coordinate tail;
+		Coordinate head;
+
+		bool operator==(const EndPoints &other) const {
+			return std::memcmp(this, &other, sizeof(EndPoints)) == 0;
+		}
+	};
+
+	struct EndPointsHasher {
+		std::size_t operator()(const EndPoints &endPoints) const {
+			uint32_t bits[4];
+			std::memcpy(bits, &endPoints, sizeof(bits));
+			std::size_t seed = 0;
+			for (uint32_t b : bits) {
+				seed ^= b + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+			return seed;
+		}
+	};
+
+	std::vector<EndPoints> endPoints;
+	std::vector<index> firstPoint = std::vector<index>(1, 0);
+	std::vector<Coordinate> points;
+	std::unordered_map<EndPoints, index, EndPointsHasher> chainIndex;
+};
+
+template <typename L>
+void EdgeGeometry::forIntermediatePoints(const Coordinate &tail, const Coordinate &head, L handle) const {
+	auto it = chainIndex.find({tail, head});
+	if (it != chainIndex.end()) {
+		for (index i = firstPoint[it->second]; i < firstPoint[it->second + 1]; ++i) {
+			handle(points[i]);
+		}
+		return;
+	}
+
+	it = chainIndex.find({head, tail});
+	if (it != chainIndex.end()) {
+		for (index i = firstPoint[it->second + 1]; i > firstPoint[it->second]; --i) {
+			handle(points[i - 1]);
+		}
+	}
+}
+
+} /* namespace CRP */
+
+#endif /* DATASTRUCTURES_EDGEGEOMETRY_H_ */
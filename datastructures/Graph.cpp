@@ -27,6 +27,8 @@
 
 #include "Graph.h"
 
+#include <algorithm>
+
 namespace CRP {
 
 Graph::Graph(const std::vector<Vertex> &vertices, const std::vector<ForwardEdge> &forwardEdges, const std::vector<BackwardEdge> &backwardEdges) : vertices(vertices), forwardEdges(forwardEdges),
@@ -56,77 +58,86 @@ bool Graph::hasEdge(index u, index v) const {
 }
 
 void Graph::sortVerticesByCellNumber() {
-	std::vector<std::vector<std::pair<Vertex, index>>> cellVertices(cellNumbers.size());
-	std::vector<count> numForwardEdgesInCell(cellNumbers.size(), 0);
-	std::vector<count> numBackwardEdgesInCell(cellNumbers.size(), 0);
-	std::vector<std::vector<ForwardEdge>> fEdges(vertices.size()-1);
-	std::vector<std::vector<BackwardEdge>> bEdges(vertices.size()-1);
+	// Counting sort over pvPtr. The relative order of the vertices within a cell is kept, so the
+	// result is the same as with a stable sort. Apart from the new ids, only one additional vertex
+	// array and one additional edge array at a time are needed.
+	const count numVertices = vertices.size()-1;
+	std::vector<index> firstVertexInCell(cellNumbers.size() + 1, 0);
+	forwardEdgeCellOffset = std::vector<index>(cellNumbers.size() + 1, 0);
+	backwardEdgeCellOffset = std::vector<index>(cellNumbers.size() + 1, 0);
+	for (index i = 0; i < numVertices; ++i) {
+		const index cell = vertices[i].pvPtr;
+		++firstVertexInCell[cell + 1];
+		forwardEdgeCellOffset[cell + 1] += getOutDegree(i);
+		backwardEdgeCellOffset[cell + 1] += getInDegree(i);
+	}
 
 	maxEdgesInCell = 0;
-	for (index i = 0; i < vertices.size()-1; ++i) {
-		index cell = vertices[i].pvPtr;
-		cellVertices[cell].push_back(std::make_pair(vertices[i], i));
-		fEdges[i] = std::vector<ForwardEdge>(getOutDegree(i));
-		bEdges[i] = std::vector<BackwardEdge>(getInDegree(i));
-		for (index k = 0, e = vertices[i].firstOut; e < vertices[i+1].firstOut; ++e, ++k) {
-			fEdges[i][k] = forwardEdges[e];
-		}
-		for (index k = 0, e = vertices[i].firstIn; e < vertices[i+1].firstIn; ++e, ++k) {
-			bEdges[i][k] = backwardEdges[e];
-		}
-
-		numForwardEdgesInCell[cell] += getOutDegree(i);
-		numBackwardEdgesInCell[cell] += getInDegree(i);
-
-		if (maxEdgesInCell < numForwardEdgesInCell[cell]) {
-			maxEdgesInCell = numForwardEdgesInCell[cell];
-		}
+	for (index cell = 0; cell < cellNumbers.size(); ++cell) {
+		maxEdgesInCell = std::max(maxEdgesInCell, std::max(forwardEdgeCellOffset[cell + 1], backwardEdgeCellOffset[cell + 1]));
+		firstVertexInCell[cell + 1] += firstVertexInCell[cell];
+		forwardEdgeCellOffset[cell + 1] += forwardEdgeCellOffset[cell];
+		backwardEdgeCellOffset[cell + 1] += backwardEdgeCellOffset[cell];
+	}
 
-		if (maxEdgesInCell < numBackwardEdgesInCell[cell]) {
-			maxEdgesInCell = numBackwardEdgesInCell[cell];
-		}
+	std::vector<index> newId(numVertices);
+	std::vector<index> oldId(numVertices);
+	for (index i = 0; i < numVertices; ++i) {
+		const index vId = firstVertexInCell[vertices[i].pvPtr]++;
+		newId[i] = vId;
+		oldId[vId] = i;
 	}
+	std::vector<index>().swap(firstVertexInCell);
 
-	std::vector<index> newId(vertices.size()-1);
-	index newVId = 0;
-	for (index i = 0; i < cellVertices.size(); ++i) {
-		for (index v = 0; v < cellVertices[i].size(); ++v, ++newVId) {
-			newId[cellVertices[i][v].second] = newVId;
-		}
+	std::vector<Vertex> sortedVertices(vertices.size());
+#pragma omp parallel for
+	for (index vId = 0; vId < numVertices; ++vId) {
+		sortedVertices[vId] = vertices[oldId[vId]];
 	}
-	assert(newVId == vertices.size()-1);
 
-	index vId = 0;
+	// the edges of the vertices are stored consecutively in the new order
 	index forwardOffset = 0;
-	forwardEdgeCellOffset = std::vector<index>(cellNumbers.size());
 	index backwardOffset = 0;
-	backwardEdgeCellOffset = std::vector<index>(cellNumbers.size());
-
-	for (index i = 0; i < cellNumbers.size(); ++i) {
-		forwardEdgeCellOffset[i] = forwardOffset;
-		backwardEdgeCellOffset[i] = backwardOffset;
-		for (index v = 0; v < cellVertices[i].size(); ++v, vId++) {
-			vertices[vId] = cellVertices[i][v].first;
-			index vOldId = cellVertices[i][v].second;
-			vertices[vId].firstOut = forwardOffset;
-			vertices[vId].firstIn = backwardOffset;
-			for (index k = 0; k < fEdges[vOldId].size(); ++k) {
-				forwardEdges[forwardOffset] = fEdges[vOldId][k];
-				forwardEdges[forwardOffset].head = newId[fEdges[vOldId][k].head];
-				forwardOffset++;
-			}
-
-			for (index k = 0; k < bEdges[vOldId].size(); ++k) {
-				backwardEdges[backwardOffset] = bEdges[vOldId][k];
-				backwardEdges[backwardOffset].tail = newId[bEdges[vOldId][k].tail];
-				backwardOffset++;
-			}
-		}
+	for (index vId = 0; vId < numVertices; ++vId) {
+		const index vOldId = oldId[vId];
+		sortedVertices[vId].firstOut = forwardOffset;
+		sortedVertices[vId].firstIn = backwardOffset;
+		forwardOffset += getOutDegree(vOldId);
+		backwardOffset += getInDegree(vOldId);
 	}
-
-	assert(vId == vertices.size()-1);
 	assert(forwardOffset == forwardEdges.size());
 	assert(backwardOffset == backwardEdges.size());
+	sortedVertices[numVertices] = vertices[numVertices];
+
+	std::vector<ForwardEdge> sortedForwardEdges(forwardEdges.size());
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (index vId = 0; vId < numVertices; ++vId) {
+		const index vOldId = oldId[vId];
+		index e = sortedVertices[vId].firstOut;
+		for (index oldE = vertices[vOldId].firstOut; oldE < vertices[vOldId+1].firstOut; ++oldE, ++e) {
+			sortedForwardEdges[e] = forwardEdges[oldE];
+			sortedForwardEdges[e].head = newId[forwardEdges[oldE].head];
+		}
+	}
+	std::vector<ForwardEdge>().swap(forwardEdges);
+	forwardEdges.swap(sortedForwardEdges);
+
+	std::vector<BackwardEdge> sortedBackwardEdges(backwardEdges.size());
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (index vId = 0; vId < numVertices; ++vId) {
+		const index vOldId = oldId[vId];
+		index e = sortedVertices[vId].firstIn;
+		for (index oldE = vertices[vOldId].firstIn; oldE < vertices[vOldId+1].firstIn; ++oldE, ++e) {
+			sortedBackwardEdges[e] = backwardEdges[oldE];
+			sortedBackwardEdges[e].tail = newId[backwardEdges[oldE].tail];
+		}
+	}
+	std::vector<BackwardEdge>().swap(backwardEdges);
+	backwardEdges.swap(sortedBackwardEdges);
+
+	vertices.swap(sortedVertices);
+	forwardEdgeCellOffset.pop_back();
+	backwardEdgeCellOffset.pop_back();
 
 	this->forEdges([&](index start, index target, index forwardEdge) {
 		assert(start < vertices.size());
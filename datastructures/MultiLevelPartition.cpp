@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cmath>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <iostream>
 
@@ -48,11 +49,44 @@ void MultiLevelPartition::setNumberOfCellsInLevel(const int level, const int num
 	this->numCells[level] = numCells;
 }
 
-void MultiLevelPartition::computeBitmap() {
+bool MultiLevelPartition::computeBitmap() {
 	pvOffset = std::vector<uint8_t>(numCells.size()+1);
 	for (index i = 0; i < numCells.size(); ++i) {
 		pvOffset[i+1] = pvOffset[i] + ceil(log2(numCells[i]));
 	}
+	if (pvOffset.back() > 8 * sizeof(pv)) {
+		std::cout << "ERROR: the cell numbers need " << (int) pvOffset.back() << " bits, but only " << 8 * sizeof(pv) << " are available, use larger cells or fewer levels" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool MultiLevelPartition::parseCellSizes(const std::string& specification, std::vector<count>& maxCellSizes) {
+	maxCellSizes.clear();
+	if (specification.empty() || specification.back() == ',') {
+		std::cout << "ERROR: invalid cell sizes " << specification << std::endl;
+		return false;
+	}
+
+	std::stringstream sizes(specification);
+	std::string size;
+	while (std::getline(sizes, size, ',')) {
+		// at most 9 digits, so that the size fits into a count
+		if (size.empty() || size.size() > 9 || size.find_first_not_of("0123456789") != std::string::npos) {
+			std::cout << "ERROR: invalid cell size '" << size << "' in " << specification << std::endl;
+			return false;
+		}
+		maxCellSizes.push_back(std::stoul(size));
+		if (maxCellSizes.back() < 2) {
+			std::cout << "ERROR: cells must have a size of at least 2 in " << specification << std::endl;
+			return false;
+		}
+		if (maxCellSizes.size() > 1 && maxCellSizes.back() <= maxCellSizes[maxCellSizes.size() - 2]) {
+			std::cout << "ERROR: cell sizes must increase from level to level in " << specification << std::endl;
+			return false;
+		}
+	}
+	return true;
 }
 
 void MultiLevelPartition::setCell(const int level, const int vertexId, const int cellId) {
@@ -64,7 +98,7 @@ void MultiLevelPartition::setCell(const int level, const int vertexId, const int
 }
 
 index MultiLevelPartition::getCell(const int level, const int vertexId) const {
-	return (cellNumbers[vertexId] >> pvOffset[level]) & ~(~0 << pvOffset[level+1]);
+	return (cellNumbers[vertexId] >> pvOffset[level]) & ((((pv) 1) << (pvOffset[level+1] - pvOffset[level])) - 1);
 }
 
 count MultiLevelPartition::getNumberOfVertices() const {
@@ -48,7 +48,18 @@ public:
 	void setNumberOfLevels(const size_t numLevels);
 	void setNumberOfVertices(const int numVertices);
 	void setNumberOfCellsInLevel(const int level, const int numCells);
-	void computeBitmap();
+
+	/**
+	 * Computes where the cell ids of each level are stored in the cell numbers.
+	 * @return false if the cell numbers need more bits than a pv has
+	 */
+	bool computeBitmap();
+
+	/**
+	 * Parses a comma separated list of maximum cell sizes, starting with the lowest level.
+	 * @return false if @a specification is not a list of increasing numbers of at least 2
+	 */
+	static bool parseCellSizes(const std::string& specification, std::vector<count>& maxCellSizes);
 
 	/**
 	 * Sets the @a cellId for vertex with @a vertexId on @a level.
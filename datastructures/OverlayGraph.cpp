@@ -34,20 +34,29 @@
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <parallel/algorithm>
+#include <utility>
+
+#include "omp.h"
 
 #include "Graph.h"
 #include "MultiLevelPartition.h"
 
 namespace CRP {
 
-OverlayGraph::OverlayGraph(Graph &graph, const MultiLevelPartition &mlp) : vertexCountInLevel(), levelInfo(mlp.getPVOffsets()) {
-	build(graph, mlp.getNumberOfLevels());
+OverlayGraph::OverlayGraph(Graph &graph, const MultiLevelPartition &mlp, bool parallel) : vertexCountInLevel(), levelInfo(mlp.getPVOffsets()) {
+	build(graph, mlp.getNumberOfLevels(), parallel);
 }
 
 
-void OverlayGraph::build(Graph &graph, level numberOfLevels) {
-	std::vector<bool> exitFlagArray = buildOverlayVertices(graph, numberOfLevels);
-	buildCells(graph, numberOfLevels, exitFlagArray);
+void OverlayGraph::build(Graph &graph, level numberOfLevels, bool parallel) {
+	if (parallel) {
+		std::vector<bool> exitFlagArray = parallelBuildOverlayVertices(graph, numberOfLevels);
+		parallelBuildCells(graph, numberOfLevels, exitFlagArray);
+	} else {
+		std::vector<bool> exitFlagArray = buildOverlayVertices(graph, numberOfLevels);
+		buildCells(graph, numberOfLevels, exitFlagArray);
+	}
 }
 
 std::vector<bool> OverlayGraph::buildOverlayVertices(Graph& graph, level numberOfLevels) {
@@ -69,7 +78,7 @@ std::vector<bool> OverlayGraph::buildOverlayVertices(Graph& graph, level numberO
 
 			OverlayVertex targetVertex;
 			targetVertex.cellNumber = targetPV;
-			targetVertex.originalEdge = graph.findBackwardEdge(start, target);
+			targetVertex.originalEdge = graph.getEntryOffset(target) + graph.getForwardEdge(forwardEdge).entryPoint;
 			targetVertex.originalVertex = target;
 			targetVertex.neighborOverlayVertex = overlayVerticesByLevel[overlayLevel - 1].size() - 1;
 			targetVertex.entryExitPoint.resize(overlayLevel);
@@ -101,8 +110,9 @@ std::vector<bool> OverlayGraph::buildOverlayVertices(Graph& graph, level numberO
 		std::vector<index> newToOldPosition(v.size());
 		std::iota(newToOldPosition.begin(), newToOldPosition.end(), 0);
 
+		// ties are broken by the position so that the parallel builder yields the same order
 		std::sort(newToOldPosition.begin(), newToOldPosition.end(), [&](index lhs, index rhs) {
-			return v[lhs].cellNumber < v[rhs].cellNumber;
+			return v[lhs].cellNumber < v[rhs].cellNumber || (v[lhs].cellNumber == v[rhs].cellNumber && lhs < rhs);
 		});
 
 		std::vector<index> oldToNewPosition(newToOldPosition.size());
@@ -223,6 +233,233 @@ void OverlayGraph::buildCells(Graph& graph, level numberOfLevels, std::vector<bo
 	weightVectorSize = cellOffset;
 }
 
+std::vector<bool> OverlayGraph::parallelBuildOverlayVertices(Graph& graph, level numberOfLevels) {
+	// The vertices are split into consecutive chunks. Counting the boundary edges per chunk and level
+	// first allows every chunk to write its overlay vertices to the same positions as the serial builder.
+	const count numVertices = graph.numberOfVertices();
+	const count numChunks = std::max<count>(1, std::min<count>(numVertices, 16 * omp_get_max_threads()));
+	auto chunkBegin = [&](index chunk) {
+		return (index) ((pv) numVertices * chunk / numChunks);
+	};
+	std::vector<std::vector<index>> chunkOffset(numChunks + 1, std::vector<index>(numberOfLevels, 0));
+
+#pragma omp parallel for schedule(dynamic)
+	for (index chunk = 0; chunk < numChunks; ++chunk) {
+		for (index u = chunkBegin(chunk); u < chunkBegin(chunk + 1); ++u) {
+			const pv startPV = graph.getCellNumber(u);
+			for (index e = graph.getExitOffset(u); e < graph.getExitOffset(u + 1); ++e) {
+				const int overlayLevel = levelInfo.getHighestDifferingLevel(startPV, graph.getCellNumber(graph.getForwardEdge(e).head));
+				if (overlayLevel > 0) chunkOffset[chunk + 1][overlayLevel - 1] += 2;
+			}
+		}
+	}
+	for (index chunk = 0; chunk < numChunks; ++chunk) {
+		for (level l = 0; l < numberOfLevels; ++l) {
+			chunkOffset[chunk + 1][l] += chunkOffset[chunk][l];
+		}
+	}
+
+	std::vector<std::vector<OverlayVertex>> overlayVerticesByLevel(numberOfLevels);
+	for (level l = 0; l < numberOfLevels; ++l) {
+		overlayVerticesByLevel[l].resize(chunkOffset[numChunks][l]);
+	}
+
+#pragma omp parallel for schedule(dynamic)
+	for (index chunk = 0; chunk < numChunks; ++chunk) {
+		std::vector<index> position = chunkOffset[chunk];
+		for (index start = chunkBegin(chunk); start < chunkBegin(chunk + 1); ++start) {
+			const pv startPV = graph.getCellNumber(start);
+			for (index e = graph.getExitOffset(start); e < graph.getExitOffset(start + 1); ++e) {
+				const ForwardEdge& edge = graph.getForwardEdge(e);
+				const pv targetPV = graph.getCellNumber(edge.head);
+				const int overlayLevel = levelInfo.getHighestDifferingLevel(startPV, targetPV);
+				if (overlayLevel <= 0) continue;
+
+				index& i = position[overlayLevel - 1];
+				OverlayVertex& startVertex = overlayVerticesByLevel[overlayLevel - 1][i];
+				startVertex.cellNumber = startPV;
+				startVertex.originalEdge = e;
+				startVertex.originalVertex = start;
+				startVertex.neighborOverlayVertex = i + 1;
+				startVertex.entryExitPoint.resize(overlayLevel);
+
+				OverlayVertex& targetVertex = overlayVerticesByLevel[overlayLevel - 1][i + 1];
+				targetVertex.cellNumber = targetPV;
+				targetVertex.originalEdge = graph.getEntryOffset(edge.head) + edge.entryPoint;
+				targetVertex.originalVertex = edge.head;
+				targetVertex.neighborOverlayVertex = i;
+				targetVertex.entryExitPoint.resize(overlayLevel);
+				i += 2;
+			}
+		}
+	}
+
+	assert(vertexCountInLevel.empty());
+	vertexCountInLevel.reserve(overlayVerticesByLevel.size());
+	for (auto& v : overlayVerticesByLevel) {
+		vertexCountInLevel.push_back(v.size());
+	}
+	std::partial_sum(vertexCountInLevel.rbegin(), vertexCountInLevel.rend(), vertexCountInLevel.rbegin());
+	const count overlayVertexCount = vertexCountInLevel[0];
+
+	std::cout << "Num Overlay Vertices = " << overlayVertexCount << std::endl;
+
+	// Sort each level by cell number and move it to its final position. The sub-vertex mapping is
+	// computed in parallel but inserted in the same order as in the serial builder, which keeps
+	// the layout of the hash map (and thus the written graph) identical.
+	assert(overlayVertices.empty());
+	overlayVertices.resize(overlayVertexCount);
+	std::vector<bool> exitFlagsArray(overlayVertexCount);
+	std::vector<std::pair<SubVertex, index>> subVertices(overlayVertexCount);
+
+	for (level j = 0; j < numberOfLevels; ++j) {
+		auto& v = overlayVerticesByLevel[j];
+		const index vertexOffset = vertexCountInLevel[j] - v.size();
+		std::vector<index> newToOldPosition(v.size());
+		std::iota(newToOldPosition.begin(), newToOldPosition.end(), 0);
+
+		__gnu_parallel::sort(newToOldPosition.begin(), newToOldPosition.end(), [&](index lhs, index rhs) {
+			return v[lhs].cellNumber < v[rhs].cellNumber || (v[lhs].cellNumber == v[rhs].cellNumber && lhs < rhs);
+		});
+
+		std::vector<index> oldToNewPosition(newToOldPosition.size());
+#pragma omp parallel for
+		for (index i = 0; i < newToOldPosition.size(); ++i) {
+			oldToNewPosition[newToOldPosition[i]] = i;
+		}
+
+#pragma omp parallel for
+		for (index i = 0; i < v.size(); ++i) {
+			OverlayVertex& vertex = overlayVertices[i + vertexOffset];
+			vertex = std::move(v[newToOldPosition[i]]);
+			vertex.neighborOverlayVertex = oldToNewPosition[vertex.neighborOverlayVertex] + vertexOffset;
+
+			const bool isExitPoint = newToOldPosition[i] % 2 == 0;
+			turnorder order;
+			if (isExitPoint) {
+				order = graph.getExitOrder(vertex.originalVertex, vertex.originalEdge);
+			} else {
+				order = graph.getEntryOrder(vertex.originalVertex, vertex.originalEdge);
+			}
+			subVertices[i + vertexOffset] = std::make_pair(SubVertex{vertex.originalVertex, order, isExitPoint}, i + vertexOffset);
+		}
+
+		for (index i = 0; i < v.size(); ++i) {
+			exitFlagsArray[i + vertexOffset] = newToOldPosition[i] % 2 == 0;
+		}
+		std::vector<OverlayVertex>().swap(v);
+	}
+
+	std::unordered_map<SubVertex, index, SubVertexHasher> originalToOverlayVertexMap;
+	originalToOverlayVertexMap.reserve(overlayVertexCount);
+	for (level j = 0; j < numberOfLevels; ++j) {
+		const index vertexOffset = (j + 1 < numberOfLevels) ? vertexCountInLevel[j + 1] : 0;
+		for (index i = vertexOffset; i < vertexCountInLevel[j]; ++i) {
+			originalToOverlayVertexMap[subVertices[i].first] = subVertices[i].second;
+		}
+	}
+
+	assert(originalToOverlayVertexMap.size() == overlayVertexCount);
+	graph.setOverlayMapping(originalToOverlayVertexMap);
+	return exitFlagsArray;
+}
+
+void OverlayGraph::parallelBuildCells(Graph& graph, level numberOfLevels, std::vector<bool> &exitFlagsArray) {
+	// A group is a maximal range of overlay vertices (sorted by truncated cell number and position) in the same cell.
+	struct CellGroup {
+		pv cellNumber;
+		index begin;
+		index end;
+	};
+
+	cellMapping.resize(numberOfLevels);
+	std::vector<std::vector<std::pair<pv, index>>> sortedVerticesByLevel(numberOfLevels);
+	std::vector<std::vector<CellGroup>> groupsByLevel(numberOfLevels);
+
+	index cellOffset = 0;
+	index overlayIdOffset = 0;
+	for (level l = numberOfLevels - 1; l != static_cast<level>(-1); --l) {
+		// Note that the actual level in the overlay graph is l+1
+		auto& sortedVertices = sortedVerticesByLevel[l];
+		sortedVertices.resize(vertexCountInLevel[l]);
+#pragma omp parallel for
+		for (index v = 0; v < vertexCountInLevel[l]; ++v) {
+			sortedVertices[v] = std::make_pair(levelInfo.truncateToLevel(overlayVertices[v].cellNumber, l + 1), v);
+		}
+		__gnu_parallel::sort(sortedVertices.begin(), sortedVertices.end());
+
+		auto& groups = groupsByLevel[l];
+		for (index i = 0; i < sortedVertices.size(); ++i) {
+			if (i == 0 || sortedVertices[i].first != sortedVertices[i - 1].first) {
+				if (!groups.empty()) groups.back().end = i;
+				groups.push_back({sortedVertices[i].first, i, 0});
+			}
+		}
+		if (!groups.empty()) groups.back().end = sortedVertices.size();
+
+		// number the entry and exit points of each cell in the order of the overlay vertices
+		std::vector<Cell> cells(groups.size());
+#pragma omp parallel for schedule(dynamic)
+		for (index g = 0; g < groups.size(); ++g) {
+			Cell& cell = cells[g];
+			cell.numEntryPoints = 0;
+			cell.numExitPoints = 0;
+			for (index i = groups[g].begin; i < groups[g].end; ++i) {
+				const index v = sortedVertices[i].second;
+				if (exitFlagsArray[v]) {
+					overlayVertices[v].entryExitPoint[l] = cell.numExitPoints++;
+				} else {
+					overlayVertices[v].entryExitPoint[l] = cell.numEntryPoints++;
+				}
+			}
+		}
+
+		// insert the cells in the order of their first overlay vertex, just like the serial builder
+		std::vector<index> groupOrder(groups.size());
+		std::iota(groupOrder.begin(), groupOrder.end(), 0);
+		__gnu_parallel::sort(groupOrder.begin(), groupOrder.end(), [&](index lhs, index rhs) {
+			return sortedVertices[groups[lhs].begin].second < sortedVertices[groups[rhs].begin].second;
+		});
+		auto& cellsInLevel = cellMapping[l];
+		for (index g : groupOrder) {
+			cellsInLevel[groups[g].cellNumber] = cells[g];
+		}
+
+		// calculate offsets
+		for (auto it = cellsInLevel.begin(); it != cellsInLevel.end(); ++it) {
+			Cell& cell = it->second;
+			cell.overlayIdOffset = overlayIdOffset;
+			cell.cellOffset = cellOffset;
+			overlayIdOffset += cell.numEntryPoints + cell.numExitPoints;
+			cellOffset += cell.numEntryPoints * cell.numExitPoints;
+		}
+	}
+
+	// fill overlayIdMapping, every overlay vertex writes its own slot
+	overlayIdMapping.resize(overlayIdOffset);
+	for (level l = numberOfLevels - 1; l != static_cast<level>(-1); --l) {
+		const auto& cellsInLevel = cellMapping[l];
+		const auto& sortedVertices = sortedVerticesByLevel[l];
+		const auto& groups = groupsByLevel[l];
+#pragma omp parallel for schedule(dynamic)
+		for (index g = 0; g < groups.size(); ++g) {
+			const auto cellPtr = cellsInLevel.find(groups[g].cellNumber);
+			assert(cellPtr != cellsInLevel.end());
+			const Cell& cell = cellPtr->second;
+			for (index i = groups[g].begin; i < groups[g].end; ++i) {
+				const index v = sortedVertices[i].second;
+				index mappingIndex = cell.overlayIdOffset + overlayVertices[v].entryExitPoint[l];
+				if (exitFlagsArray[v]) {
+					mappingIndex += cell.numEntryPoints;
+				}
+				overlayIdMapping[mappingIndex] = v;
+			}
+		}
+	}
+
+	weightVectorSize = cellOffset;
+}
+
 const Cell& OverlayGraph::getCell(pv cellNumber, level l) const {
 	assert(0 < l && l <= levelInfo.getLevelCount());
 	pv truncatedCellNumber = levelInfo.truncateToLevel(cellNumber, l);
@@ -73,7 +73,13 @@ public:
 			vertexCountInLevel(vertexCountInLevel), cellMapping(cellMapping), overlayIdMapping(overlayIdMapping),
 			levelInfo(levelInfo), weightVectorSize(weightVectorSize) {}
 
-	OverlayGraph(Graph &graph, const MultiLevelPartition &mlp);
+	/**
+	 * Builds the overlay graph of @a graph for the partition @a mlp and sets the overlay mapping of @a graph.
+	 * @param graph the graph, sorted by cell numbers
+	 * @param mlp the multi-level partition
+	 * @param parallel whether to use the parallel builder. Both builders produce the same overlay graph.
+	 */
+	OverlayGraph(Graph &graph, const MultiLevelPartition &mlp, bool parallel = true);
 
 	OverlayGraph() = default;
 
@@ -98,9 +104,11 @@ public:
 	 * Iterates over all incoming neighbors of @a u.
 	 * @param v An exit vertex
 	 * @param l Level of the cell
+	 * @param transposed if true, the weight indices point into the transposed weight array (see
+	 * OverlayWeights::getTransposedWeight), so that the weights of a column are read one after another
 	 * @param handle must handle an index to entry OverlayVertex and an index into the weight array
 	 */
-	template <typename L> void forInNeighborsOf(index v, level l, L handle) const;
+	template <typename L> void forInNeighborsOf(index v, level l, bool transposed, L handle) const;
 
 	/**
 	 * Iterates over all cells in level @a l.
@@ -179,7 +187,7 @@ private:
 	LevelInfo levelInfo;
 	count weightVectorSize;
 
-	void build(Graph &graph, level numberOfLevels);
+	void build(Graph &graph, level numberOfLevels, bool parallel);
 	/**
 	 * Builds the overlay vertices but does not set the OverlayVertex::entryExitPoint (as this is
 	 * still unknown). It does however reserve the memory needed to store this information, i.e.
@@ -195,6 +203,16 @@ private:
 	 * above)
 	 */
 	void buildCells(Graph &graph, level numberOfLevels, std::vector<bool> &exitFlagsArray);
+	/**
+	 * Parallel version of buildOverlayVertices(). The boundary edges are counted per chunk of vertices
+	 * so that every overlay vertex is written to the same position as in the serial version.
+	 */
+	std::vector<bool> parallelBuildOverlayVertices(Graph &graph, level numberOfLevels);
+	/**
+	 * Parallel version of buildCells(). Cells are inserted into the cell mapping in the same order
+	 * as in the serial version, so both produce the same offsets.
+	 */
+	void parallelBuildCells(Graph &graph, level numberOfLevels, std::vector<bool> &exitFlagsArray);
 };
 
 template<typename L>
@@ -219,16 +237,17 @@ void OverlayGraph::forOutNeighborsOf(index u, level l, L handle) const {
 }
 
 template<typename L>
-void OverlayGraph::forInNeighborsOf(index v, level l, L handle) const {
+void OverlayGraph::forInNeighborsOf(index v, level l, bool transposed, L handle) const {
 	const OverlayVertex& vertex = getVertex(v);
 	assert(0 < l && l <= vertex.entryExitPoint.size());
 	index exitPoint = vertex.entryExitPoint[l - 1];
 	const Cell& cell = getCell(vertex.cellNumber, l);
-	index weightOffset = cell.cellOffset + exitPoint;
+	index weightOffset = cell.cellOffset + (transposed ? exitPoint * cell.numEntryPoints : exitPoint);
+	const count stride = transposed ? 1 : cell.numExitPoints;
 	index overlayIdOffset = cell.overlayIdOffset;
 	for (index i = 0; i < cell.numEntryPoints; ++i) {
 		assert(overlayIdOffset+i < overlayIdMapping.size());
-		handle(overlayIdMapping[overlayIdOffset + i], weightOffset + cell.numExitPoints * i);
+		handle(overlayIdMapping[overlayIdOffset + i], weightOffset + stride * i);
 	}
 }
 
@@ -31,21 +31,55 @@
 
 namespace CRP {
 
-OverlayWeights::OverlayWeights(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction)
+OverlayWeights::OverlayWeights(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats,
+		QUEUE_TYPE queueType)
 	: weights(overlayGraph.getWeightVectorSize(), inf_weight)
 {
-	build(graph, overlayGraph, costFunction);
+	switch (queueType) {
+		case BINARY_HEAP:
+			build<BinaryIDQueue>(graph, overlayGraph, costFunction, stats);
+			break;
+		case OCTARY_HEAP:
+			build<OctaryIDQueue>(graph, overlayGraph, costFunction, stats);
+			break;
+		case RADIX_HEAP:
+			build<RadixIDQueue>(graph, overlayGraph, costFunction, stats);
+			break;
+		default:
+			build<MinIDQueue>(graph, overlayGraph, costFunction, stats);
+			break;
+	}
+}
+
+void OverlayWeights::buildTransposedWeights(const OverlayGraph& overlayGraph) {
+	transposedWeights.assign(weights.size(), inf_weight);
+	for (level l = 1; l <= overlayGraph.getLevelInfo().getLevelCount(); ++l) {
+		overlayGraph.parallelForCells(l, [&](const Cell& cell, const pv) {
+			for (index i = 0; i < cell.numEntryPoints; ++i) {
+				for (index j = 0; j < cell.numExitPoints; ++j) {
+					transposedWeights[cell.cellOffset + j * cell.numEntryPoints + i] = weights[cell.cellOffset + i * cell.numExitPoints + j];
+				}
+			}
+		});
+	}
 }
 
-void OverlayWeights::build(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction) {
-	buildLowestLevel(graph, overlayGraph, costFunction);
+template<template<class> class Queue>
+void OverlayWeights::build(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats) {
+	if (stats != nullptr) stats->beginLevel(1);
+	buildLowestLevel<Queue>(graph, overlayGraph, costFunction, stats);
+	if (stats != nullptr) stats->endLevel(1);
+
 	const LevelInfo& levelInfo = overlayGraph.getLevelInfo();
 	for (level l = 2; l <= levelInfo.getLevelCount(); ++l) {
-		buildLevel(graph, overlayGraph, costFunction, l);
+		if (stats != nullptr) stats->beginLevel(l);
+		buildLevel<Queue>(graph, overlayGraph, costFunction, l, stats);
+		if (stats != nullptr) stats->endLevel(l);
 	}
 }
 
-void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction) {
+template<template<class> class Queue>
+void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats) {
 	// The weight of an edge to an exit point is always inf_weight if the boundary arc from the exit
 	// point to a neighboring cell has inf_weight. Conceptually this should not be the case. The result,
 	// however, is still correct since all paths that use the overlay edge to this exit point also contain the
@@ -58,12 +92,15 @@ void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& ov
 	index maxNumThreads = omp_get_max_threads();
 
 	std::vector<std::vector<weight>> dist(maxNumThreads, std::vector<weight>(graph.getMaxEdgesInCell(), inf_weight));
-	std::vector<MinIDQueue<IDKeyTriple>> queue(maxNumThreads, MinIDQueue<IDKeyTriple>(graph.getMaxEdgesInCell()));
+	std::vector<Queue<IDKeyTriple>> queue(maxNumThreads, Queue<IDKeyTriple>(graph.getMaxEdgesInCell()));
 	std::vector<std::vector<index>> round(maxNumThreads, std::vector<index>(graph.getMaxEdgesInCell(), 0));
 	std::vector<index> currentRound(maxNumThreads, 0);
 
 	overlayGraph.parallelForCells(1, [&](const Cell& cell, const pv cellNumber) {
 		index threadId = omp_get_thread_num();
+		const long long cellStart = (stats != nullptr) ? stats->now() : 0;
+		count pops = 0;
+		count scannedArcs = 0;
 		for (index i = 0; i < cell.numEntryPoints; ++i) {
 			index startOverlay = overlayGraph.getEntryPoint(cell, i);
 			const OverlayVertex& overlayVertex = overlayGraph.getVertex(startOverlay);
@@ -82,6 +119,7 @@ void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& ov
 
 			while (!queue[threadId].empty()) {
 				auto minTriple = queue[threadId].pop();
+				++pops;
 				index uId = minTriple.id;
 				index u = minTriple.vertexId;
 				assert(uId < graph.getMaxEdgesInCell());
@@ -92,6 +130,7 @@ void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& ov
 
 				graph.forOutEdgesOf(u, graph.getEntryOrder(u, uId + forwardCellOffset),
 						[&](const ForwardEdge& edge, index exitPoint, Graph::TURN_TYPE turnType) {
+					++scannedArcs;
 					index v = edge.head;
 					weight exitPointDist = minTriple.key + costFunction.getTurnCosts(turnType);
 					weight newDist = exitPointDist + costFunction.getWeight(edge.attributes);
@@ -124,10 +163,15 @@ void OverlayWeights::buildLowestLevel(const Graph& graph, const OverlayGraph& ov
 			}
 
 		}
+
+		if (stats != nullptr) {
+			stats->addCell({1, cellNumber, cell.numEntryPoints, cell.numExitPoints, threadId, cellStart, stats->now(), pops, scannedArcs});
+		}
 	});
 }
 
-void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, level l) {
+template<template<class> class Queue>
+void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, level l, CustomizationStats* stats) {
 	assert(1 < l && l <= overlayGraph.getLevelInfo().getLevelCount());
 
 	const LevelInfo& levelInfo = overlayGraph.getLevelInfo();
@@ -136,12 +180,15 @@ void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayG
 	index maxNumThreads = omp_get_max_threads();
 
 	std::vector<std::vector<weight>> dist(maxNumThreads, std::vector<weight>(numberOfOverlayVertices, inf_weight));
-	std::vector<MinIDQueue<IDKeyPair>> queue(maxNumThreads, MinIDQueue<IDKeyPair>(numberOfOverlayVertices));
+	std::vector<Queue<IDKeyPair>> queue(maxNumThreads, Queue<IDKeyPair>(numberOfOverlayVertices));
 	std::vector<std::vector<index>> round(maxNumThreads, std::vector<index>(numberOfOverlayVertices, 0));
 	std::vector<index> currentRound(maxNumThreads, 0);
 
 	overlayGraph.parallelForCells(l, [&](const Cell& cell, const pv truncatedCellNumber) {
 		index threadId = omp_get_thread_num();
+		const long long cellStart = (stats != nullptr) ? stats->now() : 0;
+		count pops = 0;
+		count scannedArcs = 0;
 
 		for (index i = 0; i < cell.numEntryPoints; ++i) {
 			index start = overlayGraph.getEntryPoint(cell, i);
@@ -153,11 +200,13 @@ void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayG
 
 			while (!queue[threadId].empty()) {
 				auto minPair = queue[threadId].pop();
+				++pops;
 				index entry = minPair.id;
 				assert(dist[threadId][entry] == minPair.key);
 				assert(levelInfo.truncateToLevel(overlayGraph.getVertex(entry).cellNumber, l) == truncatedCellNumber);
 
 				overlayGraph.forOutNeighborsOf(entry, l - 1, [&](index exit, index w) {
+					++scannedArcs;
 					weight newDist = minPair.key + weights[w];
 					if (newDist >= inf_weight) return;
 					if (round[threadId][exit] == currentRound[threadId] && newDist >= dist[threadId][exit]) return;
@@ -175,6 +224,7 @@ void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayG
 					if (levelInfo.truncateToLevel(neighborVertex.cellNumber, l) != truncatedCellNumber) return;
 
 					weight edgeWeight = costFunction.getWeight(graph.getForwardEdge(exitVertex.originalEdge).attributes);
+					if (edgeWeight >= inf_weight) return;	// e.g. edges that are closed for the vehicle
 					dist[threadId][neighbor] = newDist + edgeWeight;
 					if (queue[threadId].contains_id(neighbor)) {
 						queue[threadId].decrease_key({neighbor, newDist + edgeWeight});
@@ -194,6 +244,10 @@ void OverlayWeights::buildLevel(const Graph& graph, const OverlayGraph& overlayG
 			}
 
 		}
+
+		if (stats != nullptr) {
+			stats->addCell({l, truncatedCellNumber, cell.numEntryPoints, cell.numExitPoints, threadId, cellStart, stats->now(), pops, scannedArcs});
+		}
 	});
 }
 
@@ -34,6 +34,8 @@
 #include "../constants.h"
 #include "Graph.h"
 #include "OverlayGraph.h"
+#include "CustomizationStats.h"
+#include "id_queue.h"
 #include "../metrics/CostFunction.h"
 
 
@@ -43,13 +45,33 @@ class OverlayWeights {
 public:
 	OverlayWeights() = default;
 	OverlayWeights(const std::vector<weight>& weights) : weights(weights) {}
-	OverlayWeights(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction);
+	/**
+	 * Computes the weights of all cells for @a costFunction.
+	 * @param graph
+	 * @param overlayGraph
+	 * @param costFunction
+	 * @param stats if given, per-level and per-cell measurements are recorded in @a stats
+	 * @param queueType the priority queue of the searches inside the cells
+	 */
+	OverlayWeights(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats = nullptr,
+			QUEUE_TYPE queueType = QUATERNARY_HEAP);
 
 	inline weight getWeight(index i) const {
 		assert(i < weights.size());
 		return weights[i];
 	}
 
+	/**
+	 * Returns a weight of the transposed cell matrices. They contain the same weights as the cell matrices but column
+	 * by column, i.e. the weight from entry point i to exit point j of a cell is at cellOffset + j * numEntryPoints + i.
+	 * They only exist after buildTransposedWeights.
+	 * @param i
+	 */
+	inline weight getTransposedWeight(index i) const {
+		assert(i < transposedWeights.size());
+		return transposedWeights[i];
+	}
+
 	inline weight operator[](index i) const {
 		assert(i < weights.size());
 		return weights[i];
@@ -59,12 +81,27 @@ public:
 		return weights;
 	}
 
+	/**
+	 * Builds the transposed cell matrices for the backward overlay search of the queries. They need as much memory
+	 * as the weights, so customization does not build them.
+	 * @param overlayGraph the overlay graph the weights were computed for
+	 */
+	void buildTransposedWeights(const OverlayGraph& overlayGraph);
+
+	inline bool hasTransposedWeights() const {
+		return !transposedWeights.empty();
+	}
+
 private:
 	std::vector<weight> weights;
+	std::vector<weight> transposedWeights;
 
-	void build(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction);
-	void buildLowestLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction);
-	void buildLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, level l);
+	template<template<class> class Queue>
+	void build(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats);
+	template<template<class> class Queue>
+	void buildLowestLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, CustomizationStats* stats);
+	template<template<class> class Queue>
+	void buildLevel(const Graph& graph, const OverlayGraph& overlayGraph, const CostFunction& costFunction, level l, CustomizationStats* stats);
 };
 
 }
@@ -0,0 +1,128 @@
+/*
+ * QueryLog.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "QueryLog.h"
+#include "../timer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace CRP {
+
+static const char magic[] = {'C', 'R', 'P', 'Q', 'L', 'O', 'G', '1'};
+static const size_t recordSize = sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint8_t);
+
+template<typename T>
+static inline void writeValue(char *&buffer, T value) {
+	std::memcpy(buffer, &value, sizeof(T));
+	buffer += sizeof(T);
+}
+
+template<typename T>
+static inline T readValue(const char *&buffer) {
+	T value;
+	std::memcpy(&value, buffer, sizeof(T));
+	buffer += sizeof(T);
+	return value;
+}
+
+void QueryLog::add(const LoggedQuery &query) {
+	assert(queries.empty() || queries.back().arrivalTime <= query.arrivalTime);
+	queries.push_back(query);
+}
+
+void QueryLog::record(index sourceEdge, index targetEdge, index metricId, OUTPUT_MODE outputMode) {
+	std::lock_guard<std::mutex> lock(recordMutex);
+	const long long now = get_micro_time();
+	if (recordStart < 0) recordStart = now;
+	// the clock may be set back, arrival times must not decrease anyway
+	const long long arrivalTime = std::max(now - recordStart, getDuration());
+	queries.push_back({arrivalTime, sourceEdge, targetEdge, metricId, outputMode});
+}
+
+bool QueryLog::write(const std::string &outputFileName) const {
+	std::ofstream file(outputFileName, std::ios::binary);
+	if (!file.is_open()) return false;
+
+	std::vector<char> buffer(sizeof(magic) + sizeof(uint64_t) + queries.size() * recordSize);
+	char *pos = buffer.data();
+	std::memcpy(pos, magic, sizeof(magic));
+	pos += sizeof(magic);
+	writeValue<uint64_t>(pos, queries.size());
+	for (const LoggedQuery &query : queries) {
+		assert(query.metricId <= UINT16_MAX);
+		writeValue<uint64_t>(pos, query.arrivalTime);
+		writeValue<uint32_t>(pos, query.sourceEdge);
+		writeValue<uint32_t>(pos, query.targetEdge);
+		writeValue<uint16_t>(pos, query.metricId);
+		writeValue<uint8_t>(pos, query.outputMode);
+	}
+
+	file.write(buffer.data(), buffer.size());
+	return file.good();
+}
+
+bool QueryLog::read(const std::string &inputFileName) {
+	std::ifstream file(inputFileName, std::ios::binary);
+	if (!file.is_open()) return false;
+
+	file.seekg(0, std::ios::end);
+	const size_t fileSize = file.tellg();
+	file.seekg(0, std::ios::beg);
+	if (fileSize < sizeof(magic) + sizeof(uint64_t)) return false;
+
+	std::vector<char> buffer(fileSize);
+	file.read(buffer.data(), fileSize);
+	if (!file.good() || std::memcmp(buffer.data(), magic, sizeof(magic)) != 0) return false;
+
+	const char *pos = buffer.data() + sizeof(magic);
+	const uint64_t numQueries = readValue<uint64_t>(pos);
+	if (fileSize != sizeof(magic) + sizeof(uint64_t) + numQueries * recordSize) return false;
+
+	queries.clear();
+	queries.reserve(numQueries);
+	for (uint64_t i = 0; i < numQueries; ++i) {
+		LoggedQuery query;
+		query.arrivalTime = readValue<uint64_t>(pos);
+		query.sourceEdge = readValue<uint32_t>(pos);
+		query.targetEdge = readValue<uint32_t>(pos);
+		query.metricId = readValue<uint16_t>(pos);
+		const uint8_t outputMode = readValue<uint8_t>(pos);
+		if (outputMode > PATH || (!queries.empty() && query.arrivalTime < queries.back().arrivalTime)) {
+			queries.clear();
+			return false;
+		}
+		query.outputMode = static_cast<OUTPUT_MODE>(outputMode);
+		queries.push_back(query);
+	}
+
+	return true;
+}
+
+} /* namespace CRP */
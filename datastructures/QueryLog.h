@@ -0,0 +1,105 @@
+/*
+ * QueryLog.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DATASTRUCTURES_QUERYLOG_H_
+#define DATASTRUCTURES_QUERYLOG_H_
+
+#include <cassert>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+
+namespace CRP {
+
+/**
+ * A sequence of queries with their arrival times, so that recorded traffic can be replayed. Queries are given by
+ * edges as in Query::edgeQuery, i.e. a forward edge to start on and a backward edge to end on. Edge ids refer to the
+ * graph after precalculation, a log only fits the graph it was recorded on.
+ *
+ * The binary file starts with the 8 bytes "CRPQLOG1" and the number of queries as uint64, followed by one record of
+ * 19 bytes per query: the arrival time as uint64, source and target edge as uint32, the metric id as uint16 and the
+ * output mode as uint8. Like the weight files, numbers are stored in the byte order of the machine.
+ */
+class QueryLog {
+public:
+	enum OUTPUT_MODE : uint8_t {WEIGHT_ONLY, PATH};
+
+	struct LoggedQuery {
+		long long arrivalTime;	// microseconds since the first query
+		index sourceEdge;
+		index targetEdge;
+		index metricId;
+		OUTPUT_MODE outputMode;
+	};
+
+	QueryLog() = default;
+
+	/**
+	 * Appends @a query. Arrival times must not decrease.
+	 * @param query
+	 */
+	void add(const LoggedQuery &query);
+
+	/**
+	 * Appends a query that arrives now. The first recorded query arrives at time 0. Can be called by several
+	 * threads at once.
+	 */
+	void record(index sourceEdge, index targetEdge, index metricId, OUTPUT_MODE outputMode);
+
+	inline count size() const {
+		return queries.size();
+	}
+
+	inline const LoggedQuery& getQuery(index i) const {
+		assert(i < queries.size());
+		return queries[i];
+	}
+
+	/** Returns the arrival time of the last query in microseconds. */
+	inline long long getDuration() const {
+		return queries.empty() ? 0 : queries.back().arrivalTime;
+	}
+
+	bool write(const std::string &outputFileName) const;
+
+	/**
+	 * Replaces the queries of this log with the ones in @a inputFileName.
+	 * @return false if the file cannot be read or is no valid query log
+	 */
+	bool read(const std::string &inputFileName);
+
+private:
+	std::vector<LoggedQuery> queries;
+	std::mutex recordMutex;
+	long long recordStart = -1;
+};
+
+} /* namespace CRP */
+
+#endif /* DATASTRUCTURES_QUERYLOG_H_ */
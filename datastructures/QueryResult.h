@@ -28,10 +28,76 @@
 #ifndef DATASTRUCTURES_QUERYRESULT_H_
 #define DATASTRUCTURES_QUERYRESULT_H_
 
+#include "../constants.h"
+
 #include <vector>
 
+/*
+ * QUERY_STATS(statement) executes statement only if the code is compiled with QUERYSTATS, so that counting costs
+ * nothing otherwise.
+ */
+#ifdef QUERYSTATS
+#define QUERY_STATS(...) __VA_ARGS__
+#else
+#define QUERY_STATS(...)
+#endif
+
 namespace CRP {
 
+/**
+ * Counters of a query, filled in by the query algorithms if compiled with QUERYSTATS.
+ */
+struct QueryStats {
+	count settledGraphVertices = 0;
+	std::vector<count> settledOverlayVertices; // indexed by query level, entry 0 is unused
+	count relaxedEdges = 0;
+	count stalledLabels = 0;
+	count queuePushes = 0;
+	count decreaseKeys = 0;
+	count meetingPointUpdates = 0;
+	long long searchTime = 0; // microseconds
+	long long unpackTime = 0; // microseconds
+
+	inline void countSettledOverlayVertex(level queryLevel) {
+		if (settledOverlayVertices.size() <= queryLevel) settledOverlayVertices.resize(queryLevel + 1, 0);
+		++settledOverlayVertices[queryLevel];
+	}
+
+	/** Counts a pushOrDecrease of @a id into @a queue, call it before the operation. */
+	template<typename Queue>
+	inline void countQueueOperation(Queue &queue, index id) {
+		if (queue.contains_id(id)) {
+			++decreaseKeys;
+		} else {
+			++queuePushes;
+		}
+	}
+
+	count getSettledOverlayVertices() const {
+		count sum = 0;
+		for (count settled : settledOverlayVertices) sum += settled;
+		return sum;
+	}
+
+	QueryStats& operator+=(const QueryStats &other) {
+		settledGraphVertices += other.settledGraphVertices;
+		if (settledOverlayVertices.size() < other.settledOverlayVertices.size()) {
+			settledOverlayVertices.resize(other.settledOverlayVertices.size(), 0);
+		}
+		for (level l = 0; l < other.settledOverlayVertices.size(); ++l) {
+			settledOverlayVertices[l] += other.settledOverlayVertices[l];
+		}
+		relaxedEdges += other.relaxedEdges;
+		stalledLabels += other.stalledLabels;
+		queuePushes += other.queuePushes;
+		decreaseKeys += other.decreaseKeys;
+		meetingPointUpdates += other.meetingPointUpdates;
+		searchTime += other.searchTime;
+		unpackTime += other.unpackTime;
+		return *this;
+	}
+};
+
 class QueryResult {
 public:
 	QueryResult() = default;
@@ -39,6 +105,10 @@ public:
 
 	std::vector<index> path;
 	weight pathWeight;
+
+#ifdef QUERYSTATS
+	QueryStats stats;
+#endif
 };
 
 } /* namespace CRP */
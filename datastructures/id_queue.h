@@ -31,6 +31,7 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <string>
 
 namespace CRP {
 
@@ -47,15 +48,13 @@ struct IDKeyTriple{
 
 
 //! A priority queue where the elements are IDs from 0 to id_count-1 where id_count is a number that is set in the constructor.
-//! The elements are sorted by integer keys.
-template<class IDType>
-class MinIDQueue{
-private:
-	static const unsigned tree_arity = 4;
+//! The elements are sorted by integer keys. The queue is a heap in which every node has tree_arity children.
+template<class IDType, unsigned tree_arity>
+class KaryIDQueue{
 public:
-	MinIDQueue():heap_size(0){}
+	KaryIDQueue():heap_size(0){}
 
-	explicit MinIDQueue(unsigned id_count):
+	explicit KaryIDQueue(unsigned id_count):
 		id_pos(id_count, invalid_id), 
 		heap(id_count), 
 		heap_size(0){}
@@ -88,7 +87,7 @@ public:
 		heap_size = 0;
 	}
 
-	friend void swap(MinIDQueue&l, MinIDQueue&r){
+	friend void swap(KaryIDQueue&l, KaryIDQueue&r){
 		using std::swap;
 		swap(l.id_pos, r.id_pos);
 		swap(l.heap, r.heap);
@@ -230,6 +229,243 @@ private:
 	unsigned heap_size;
 };
 
+template<class IDType> using BinaryIDQueue = KaryIDQueue<IDType, 2>;
+template<class IDType> using MinIDQueue = KaryIDQueue<IDType, 4>;
+template<class IDType> using OctaryIDQueue = KaryIDQueue<IDType, 8>;
+
+//! A radix heap with the same interface as KaryIDQueue. It only supports monotone use: a pushed or decreased key must not
+//! be smaller than the key of the element popped last, which holds for Dijkstra's algorithm with non-negative weights.
+//! An element is kept in the bucket given by the highest bit in which its key differs from the last popped key. A pop
+//! that finds bucket 0 empty redistributes the first non-empty bucket, so every element moves down at most once per bit.
+template<class IDType>
+class RadixIDQueue{
+private:
+	static const unsigned num_buckets = 8 * sizeof(weight) + 1;
+	static const unsigned char not_contained = 255;
+public:
+	RadixIDQueue():queue_size(0), last_key(0), min_id(invalid_id){}
+
+	explicit RadixIDQueue(unsigned id_count):
+		id_bucket(id_count, (unsigned char) not_contained),
+		id_pos(id_count),
+		buckets(num_buckets),
+		queue_size(0),
+		last_key(0),
+		min_id(invalid_id){}
+
+	//! Returns whether the queue is empty. Equivalent to checking whether size() returns 0.
+	bool empty()const{
+		return queue_size == 0;
+	}
+
+	//! Returns the number of elements in the queue.
+	unsigned size()const{
+		return queue_size;
+	}
+
+	//! Returns the id_count value passed to the constructor.
+	unsigned id_count()const{
+		return id_pos.size();
+	}
+
+	//! Checks whether an element is in the queue.
+	bool contains_id(unsigned id){
+		assert(id < id_count());
+		return id_bucket[id] != not_contained;
+	}
+
+	//! Removes all elements from the queue.
+	void clear(){
+		for(std::vector<IDType>&bucket : buckets){
+			for(const IDType&p : bucket)
+				id_bucket[p.id] = not_contained;
+			bucket.clear();
+		}
+		queue_size = 0;
+		last_key = 0;
+		min_id = invalid_id;
+	}
+
+	//! Returns the current key of an element.
+	//! Undefined if the element is not part of the queue.
+	weight get_key(unsigned id)const{
+		assert(id < id_count());
+		assert(id_bucket[id] != not_contained);
+		return buckets[id_bucket[id]][id_pos[id]].key;
+	}
+
+	//! Returns the smallest element key pair without removing it from the queue.
+	IDType peek()const{
+		assert(!empty());
+		return buckets[id_bucket[min_id]][id_pos[min_id]];
+	}
+
+	/**
+	 * @return The peek key of this queue. If the queue is empty, it returns inf_weight.
+	 */
+	weight peekKey() const {
+		if (!empty()) {
+			return buckets[id_bucket[min_id]][id_pos[min_id]].key;
+		}
+		return inf_weight;
+	}
+
+	//! Returns the smallest element key pair and removes it form the queue.
+	IDType pop(){
+		assert(!empty());
+		if(buckets[0].empty()){
+			unsigned b = 1;
+			while(buckets[b].empty())
+				++b;
+			last_key = peekKey();
+			std::vector<IDType> redistributed;
+			redistributed.swap(buckets[b]);
+			for(const IDType&p : redistributed)
+				insert(p);
+			// give the storage back so that the bucket does not have to grow again
+			redistributed.clear();
+			buckets[b].swap(redistributed);
+		}
+
+		IDType p = buckets[0].back();
+		remove(p.id);
+		--queue_size;
+		update_min();
+		return p;
+	}
+
+	//! Inserts a element key pair.
+	//! Undefined if the element is part of the queue or if its key is smaller than the last popped key.
+	void push(IDType p){
+		assert(p.id < id_count());
+		assert(!contains_id(p.id));
+
+		if(empty() && p.key < last_key)
+			last_key = p.key; // any key is fine for an empty queue
+		assert(p.key >= last_key);
+		insert(p);
+		++queue_size;
+		if(min_id == invalid_id || p.key < peekKey())
+			min_id = p.id;
+	}
+
+	void pushOrDecrease(IDType p) {
+		assert(p.id < id_count());
+
+		if (!contains_id(p.id)) {
+			push(p);
+		} else {
+			decrease_key(p);
+		}
+	}
+
+	//! Updates the key of an element if the new key is smaller than the old key.
+	//! Does nothing if the new key is larger.
+	//! Undefined if the element is not part of the queue.
+	bool decrease_key(IDType p){
+		assert(p.id < id_count());
+		assert(contains_id(p.id));
+		assert(p.key >= last_key);
+
+		if(get_key(p.id) > p.key){
+			remove(p.id);
+			insert(p);
+			if(p.key < peekKey())
+				min_id = p.id;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	//! Updates the key of an element if the new key is larger than the old key.
+	//! Does nothing if the new key is smaller.
+	//! Undefined if the element is not part of the queue.
+	bool increase_key(IDType p){
+		assert(p.id < id_count());
+		assert(contains_id(p.id));
+
+		if(get_key(p.id) < p.key){
+			remove(p.id);
+			insert(p);
+			if(p.id == min_id)
+				update_min();
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+private:
+	unsigned bucket_of(weight key)const{
+		return key == last_key ? 0 : 8 * sizeof(unsigned) - __builtin_clz(key ^ last_key);
+	}
+
+	void insert(IDType p){
+		const unsigned b = bucket_of(p.key);
+		id_bucket[p.id] = b;
+		id_pos[p.id] = buckets[b].size();
+		buckets[b].push_back(p);
+	}
+
+	void remove(unsigned id){
+		std::vector<IDType>&bucket = buckets[id_bucket[id]];
+		const unsigned pos = id_pos[id];
+		bucket[pos] = bucket.back();
+		id_pos[bucket[pos].id] = pos;
+		bucket.pop_back();
+		id_bucket[id] = not_contained;
+	}
+
+	// the smallest key is in the first non-empty bucket
+	void update_min(){
+		min_id = invalid_id;
+		if(empty())
+			return;
+		unsigned b = 0;
+		while(buckets[b].empty())
+			++b;
+		const IDType*min = &buckets[b].back();
+		if(b != 0){
+			for(const IDType&p : buckets[b]){
+				if(p.key < min->key)
+					min = &p;
+			}
+		}
+		min_id = min->id;
+	}
+
+	std::vector<unsigned char>id_bucket;
+	std::vector<unsigned>id_pos;
+	std::vector<std::vector<IDType>>buckets;
+
+	unsigned queue_size;
+	weight last_key;
+	unsigned min_id;
+};
+
+/** Selects one of the queues above where the queue is chosen at runtime, e.g. for the customization. */
+enum QUEUE_TYPE {BINARY_HEAP, QUATERNARY_HEAP, OCTARY_HEAP, RADIX_HEAP};
+
+/**
+ * Parses the names "heap2", "heap4", "heap8" and "radix".
+ * @return whether @a name is a known queue type
+ */
+inline bool parseQueueType(const std::string &name, QUEUE_TYPE &type) {
+	if (name == "heap2") {
+		type = BINARY_HEAP;
+	} else if (name == "heap4") {
+		type = QUATERNARY_HEAP;
+	} else if (name == "heap8") {
+		type = OCTARY_HEAP;
+	} else if (name == "radix") {
+		type = RADIX_HEAP;
+	} else {
+		return false;
+	}
+	return true;
+}
+
 }
 
 
@@ -0,0 +1,25 @@
+# Speed profile that reproduces the built-in time metric.
+# Speeds in km/h are used for edges without a maxspeed tag.
+speed motorway 100
+speed trunk 85
+speed primary 70
+speed secondary 60
+speed tertiary 50
+speed unclassified 40
+speed residential 20
+speed service 5
+speed motorway_link 60
+speed trunk_link 60
+speed primary_link 55
+speed secondary_link 50
+speed tertiary_link 40
+speed living_street 5
+speed road 50
+default_speed 30
+
+# Turn costs in seconds. Turns into a no entry restriction are always forbidden.
+turn left 0
+turn right 0
+turn straight 0
+turn none 0
+turn u_turn inf
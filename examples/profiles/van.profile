@@ -0,0 +1,30 @@
+# Delivery van: slower on fast roads, penalizes left turns and avoids service roads.
+speed motorway 90
+speed trunk 80
+speed primary 65
+speed secondary 55
+speed tertiary 45
+speed unclassified 35
+speed residential 20
+speed service 0
+speed motorway_link 50
+speed trunk_link 50
+speed primary_link 45
+speed secondary_link 40
+speed tertiary_link 35
+speed living_street 5
+speed road 40
+default_speed 25
+
+# Posted speeds are rarely reached in urban areas.
+speed_class 50 0.8
+speed_class 90 0.9
+speed_class 255 0.95
+
+turn left 15
+turn right 5
+turn straight 0
+turn none 0
+turn u_turn inf
+
+max_height 3.0
@@ -0,0 +1,95 @@
+/*
+ * Generator.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+#include "../io/GraphIO.h"
+#include "SyntheticGraph.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+	const string type = argc > 1 ? argv[1] : "";
+	const int numArguments = type == "grid" ? 6 : type == "geometric" ? 7 : 0;
+	if (numArguments == 0 || argc < numArguments) {
+		cout << "Usage: " << argv[0] << " grid width height cell_sizes output_name [options]" << endl;
+		cout << "       " << argv[0] << " geometric num_vertices min_degree max_degree cell_sizes output_name [options]" << endl;
+		cout << "Generates a synthetic road graph and a matching partition and writes them to output_name.graph.bz2 and output_name.mlp." << endl;
+		cout << "cell_sizes is a comma separated list of increasing maximum cell sizes, starting with the lowest level." << endl;
+		cout << "Options: --seed=N, --oneway=P (probability of one-way streets), --restrictions=P (probability of forbidden turns)" << endl;
+		return 1;
+	}
+
+	uint32_t seed = 42;
+	float onewayProbability = 0.1f;
+	float restrictionProbability = 0.02f;
+	for (int i = numArguments; i < argc; ++i) {
+		const string arg(argv[i]);
+		if (arg.compare(0, 7, "--seed=") == 0) {
+			seed = stoul(arg.substr(7));
+		} else if (arg.compare(0, 9, "--oneway=") == 0) {
+			onewayProbability = stof(arg.substr(9));
+		} else if (arg.compare(0, 15, "--restrictions=") == 0) {
+			restrictionProbability = stof(arg.substr(15));
+		} else {
+			cout << "unknown option " << arg << endl;
+			return 1;
+		}
+	}
+
+	vector<CRP::count> maxCellSizes;
+	if (!CRP::MultiLevelPartition::parseCellSizes(argv[numArguments - 2], maxCellSizes)) return 1;
+	const string outputName(argv[numArguments - 1]);
+
+	CRP::SyntheticGraph generator(seed, onewayProbability, restrictionProbability);
+	CRP::Graph graph;
+	bool ok;
+	if (type == "grid") {
+		ok = generator.generateGrid(graph, stoul(argv[2]), stoul(argv[3]));
+	} else {
+		ok = generator.generateGeometric(graph, stoul(argv[2]), stoul(argv[3]), stoul(argv[4]));
+	}
+	if (!ok) return 1;
+
+	cout << "Partitioning graph" << endl;
+	CRP::MultiLevelPartition mlp = CRP::SyntheticGraph::partition(graph, maxCellSizes);
+	if (mlp.getNumberOfVertices() != graph.numberOfVertices()) return 1;
+
+	cout << "Writing graph" << endl;
+	if (!CRP::GraphIO::writeGraph(graph, outputName + ".graph.bz2")) {
+		cout << "could not write " << outputName << ".graph.bz2" << endl;
+		return 1;
+	}
+	mlp.write(outputName + ".mlp");
+
+	cout << "Done" << endl;
+	return 0;
+}
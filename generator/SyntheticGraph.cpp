@@ -0,0 +1,404 @@
+/*
+ * SyntheticGraph.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SyntheticGraph.h"
+#include "../algorithm/StronglyConnectedComponents.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include "omp.h"
+
+namespace CRP {
+
+// distance between neighboring intersections in meters and position of the generated graphs
+static const float spacing = 100.0f;
+static const float originLat = 49.0f;
+static const float originLon = 8.4f;
+static const double metersPerDegree = 111320.0;
+
+struct TurnTableHasher {
+	std::size_t operator()(const std::vector<Graph::TURN_TYPE>& turnTable) const {
+		std::size_t seed = 0;
+		for (Graph::TURN_TYPE turnType : turnTable) {
+			seed ^= turnType + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+};
+
+static inline Coordinate toCoordinate(double x, double y) {
+	const double metersPerDegreeLon = metersPerDegree * std::cos(originLat * M_PI / 180.0);
+	return {(float) (originLat + y / metersPerDegree), (float) (originLon + x / metersPerDegreeLon)};
+}
+
+// the categories of the streets of a grid, every 4th street is tertiary, every 16th secondary and so on
+static inline STREET_TYPE getGridStreetType(index i) {
+	if (i % 256 == 0) return MOTORWAY;
+	if (i % 64 == 0) return PRIMARY;
+	if (i % 16 == 0) return SECONDARY;
+	if (i % 4 == 0) return TERTIARY;
+	return RESIDENTIAL;
+}
+
+SyntheticGraph::SyntheticGraph(uint32_t seed, float onewayProbability, float restrictionProbability) : random(seed),
+		onewayProbability(onewayProbability), restrictionProbability(restrictionProbability) {
+}
+
+bool SyntheticGraph::generateGrid(Graph& graph, count width, count height) {
+	if (width < 2 || height < 2 || (uint64_t) width * height >= invalid_id) {
+		std::cout << "ERROR: invalid grid size " << width << "x" << height << std::endl;
+		return false;
+	}
+
+	std::uniform_real_distribution<float> jitter(-0.2f * spacing, 0.2f * spacing);
+	std::vector<Coordinate> coordinates(width * height);
+	for (index y = 0; y < height; ++y) {
+		for (index x = 0; x < width; ++x) {
+			coordinates[y * width + x] = toCoordinate(x * spacing + jitter(random), y * spacing + jitter(random));
+		}
+	}
+
+	std::vector<Street> streets;
+	streets.reserve(2 * (uint64_t) width * height);
+	for (index y = 0; y < height; ++y) {
+		for (index x = 0; x < width; ++x) {
+			const index u = y * width + x;
+			if (x + 1 < width) streets.push_back(createStreet(u, u + 1, coordinates, getGridStreetType(y)));
+			if (y + 1 < height) streets.push_back(createStreet(u, u + width, coordinates, getGridStreetType(x)));
+		}
+	}
+
+	buildGraph(graph, coordinates, streets);
+	return true;
+}
+
+bool SyntheticGraph::generateGeometric(Graph& graph, count numVertices, count minDegree, count maxDegree) {
+	if (numVertices < 2 || numVertices >= invalid_id || minDegree < 1 || maxDegree < minDegree || maxDegree > 16) {
+		std::cout << "ERROR: invalid parameters, we need at least 2 vertices and 1 <= minDegree <= maxDegree <= 16" << std::endl;
+		return false;
+	}
+
+	// as many buckets of spacing x spacing meters as vertices, so that a bucket contains one vertex on average
+	const index bucketsPerSide = std::ceil(std::sqrt((double) numVertices));
+	const double side = bucketsPerSide * spacing;
+	std::uniform_real_distribution<double> position(0, side);
+	std::uniform_int_distribution<count> degree(minDegree, maxDegree);
+	std::vector<double> xs(numVertices);
+	std::vector<double> ys(numVertices);
+	std::vector<count> numNeighbors(numVertices);
+	for (index v = 0; v < numVertices; ++v) {
+		xs[v] = position(random);
+		ys[v] = position(random);
+		numNeighbors[v] = std::min(degree(random), numVertices - 1);
+	}
+
+	auto getBucket = [&](double coordinate) {
+		return std::min((index) (coordinate / spacing), bucketsPerSide - 1);
+	};
+	std::vector<index> firstInBucket((uint64_t) bucketsPerSide * bucketsPerSide + 1, 0);
+	for (index v = 0; v < numVertices; ++v) {
+		firstInBucket[(uint64_t) getBucket(ys[v]) * bucketsPerSide + getBucket(xs[v]) + 1]++;
+	}
+	std::partial_sum(firstInBucket.begin(), firstInBucket.end(), firstInBucket.begin());
+	std::vector<index> bucketVertices(numVertices);
+	std::vector<index> nextInBucket(firstInBucket.begin(), firstInBucket.end() - 1);
+	for (index v = 0; v < numVertices; ++v) {
+		bucketVertices[nextInBucket[(uint64_t) getBucket(ys[v]) * bucketsPerSide + getBucket(xs[v])]++] = v;
+	}
+
+	// the k nearest neighbors of a vertex are searched in rings of buckets around its bucket until no unvisited
+	// bucket can contain a closer vertex
+	std::vector<std::pair<index, index>> pairs;
+#pragma omp parallel
+	{
+		std::vector<std::pair<index, index>> localPairs;
+		std::priority_queue<std::pair<double, index>> nearest;
+
+#pragma omp for schedule(dynamic, 1024)
+		for (index v = 0; v < numVertices; ++v) {
+			const long bx = getBucket(xs[v]);
+			const long by = getBucket(ys[v]);
+			for (long r = 0; r < bucketsPerSide; ++r) {
+				if (nearest.size() == numNeighbors[v] && (r - 1) * spacing >= std::sqrt(nearest.top().first)) break;
+				for (long y = by - r; y <= by + r; ++y) {
+					if (y < 0 || y >= bucketsPerSide) continue;
+					for (long x = bx - r; x <= bx + r; ++x) {
+						if (x < 0 || x >= bucketsPerSide) continue;
+						if (y != by - r && y != by + r && x != bx - r && x != bx + r) continue;	// only the ring
+						const uint64_t bucket = (uint64_t) y * bucketsPerSide + x;
+						for (index i = firstInBucket[bucket]; i < firstInBucket[bucket + 1]; ++i) {
+							const index u = bucketVertices[i];
+							if (u == v) continue;
+							const double dx = xs[u] - xs[v];
+							const double dy = ys[u] - ys[v];
+							nearest.push({dx * dx + dy * dy, u});
+							if (nearest.size() > numNeighbors[v]) nearest.pop();
+						}
+					}
+				}
+			}
+			while (!nearest.empty()) {
+				const index u = nearest.top().second;
+				localPairs.push_back({std::min(u, v), std::max(u, v)});
+				nearest.pop();
+			}
+		}
+
+#pragma omp critical
+		pairs.insert(pairs.end(), localPairs.begin(), localPairs.end());
+	}
+
+	// sorting makes the result independent of the number of threads
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+	std::vector<Coordinate> coordinates(numVertices);
+	for (index v = 0; v < numVertices; ++v) {
+		coordinates[v] = toCoordinate(xs[v], ys[v]);
+	}
+
+	// the degree of a vertex must fit into a turnorder
+	std::vector<count> degrees(numVertices, 0);
+	std::uniform_real_distribution<float> typeDistribution(0, 1);
+	std::vector<Street> streets;
+	streets.reserve(pairs.size());
+	for (const std::pair<index, index>& pair : pairs) {
+		if (degrees[pair.first] == 255 || degrees[pair.second] == 255) continue;
+		degrees[pair.first]++;
+		degrees[pair.second]++;
+
+		const float type = typeDistribution(random);
+		const STREET_TYPE streetType = type < 0.05f ? PRIMARY : type < 0.15f ? SECONDARY : type < 0.35f ? TERTIARY : RESIDENTIAL;
+		streets.push_back(createStreet(pair.first, pair.second, coordinates, streetType));
+	}
+
+	buildGraph(graph, coordinates, streets);
+	return true;
+}
+
+SyntheticGraph::Street SyntheticGraph::createStreet(index u, index v, const std::vector<Coordinate>& coordinates, STREET_TYPE type) {
+	std::uniform_real_distribution<float> probability(0, 1);
+
+	// most streets have no speed limit and use the default speed of their category, like in OSM
+	Speed speed = 0;
+	if (type == RESIDENTIAL && probability(random) < 0.3f) {
+		speed = 30;
+	} else if ((type == SECONDARY || type == PRIMARY) && probability(random) < 0.2f) {
+		speed = 70;
+	}
+
+	// a few height restrictions, e.g. for bridges, between 3.0 and 4.5 meters
+	float maxHeight = 0;
+	if (type != MOTORWAY && probability(random) < 0.01f) {
+		maxHeight = 3.0f + std::uniform_int_distribution<int>(0, 15)(random) / 10.0f;
+	}
+
+	bool oneway = false;
+	if ((type == RESIDENTIAL || type == TERTIARY) && probability(random) < onewayProbability) {
+		oneway = true;
+		if (probability(random) < 0.5f) std::swap(u, v);
+	}
+
+	const weight length = std::min(std::max((weight) std::round(getDistance(coordinates[u], coordinates[v])), (weight) 1), (weight) (1 << 20) - 1);
+	edgeAttr packedAttributes = length << 12;
+	packedAttributes |= ((edgeAttr) speed) << 4;
+	packedAttributes |= ((edgeAttr) type);
+
+	return {u, v, {packedAttributes, maxHeight}, oneway};
+}
+
+void SyntheticGraph::buildGraph(Graph& graph, const std::vector<Coordinate>& coordinates, const std::vector<Street>& streets) {
+	const count numVertices = coordinates.size();
+	std::vector<Vertex> vertices(numVertices + 1, {0, 0, 0, 0, {0, 0}});
+	for (const Street& street : streets) {
+		vertices[street.u + 1].firstOut++;
+		vertices[street.v + 1].firstIn++;
+		if (!street.oneway) {
+			vertices[street.v + 1].firstOut++;
+			vertices[street.u + 1].firstIn++;
+		}
+	}
+	for (index v = 0; v < numVertices; ++v) {
+		vertices[v + 1].firstOut += vertices[v].firstOut;
+		vertices[v + 1].firstIn += vertices[v].firstIn;
+		vertices[v].coord = coordinates[v];
+	}
+
+	std::vector<ForwardEdge> forwardEdges(vertices[numVertices].firstOut);
+	std::vector<BackwardEdge> backwardEdges(vertices[numVertices].firstIn);
+	std::vector<index> nextOut(numVertices);
+	std::vector<index> nextIn(numVertices);
+	for (index v = 0; v < numVertices; ++v) {
+		nextOut[v] = vertices[v].firstOut;
+		nextIn[v] = vertices[v].firstIn;
+	}
+	auto addEdge = [&](index u, index v, const EdgeAttributes& attributes) {
+		const index forward = nextOut[u]++;
+		const index backward = nextIn[v]++;
+		forwardEdges[forward] = {v, (turnorder) (backward - vertices[v].firstIn), attributes};
+		backwardEdges[backward] = {u, (turnorder) (forward - vertices[u].firstOut), attributes};
+	};
+	for (const Street& street : streets) {
+		addEdge(street.u, street.v, street.attributes);
+		if (!street.oneway) addEdge(street.v, street.u, street.attributes);
+	}
+
+	// U-turns are forbidden except at dead ends, every entry point keeps at least one allowed turn
+	std::uniform_real_distribution<float> probability(0, 1);
+	std::unordered_map<std::vector<Graph::TURN_TYPE>, index, TurnTableHasher> turnTableMap;
+	std::vector<Graph::TURN_TYPE> turnTables;
+	std::vector<Graph::TURN_TYPE> turnTable;
+	for (index v = 0; v < numVertices; ++v) {
+		const count inDegree = vertices[v + 1].firstIn - vertices[v].firstIn;
+		const count outDegree = vertices[v + 1].firstOut - vertices[v].firstOut;
+		const bool deadEnd = inDegree == 1 && outDegree == 1;
+		turnTable.assign(inDegree * outDegree, Graph::NONE);
+		for (index i = 0; i < inDegree; ++i) {
+			const index tail = backwardEdges[vertices[v].firstIn + i].tail;
+			count allowedTurns = 0;
+			for (index j = 0; j < outDegree; ++j) {
+				if (forwardEdges[vertices[v].firstOut + j].head == tail && !deadEnd) {
+					turnTable[i * outDegree + j] = Graph::U_TURN;
+				} else {
+					allowedTurns++;
+				}
+			}
+			for (index j = 0; j < outDegree; ++j) {
+				if (turnTable[i * outDegree + j] != Graph::NONE || forwardEdges[vertices[v].firstOut + j].head == tail) continue;
+				if (allowedTurns > 1 && probability(random) < restrictionProbability) {
+					turnTable[i * outDegree + j] = Graph::NO_ENTRY;
+					allowedTurns--;
+				}
+			}
+		}
+
+		auto it = turnTableMap.find(turnTable);
+		if (it != turnTableMap.end()) {
+			vertices[v].turnTablePtr = it->second;
+		} else {
+			vertices[v].turnTablePtr = turnTables.size();
+			turnTableMap.insert(std::make_pair(turnTable, (index) turnTables.size()));
+			turnTables.insert(turnTables.end(), turnTable.begin(), turnTable.end());
+		}
+	}
+	std::cout << "Generated " << numVertices << " vertices, " << forwardEdges.size() << " edges and " << turnTableMap.size() << " turn tables" << std::endl;
+
+	graph = Graph(vertices, forwardEdges, backwardEdges, turnTables);
+
+	StronglyConnectedComponents scc(graph);
+	scc.run();
+	const count numEdges = graph.numberOfEdges();
+	graph = scc.extractLargestComponent();
+	std::cout << "Found " << scc.getNumberOfComponents() << " strongly connected components, kept the largest one with "
+			<< graph.numberOfVertices() << " of " << numVertices << " vertices and " << graph.numberOfEdges() << " of " << numEdges << " edges" << std::endl;
+}
+
+// assigns the vertices order[begin, end) to cells of level l and below
+static void bisect(std::vector<index>& order, index begin, index end, level l, const std::vector<count>& maxCellSizes,
+		const std::vector<float>& xs, const std::vector<float>& ys, std::vector<std::vector<index>>& cellIds, std::vector<count>& numCells) {
+	if (end - begin <= maxCellSizes[l]) {
+		const index cell = numCells[l]++;
+		for (index i = begin; i < end; ++i) {
+			cellIds[l][order[i]] = cell;
+		}
+		if (l > 0) bisect(order, begin, end, l - 1, maxCellSizes, xs, ys, cellIds, numCells);
+		return;
+	}
+
+	float minX = xs[order[begin]], maxX = minX, minY = ys[order[begin]], maxY = minY;
+	for (index i = begin; i < end; ++i) {
+		minX = std::min(minX, xs[order[i]]);
+		maxX = std::max(maxX, xs[order[i]]);
+		minY = std::min(minY, ys[order[i]]);
+		maxY = std::max(maxY, ys[order[i]]);
+	}
+	const std::vector<float>& coordinates = maxX - minX >= maxY - minY ? xs : ys;
+
+	const index middle = begin + (end - begin) / 2;
+	std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](index u, index v) {
+		return coordinates[u] < coordinates[v] || (coordinates[u] == coordinates[v] && u < v);
+	});
+	bisect(order, begin, middle, l, maxCellSizes, xs, ys, cellIds, numCells);
+	bisect(order, middle, end, l, maxCellSizes, xs, ys, cellIds, numCells);
+}
+
+MultiLevelPartition SyntheticGraph::partition(const Graph& graph, const std::vector<count>& maxCellSizes) {
+	assert(!maxCellSizes.empty());
+	const count numVertices = graph.numberOfVertices();
+	const level numLevels = maxCellSizes.size();
+
+	// longitudes are scaled, so that both axes have about the same unit
+	const float lonScale = std::cos(originLat * M_PI / 180.0);
+	std::vector<float> xs(numVertices);
+	std::vector<float> ys(numVertices);
+	for (index v = 0; v < numVertices; ++v) {
+		xs[v] = graph.getCoordinate(v).lon * lonScale;
+		ys[v] = graph.getCoordinate(v).lat;
+	}
+
+	std::vector<index> order(numVertices);
+	std::iota(order.begin(), order.end(), 0);
+	std::vector<std::vector<index>> cellIds(numLevels, std::vector<index>(numVertices, 0));
+	std::vector<count> numCells(numLevels, 0);
+	bisect(order, 0, numVertices, numLevels - 1, maxCellSizes, xs, ys, cellIds, numCells);
+
+	MultiLevelPartition mlp;
+	mlp.setNumberOfLevels(numLevels);
+	mlp.setNumberOfVertices(numVertices);
+	for (level l = 0; l < numLevels; ++l) {
+		mlp.setNumberOfCellsInLevel(l, numCells[l]);
+		std::cout << "Level " << (int) l << ": " << numCells[l] << " cells" << std::endl;
+	}
+	if (!mlp.computeBitmap()) return MultiLevelPartition();
+	for (index v = 0; v < numVertices; ++v) {
+		for (level l = 0; l < numLevels; ++l) {
+			mlp.setCell(l, v, cellIds[l][v]);
+		}
+	}
+
+	return mlp;
+}
+
+float SyntheticGraph::getDistance(const Coordinate& u, const Coordinate& v) {
+	const int R = 6371000; // earth mean radius in meters
+	double phi1 = u.lat * M_PI / 180.0;
+	double phi2 = v.lat * M_PI / 180.0;
+	double dPhi = (v.lat - u.lat) * M_PI / 180.0;
+	double dLambda = (v.lon - u.lon) * M_PI / 180.0;
+
+	double a = sin(dPhi/2.0) * sin(dPhi/2.0) + cos(phi1)*cos(phi2)*sin(dLambda/2.0)*sin(dLambda/2.0);
+	double c = 2 * atan2(sqrt(a), sqrt(1.0-a));
+
+	return (float) R * c;
+}
+
+} /* namespace CRP */
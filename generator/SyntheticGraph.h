@@ -0,0 +1,101 @@
+/*
+ * SyntheticGraph.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GENERATOR_SYNTHETICGRAPH_H_
+#define GENERATOR_SYNTHETICGRAPH_H_
+
+#include <random>
+#include <vector>
+
+#include "../constants.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+
+namespace CRP {
+
+/**
+ * Generates road-like graphs of arbitrary size for benchmarks and tests: grids whose streets form a hierarchy of
+ * road categories, and random geometric graphs in which every vertex is connected to a random number of its nearest
+ * neighbors. Residential and tertiary streets are one-way with a given probability, and a given fraction of the
+ * turns at intersections is forbidden. U-turns are forbidden except at dead ends, like in the OSMParser. Only the
+ * largest strongly connected component is kept. The multi-level partition is computed by recursively bisecting the
+ * coordinates at the median, so it matches the generated graph and its cells are compact.
+ */
+class SyntheticGraph {
+public:
+	/**
+	 * @param seed seed of the random number generator; the same seed and parameters give the same graph
+	 * @param onewayProbability probability that a residential or tertiary street is one-way
+	 * @param restrictionProbability probability that a turn between two different streets is forbidden
+	 */
+	SyntheticGraph(uint32_t seed = 42, float onewayProbability = 0.1f, float restrictionProbability = 0.02f);
+
+	/**
+	 * Generates a grid of @a width x @a height intersections that are about 100 meters apart. Every 4th street is
+	 * tertiary, every 16th secondary, every 64th primary and every 256th a motorway, the remaining ones are
+	 * residential.
+	 * @return false if the parameters are invalid
+	 */
+	bool generateGrid(Graph& graph, count width, count height);
+
+	/**
+	 * Generates @a numVertices uniformly distributed intersections with the same density as the grid. Every vertex
+	 * is connected to its k nearest neighbors, where k is drawn uniformly from [@a minDegree, @a maxDegree].
+	 * @return false if the parameters are invalid
+	 */
+	bool generateGeometric(Graph& graph, count numVertices, count minDegree, count maxDegree);
+
+	/**
+	 * Partitions @a graph by its coordinates. Cells are bisected until they have at most the maximum cell size of
+	 * their level, starting at the highest level so that every cell is contained in a cell of the next higher level.
+	 * @param maxCellSizes the maximum number of vertices of a cell on each level, starting with the lowest level
+	 * @return the multi-level partition, or an empty one if its cell numbers do not fit into a pv
+	 */
+	static MultiLevelPartition partition(const Graph& graph, const std::vector<count>& maxCellSizes);
+
+private:
+	/** A street between two intersections, one-way streets lead from @a u to @a v. */
+	struct Street {
+		index u;
+		index v;
+		EdgeAttributes attributes;
+		bool oneway;
+	};
+
+	std::mt19937 random;
+	const float onewayProbability;
+	const float restrictionProbability;
+
+	Street createStreet(index u, index v, const std::vector<Coordinate>& coordinates, STREET_TYPE type);
+	void buildGraph(Graph& graph, const std::vector<Coordinate>& coordinates, const std::vector<Street>& streets);
+
+	static float getDistance(const Coordinate& u, const Coordinate& v);
+};
+
+} /* namespace CRP */
+
+#endif /* GENERATOR_SYNTHETICGRAPH_H_ */
@@ -43,6 +43,7 @@
 
 #include "../constants.h"
 #include "../datastructures/LevelInfo.h"
+#include "ParallelBzip2Streambuf.h"
 #include "vector_io.h"
 #include "OSMParser.h"
 
@@ -161,15 +162,13 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 	std::ifstream file(inputFilePath, std::ios_base::in | std::ios_base::binary);
 	if (!file.is_open()) return false;
 
-	boost::iostreams::filtering_streambuf<boost::iostreams::input> inbuf;
-	inbuf.push(boost::iostreams::bzip2_decompressor());
-	inbuf.push(file);
+	ParallelBzip2Streambuf inbuf(file);
 
 	std::string line;
 	std::istream instream(&inbuf);
 	std::vector<std::string> tokens;
 
-	if (file.eof()) return false;
+	if (instream.eof()) return false;
 	std::getline(instream, line);
 	tokens = splitString(line, ' ');
 	assert(tokens.size() == 4);
@@ -182,7 +181,7 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 
 	std::vector<Vertex> vertices(numVertices+1);
 	for (index i = 0; i < numVertices; ++i) {
-		if (file.eof()) return false;
+		if (instream.eof()) return false;
 		std::getline(instream, line);
 		tokens = splitString(line, ' ');
 		assert(tokens.size() == 6);
@@ -192,7 +191,7 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 
 	std::vector<ForwardEdge> forwardEdges(numEdges);
 	for (index i = 0; i < numEdges; ++i) {
-		if (file.eof()) return false;
+		if (instream.eof()) return false;
 		std::getline(instream, line);
 		tokens = splitString(line, ' ');
 		assert(tokens.size() == 4);
@@ -201,7 +200,7 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 
 	std::vector<BackwardEdge> backwardEdges(numEdges);
 	for (index i = 0; i < numEdges; ++i) {
-		if (file.eof()) return false;
+		if (instream.eof()) return false;
 		std::getline(instream, line);
 		tokens = splitString(line, ' ');
 		assert(tokens.size() == 4);
@@ -211,7 +210,7 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 	std::vector<pv> cellNumbers(numCellNumbers);
 	pv max = 0;
 	for (index i = 0; i < numCellNumbers; ++i) {
-		if (file.eof()) return false;
+		if (instream.eof()) return false;
 		std::getline(instream, line);
 		tokens = splitString(line, ' ');
 		assert(tokens.size() == 1);
@@ -233,7 +232,7 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 
 	std::unordered_map<SubVertex, index, SubVertexHasher> overlayVertices;
 	for (index i = 0; i < numOverlayMappings; ++i) {
-		if (file.eof()) return false;
+		if (instream.eof()) return false;
 		std::getline(instream, line);
 		tokens = splitString(line, ' ');
 		assert(tokens.size() == 4);
@@ -267,6 +266,8 @@ bool GraphIO::readGraph(Graph &graph, const std::string &inputFilePath) {
 		}
 	}
 
+	if (inbuf.failed()) return false;
+
 	graph = Graph(vertices, forwardEdges, backwardEdges, turnTables, cellNumbers, overlayVertices, maxEdgesInCell, forwardEdgeCellOffset, backwardEdgeCellOffset);
 
 	std::cout << "Read graph with " << graph.numberOfVertices() << " vertices and " << graph.numberOfEdges() << " edges" << std::endl;
@@ -480,8 +481,9 @@ bool GraphIO::writeWeights(const OverlayWeights &weights, const std::string &out
 	return true;
 }
 
-bool GraphIO::readWeights(OverlayWeights &weights, const std::string &inputFilePath) {
+bool GraphIO::readWeights(OverlayWeights &weights, const std::string &inputFilePath, const OverlayGraph *overlayGraph) {
 	weights = OverlayWeights(load_vector<weight>(inputFilePath));
+	if (overlayGraph != nullptr) weights.buildTransposedWeights(*overlayGraph);
 	return true;
 }
 
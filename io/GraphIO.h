@@ -54,7 +54,7 @@ public:
 
 	static bool writeWeights(const OverlayWeights &weights, const std::string &outputFilePath);
 
-	static bool readWeights(OverlayWeights &weights, const std::string &inputFilePath);
+	static bool readWeights(OverlayWeights &weights, const std::string &inputFilePath, const OverlayGraph *overlayGraph = nullptr);
 
 	static std::vector<std::string> splitString(const std::string &str, char splitToken);
 
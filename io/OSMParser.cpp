@@ -31,25 +31,35 @@
 #include <vector>
 #include <unordered_set>
 #include <algorithm>
+#include <numeric>
 
 #include "GraphIO.h"
+#include "PbfParser.h"
+#include "../algorithm/StronglyConnectedComponents.h"
 
 namespace CRP {
 
-OSMParser::OSMParser() : currentWay(maxId), currentNode(maxId), validNode(true), inRelation(false) {
+OSMParser::OSMParser() : numNodesFound(0), pass(WAY_PASS), currentWay(maxId), currentNode(maxId), validNode(true), inRelation(false) {
 }
 
 bool OSMParser::parseGraph(const std::string &graphFile, Graph &graph) {
 	currentWay = std::numeric_limits<Id>::max();
 
-	SaxParser xmlParser;
-	std::cout << "Parsing file " << graphFile << std::endl;
-	bool ok = xmlParser.parseBZ2(graphFile, *this);
+	std::cout << "Parsing ways in file " << graphFile << std::endl;
+	pass = WAY_PASS;
+	bool ok = parseFile(graphFile);
+	if (ok) {
+		finishWayPass();
+		std::cout << "Parsing nodes in file " << graphFile << std::endl;
+		pass = NODE_PASS;
+		ok = parseFile(graphFile);
+	}
 	if (ok) {
 		std::cout << "SUCCESS" << std::endl;
-		std::cout << "Parsed " << nodes.size() << " nodes and " << ways.size() << " ways." << std::endl;
+		std::cout << "Parsed " << numNodesFound << " nodes and " << ways.size() << " ways." << std::endl;
 		std::cout << "Building graph" << std::endl;
 		buildGraph(graph);
+		removeUnreachableParts(graph);
 		std::cout << "Done" << std::endl;
 	} else {
 		std::cout << "FAILED" << std::endl;
@@ -58,86 +68,211 @@ bool OSMParser::parseGraph(const std::string &graphFile, Graph &graph) {
 	return ok;
 }
 
-void OSMParser::startElement(const std::string &uri, const std::string &localName, const std::string &qName, const std::vector<Attribute> &attributes) {
+void OSMParser::removeUnreachableParts(Graph &graph) {
+	StronglyConnectedComponents scc(graph);
+	scc.run();
+	const count numVertices = graph.numberOfVertices();
+	const count numEdges = graph.numberOfEdges();
+	graph = scc.extractLargestComponent();
+	std::cout << "Found " << scc.getNumberOfComponents() << " strongly connected components, kept the largest one with "
+			<< graph.numberOfVertices() << " of " << numVertices << " vertices and " << graph.numberOfEdges() << " of " << numEdges << " edges" << std::endl;
+}
+
+bool OSMParser::parseFile(const std::string &graphFile) {
+	const std::string pbfExtension = ".pbf";
+	if (graphFile.size() >= pbfExtension.size() && graphFile.compare(graphFile.size() - pbfExtension.size(), pbfExtension.size(), pbfExtension) == 0) {
+		PbfParser pbfParser;
+		return pbfParser.parse(graphFile, *this);
+	} else {
+		SaxParser xmlParser;
+		return xmlParser.parseBZ2(graphFile, *this);
+	}
+}
+
+void OSMParser::finishWayPass() {
+	// keep only the first of several ways with the same id
+	wayIndex.resize(ways.size());
+	for (index i = 0; i < ways.size(); ++i) {
+		wayIndex[i] = std::make_pair(ways[i].id, i);
+	}
+	std::sort(wayIndex.begin(), wayIndex.end());
+
+	std::vector<bool> duplicate(ways.size(), false);
+	for (index i = 1; i < wayIndex.size(); ++i) {
+		if (wayIndex[i].first == wayIndex[i-1].first) {
+			std::cout << "WARNING: " << wayIndex[i].first << " already parsed" << std::endl;
+			duplicate[wayIndex[i].second] = true;
+		}
+	}
+
+	index numWays = 0;
+	for (index i = 0; i < ways.size(); ++i) {
+		if (!duplicate[i]) {
+			ways[numWays++] = ways[i];
+		}
+	}
+	ways.resize(numWays);
+
+	wayIndex.resize(ways.size());
+	for (index i = 0; i < ways.size(); ++i) {
+		wayIndex[i] = std::make_pair(ways[i].id, i);
+	}
+	std::sort(wayIndex.begin(), wayIndex.end());
+
+	nodeIds.clear();
+	for (const Way &way : ways) {
+		nodeIds.insert(nodeIds.end(), wayNodeIds.begin() + way.firstNode, wayNodeIds.begin() + way.firstNode + way.numNodes);
+	}
+	std::sort(nodeIds.begin(), nodeIds.end());
+	nodeIds.erase(std::unique(nodeIds.begin(), nodeIds.end()), nodeIds.end());
+	nodeIds.shrink_to_fit();
+
+	nodeLat.assign(nodeIds.size(), 0);
+	nodeLon.assign(nodeIds.size(), 0);
+	nodePresent.assign(nodeIds.size(), false);
+	numNodesFound = 0;
+}
+
+void OSMParser::startElement(const StringRef &uri, const StringRef &localName, const StringRef &qName, const std::vector<Attribute> &attributes) {
 	if (qName == "node") {
-		extractNode(attributes);
+		if (pass == NODE_PASS) {
+			extractNode(attributes);
+		}
 	} else if (qName == "way") {
-		currentWay = maxId;
-		for (Attribute a : attributes) {
+		Id id = maxId;
+		for (const Attribute &a : attributes) {
 			if (a.qName == "id") {
-				currentWay = std::stoll(a.value);
+				parseId(a.value, id);
 				break;
 			}
 		}
-		if (ways.find(currentWay) != ways.end()) {
-			std::cout << "WARNING: " <<  currentWay << " already parsed" << std::endl;
-			currentWay = maxId;
-			return;
-		} else {
-			Way way = {std::vector<Id>(), 0, STREET_TYPE::INVALID, 0, false};
-			ways.insert(std::make_pair(currentWay, way));
-		}
-
+		startWay(id);
 	} else if (qName == "nd" && currentWay != maxId) {
 		Id nodeId = maxId;
-		for (Attribute a : attributes) {
+		for (const Attribute &a : attributes) {
 			if (a.qName == "ref") {
-				nodeId = std::stoll(a.value);
+				parseId(a.value, nodeId);
 				break;
 			}
 		}
 
 		if (nodeId != maxId) {
-			ways[currentWay].nodes.push_back(nodeId);
+			addWayNode(nodeId);
 		}
 	} else if (qName == "tag" && inRelation) {
-		parseRelationTag(attributes);
+		addRelationTag(attributes[0].value, attributes[1].value);
 	} else if (qName == "tag" && currentWay != maxId) {
-		parseWayTag(attributes);
+		addWayTag(attributes[0].value, attributes[1].value);
 	} else if (qName == "relation") {
-		inRelation = true;
+		startRelation();
 	} else if (qName == "member") {
 		parseMember(attributes);
 	}
 }
 
-void OSMParser::endElement(const std::string &uri, const std::string &localName, const std::string &qName) {
+void OSMParser::endElement(const StringRef &uri, const StringRef &localName, const StringRef &qName) {
 	if (qName == "node") {
 		if (!validNode && currentNode != maxId) {
-			nodes.erase(currentNode);
+			nodePresent[findNode(currentNode)] = false;
+			numNodesFound--;
 		}
 		validNode = true;
 		currentNode = maxId;
 	} else if (qName == "way" && currentWay != maxId) {
-		if (ways[currentWay].type == STREET_TYPE::INVALID) {
-			ways.erase(currentWay);
-		}
-		currentWay = maxId;
+		endWay();
 	} else if (qName == "relation") {
-		if (currentRestriction.to != maxId && currentRestriction.via != maxId && currentWay != maxId && currentRestriction.turnRestriction != INVALID) {
-			if (restrictions.find(currentWay) == restrictions.end()) {
-				restrictions.insert(std::make_pair(currentWay, std::vector<Restriction>({currentRestriction})));
-			} else {
-				restrictions[currentWay].push_back(currentRestriction);
-			}
+		endRelation();
+	}
+}
+
+void OSMParser::addNode(Id id, float lat, float lon) {
+	currentNode = maxId;
+	validNode = true;
+	if (pass != NODE_PASS) return;
+
+	const index position = findNode(id);
+	if (position == invalid_id || nodePresent[position]) return;
+	nodeLat[position] = toFixedPoint(lat);
+	nodeLon[position] = toFixedPoint(lon);
+	nodePresent[position] = true;
+	numNodesFound++;
+	currentNode = id;
+}
+
+void OSMParser::startWay(Id id) {
+	if (pass != WAY_PASS) return;
+	currentWay = id;
+	ways.push_back({id, wayNodeIds.size(), 0, 0, STREET_TYPE::INVALID, 0, false});
+}
+
+void OSMParser::addWayNode(Id nodeId) {
+	if (currentWay != maxId) {
+		wayNodeIds.push_back(nodeId);
+		ways.back().numNodes++;
+	}
+}
+
+void OSMParser::addWayTag(const StringRef &key, const StringRef &value) {
+	if (currentWay != maxId) {
+		parseWayTag(key, value);
+	}
+}
+
+void OSMParser::endWay() {
+	if (currentWay == maxId) return;
+	if (ways.back().type == STREET_TYPE::INVALID) {
+		wayNodeIds.resize(ways.back().firstNode);
+		ways.pop_back();
+	}
+	currentWay = maxId;
+}
+
+void OSMParser::startRelation() {
+	inRelation = pass == WAY_PASS;
+}
+
+void OSMParser::addRelationMember(Id refId, const StringRef &role) {
+	if (refId == maxId || !inRelation) return;
+	if (role == "from") {
+		currentWay = refId;
+	} else if (role == "to") {
+		currentRestriction.to = refId;
+	} else if (role == "via") {
+		currentRestriction.via = refId;
+	}
+}
+
+void OSMParser::addRelationTag(const StringRef &key, const StringRef &value) {
+	if (inRelation) {
+		parseRelationTag(key, value);
+	}
+}
+
+void OSMParser::endRelation() {
+	if (currentRestriction.to != maxId && currentRestriction.via != maxId && currentWay != maxId && currentRestriction.turnRestriction != INVALID) {
+		if (restrictions.find(currentWay) == restrictions.end()) {
+			restrictions.insert(std::make_pair(currentWay, std::vector<Restriction>({currentRestriction})));
+		} else {
+			restrictions[currentWay].push_back(currentRestriction);
 		}
-		inRelation = false;
-		currentRestriction.to = maxId;
-		currentRestriction.via = maxId;
-		currentRestriction.turnRestriction = INVALID;
-		currentWay = maxId;
 	}
+	inRelation = false;
+	currentRestriction.to = maxId;
+	currentRestriction.via = maxId;
+	currentRestriction.turnRestriction = INVALID;
+	currentWay = maxId;
 }
 
 void OSMParser::buildGraph(Graph &graph) {
-	std::unordered_map<Id, index> vertexMapping;
+	// vertex of every node referenced by a way, indexed by the position of the node in nodeIds
+	std::vector<index> vertexMapping(nodeIds.size(), invalid_id);
 	index vIdx = 0;
 
-	for (const std::pair<Id, Way> &wayPair : ways) {
-		Way way = wayPair.second;
-		for (const Id &node : way.nodes) {
-			if (vertexMapping.find(node) == vertexMapping.end()) {
-				vertexMapping.insert(std::make_pair(node, vIdx++));
+	for (const Way &way : ways) {
+		for (uint64_t k = way.firstNode; k < way.firstNode + way.numNodes; ++k) {
+			const index node = findNode(wayNodeIds[k]);
+			if (vertexMapping[node] == invalid_id) {
+				vertexMapping[node] = vIdx++;
 			}
 		}
 	}
@@ -151,29 +286,31 @@ void OSMParser::buildGraph(Graph &graph) {
 	std::vector<turnorder> inDegree(vertices.size()-1);
 	std::vector<turnorder> outDegree(vertices.size()-1);
 
-	for (std::pair<Id, Way> wayPair : ways) {
-		Way way = wayPair.second;
-		std::vector<Id> &wNodes = way.nodes;
+	std::vector<Id> wNodes;
+	for (const Way &way : ways) {
+		wNodes.assign(wayNodeIds.begin() + way.firstNode, wayNodeIds.begin() + way.firstNode + way.numNodes);
 		if (wNodes.size() == 0) continue;
 		for (index i = 0; i < wNodes.size()-1; ++i) {
-			while (i < wNodes.size()-1 && nodes.find(wNodes[i]) == nodes.end()) {
-				std::cout << "WARNING: vertex " << wNodes[i] << " referenced in " << wayPair.first << " not present in file!" << std::endl;
+			while (i < wNodes.size()-1 && !hasNode(wNodes[i])) {
+				std::cout << "WARNING: vertex " << wNodes[i] << " referenced in " << way.id << " not present in file!" << std::endl;
 				wNodes.erase(wNodes.begin() + i);
 			}
-			index u = vertexMapping.at(wNodes[i]);
-			vertices[u].coord = {nodes[wNodes[i]].lat, nodes[wNodes[i]].lon};
+			const index uNode = findNode(wNodes[i]);
+			index u = vertexMapping[uNode];
+			vertices[u].coord = {getNode(uNode).lat, getNode(uNode).lon};
 
-			while (i < wNodes.size()-1 && nodes.find(wNodes[i+1]) == nodes.end()) {
-				std::cout << "WARNING: vertex " << wNodes[i+1] << " referenced in " << wayPair.first << " not present in file!" << std::endl;
+			while (i < wNodes.size()-1 && !hasNode(wNodes[i+1])) {
+				std::cout << "WARNING: vertex " << wNodes[i+1] << " referenced in " << way.id << " not present in file!" << std::endl;
 				wNodes.erase(wNodes.begin() + i+1);
 			}
-			if (vertexMapping.find(wNodes[i+1]) == vertexMapping.end()) break;
+			if (i+1 >= wNodes.size()) break;
 
-			index v = vertexMapping.at(wNodes[i+1]);
+			const index vNode = findNode(wNodes[i+1]);
+			index v = vertexMapping[vNode];
 			if (u == v) continue;
-			vertices[v].coord = {nodes[wNodes[i+1]].lat, nodes[wNodes[i+1]].lon};
+			vertices[v].coord = {getNode(vNode).lat, getNode(vNode).lon};
 
-			edgeAttr packedAttributes = ((weight) std::round(getDistance(nodes[wNodes[i]], nodes[wNodes[i+1]]))) << 12;
+			edgeAttr packedAttributes = ((weight) std::round(getDistance(getNode(uNode), getNode(vNode)))) << 12;
 			packedAttributes |= ((edgeAttr) way.maxSpeed) << 4;
 			packedAttributes |= ((edgeAttr) way.type);
 
@@ -214,15 +351,15 @@ void OSMParser::buildGraph(Graph &graph) {
 	}
 
 	std::cout << "Found " << restrictions.size() << " restrictions" << std::endl;
-	for (std::pair<Id, Way> wayPair : ways) {
-		if (!wayPair.second.oneway && wayPair.second.nodes.size() > 1) { // allow no u_turns at (u,v) -> (v,u)
-			std::vector<Id> &wayNodes = wayPair.second.nodes;
-			for (index i = 0; i < wayNodes.size(); ++i) {
-				if (nodes.find(wayNodes[i]) == nodes.end()) continue;
-				index via = vertexMapping[wayNodes[i]];
+	for (const Way &way : ways) {
+		const Id *wayNodes = &wayNodeIds[way.firstNode];
+		if (!way.oneway && way.numNodes > 1) { // allow no u_turns at (u,v) -> (v,u)
+			for (index i = 0; i < way.numNodes; ++i) {
+				if (!hasNode(wayNodes[i])) continue;
+				index via = vertexMapping[findNode(wayNodes[i])];
 				if (inDegree[via] == 1 && outDegree[via] == 1) continue;
-				if (i == 0 && nodes.find(wayNodes[1]) != nodes.end()) {					
-					index to = vertexMapping[wayNodes[1]];
+				if (i == 0 && hasNode(wayNodes[1])) {					
+					index to = vertexMapping[findNode(wayNodes[1])];
 					if (to == via) continue;
 					index entryId = invalid_id;
 					index exitId = invalid_id;
@@ -245,10 +382,10 @@ void OSMParser::buildGraph(Graph &graph) {
 					}
 					assert(entryId != invalid_id);
 					turnMatrices[via][entryId * outDegree[via] + exitId] = Graph::U_TURN;
-				} else if (i < wayNodes.size()-1) {
+				} else if (i < way.numNodes-1) {
 					// backward
-					if (nodes.find(wayNodes[i-1]) != nodes.end()) {
-						index to = vertexMapping[wayNodes[i-1]];
+					if (hasNode(wayNodes[i-1])) {
+						index to = vertexMapping[findNode(wayNodes[i-1])];
 						if (to == via) continue;
 						index entryId = invalid_id;
 						index exitId = invalid_id;
@@ -270,9 +407,9 @@ void OSMParser::buildGraph(Graph &graph) {
 						turnMatrices[via][entryId * outDegree[via] + exitId] = Graph::U_TURN;
 					}
 
-					if (nodes.find(wayNodes[i+1]) != nodes.end()) {
+					if (hasNode(wayNodes[i+1])) {
 						// forward
-						index to = vertexMapping[wayNodes[i+1]];
+						index to = vertexMapping[findNode(wayNodes[i+1])];
 						if (to == via) continue;
 						index entryId = invalid_id;
 						index exitId = invalid_id;
@@ -295,8 +432,8 @@ void OSMParser::buildGraph(Graph &graph) {
 					}
 
 				} else {
-					if (nodes.find(wayNodes[i-1]) == nodes.end()) continue;
-					index to = vertexMapping[wayNodes[i-1]];
+					if (!hasNode(wayNodes[i-1])) continue;
+					index to = vertexMapping[findNode(wayNodes[i-1])];
 					if (to == via) continue;
 					index entryId = invalid_id;
 					index exitId = invalid_id;
@@ -321,35 +458,36 @@ void OSMParser::buildGraph(Graph &graph) {
 		}
 
 
-		if (restrictions.find(wayPair.first) == restrictions.end()) continue;
-		std::vector<Restriction> &fromRestrictions = restrictions[wayPair.first];
+		if (restrictions.find(way.id) == restrictions.end()) continue;
+		std::vector<Restriction> &fromRestrictions = restrictions[way.id];
 
-		std::vector<Id> &fromNodes = wayPair.second.nodes;
+		const Id *fromNodes = wayNodes;
 		for (const Restriction &r : fromRestrictions) {
-			if (wayPair.first == r.to || vertexMapping.find(r.via) == vertexMapping.end()) continue; // ignore restrictions that have from == to
-			if (ways.find(r.to) == ways.end()) continue; // r.to is not known
-			assert(ways.find(r.to) != ways.end());
-			for (index i = 0; i < fromNodes.size(); ++i) {
+			if (way.id == r.to || findNode(r.via) == invalid_id) continue; // ignore restrictions that have from == to
+			const index toWay = findWay(r.to);
+			if (toWay == invalid_id) continue; // r.to is not known
+			for (index i = 0; i < way.numNodes; ++i) {
 				if (fromNodes[i] == r.via) {
-					if (i == 0 && wayPair.second.oneway) continue; // there is no predecessor
+					if (i == 0 && way.oneway) continue; // there is no predecessor
 					Id predecessor = i == 0? fromNodes[i+1] : fromNodes[i-1];
 					if (predecessor == r.via) continue;
 					Id successor = maxId;
-					std::vector<Id> &toNodes = ways[r.to].nodes;
-					for (index j = 0; j < toNodes.size()-1; ++j) {
-						if (j == toNodes.size()-1 && wayPair.second.oneway) break;
+					const Id *toNodes = &wayNodeIds[ways[toWay].firstNode];
+					const index numToNodes = ways[toWay].numNodes;
+					for (index j = 0; j + 1 < numToNodes; ++j) {
+						if (j == numToNodes-1 && way.oneway) break;
 						if (toNodes[j] == r.via) {
-							successor = j == toNodes.size()-1? toNodes[j-1] : toNodes[j+1];
+							successor = j == numToNodes-1? toNodes[j-1] : toNodes[j+1];
 							break; // do not search any further in toNodes (since we found the successor)
 						}
 					}
 
 					if (successor != maxId && successor != r.via) {
-						assert(vertexMapping.find(predecessor) != vertexMapping.end());
-						index from = vertexMapping[predecessor];
-						index via = vertexMapping[r.via];
-						assert(vertexMapping.find(successor) != vertexMapping.end());
-						index to = vertexMapping[successor];
+						assert(findNode(predecessor) != invalid_id);
+						index from = vertexMapping[findNode(predecessor)];
+						index via = vertexMapping[findNode(r.via)];
+						assert(findNode(successor) != invalid_id);
+						index to = vertexMapping[findNode(successor)];
 
 						assert(from < vIdx && via < vIdx && to < vIdx);
 
@@ -419,9 +557,14 @@ void OSMParser::buildGraph(Graph &graph) {
 	}
 
 	// clear ways, nodes and vertexMapping to save memory
-	nodes.clear();
-	ways.clear();
-	vertexMapping.clear();
+	std::vector<Id>().swap(nodeIds);
+	std::vector<int32_t>().swap(nodeLat);
+	std::vector<int32_t>().swap(nodeLon);
+	std::vector<bool>().swap(nodePresent);
+	std::vector<Way>().swap(ways);
+	std::vector<Id>().swap(wayNodeIds);
+	std::vector<std::pair<Id, index>>().swap(wayIndex);
+	std::vector<index>().swap(vertexMapping);
 	restrictions.clear();
 
 	std::cout << "Done parsing restrictions" << std::endl;
@@ -578,26 +721,3 @@ void OSMParser::buildGraph(Graph &graph) {
 
 
 } /* namespace CRP */
-
-int main(int argc, char* argv[]) {
-	if (argc != 3) {
-		std::cout << "Usage: " << argv[0] << " path_to_osm.bz2 path_to_output.graph.bz2" << std::endl;
-		return 1;
-	}
-
-	std::string input(argv[1]);
-	std::string graphOutput(argv[2]);
-
-	CRP::OSMParser osmParser;
-	CRP::Graph graph;
-	bool ok = osmParser.parseGraph(input, graph);
-	if (ok) {
-		ok = CRP::GraphIO::writeGraph(graph, graphOutput);
-	}
-
-	if (!ok) {
-		std::cout << "An error occured during parsing" << std::endl;
-	}
-
-	return 0;
-}
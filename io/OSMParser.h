@@ -58,11 +58,40 @@ public:
 	OSMParser();
 	~OSMParser() = default;
 
+	/**
+	 * Parses a bz2-compressed OSM XML file or, if @a graphFile ends with .pbf, an OSM PBF file and builds the graph.
+	 * @param graphFile the OSM file
+	 * @param graph the resulting graph
+	 * @return whether the file could be parsed
+	 */
 	bool parseGraph(const std::string &graphFile, Graph &graph);
 
-	void startElement(const std::string &uri, const std::string &localName, const std::string &qName, const std::vector<Attribute> &attributes);
+	void startElement(const StringRef &uri, const StringRef &localName, const StringRef &qName, const std::vector<Attribute> &attributes);
+
+	void endElement(const StringRef &uri, const StringRef &localName, const StringRef &qName);
+
+	/*
+	 * The following events are sent by the XML handler methods above and by the @ref PbfParser. Tags and
+	 * nodes of a way have to be sent between startWay() and endWay(), nodes before tags.
+	 */
+
+	void addNode(Id id, float lat, float lon);
+
+	void startWay(Id id);
+
+	void addWayNode(Id nodeId);
+
+	void addWayTag(const StringRef &key, const StringRef &value);
+
+	void endWay();
 
-	void endElement(const std::string &uri, const std::string &localName, const std::string &qName);
+	void startRelation();
+
+	void addRelationMember(Id refId, const StringRef &role);
+
+	void addRelationTag(const StringRef &key, const StringRef &value);
+
+	void endRelation();
 
 	template<typename T>
 	static std::vector<T> flatten(const std::vector<std::vector<T>> &container);
@@ -78,7 +107,9 @@ private:
 	};
 
 	struct Way {
-		std::vector<Id> nodes;
+		Id id;
+		uint64_t firstNode; // offset of the first node in wayNodeIds
+		uint32_t numNodes;
 		Speed maxSpeed;
 		STREET_TYPE type;
 		float maxHeight;
@@ -91,20 +122,43 @@ private:
 		TURN_RESTRICTION turnRestriction;
 	};
 
-
+	/*
+	 * The file is read twice. The first pass collects ways and relations, the second pass keeps the coordinates
+	 * of the nodes referenced by ways only.
+	 */
+	enum ParsePass {WAY_PASS, NODE_PASS};
 
 	std::unordered_map<Id, std::vector<Restriction>> restrictions;
-	std::unordered_map<Id, Node> nodes;
-	std::unordered_map<Id, Way> ways;
+	// ways in file order, the nodes of a way are a slice of wayNodeIds
+	std::vector<Way> ways;
+	std::vector<Id> wayNodeIds;
+	// (way id, position in ways) sorted by id
+	std::vector<std::pair<Id, index>> wayIndex;
+	// sorted ids of the nodes referenced by ways, with their coordinates in units of 1e-7 degrees
+	std::vector<Id> nodeIds;
+	std::vector<int32_t> nodeLat;
+	std::vector<int32_t> nodeLon;
+	std::vector<bool> nodePresent;
+	count numNodesFound;
+	ParsePass pass;
 	Id currentWay;
 	Id currentNode;
 	bool validNode;
 	Restriction currentRestriction;
 	bool inRelation;
 
+	bool parseFile(const std::string &graphFile);
+
+	void finishWayPass();
 
 	void buildGraph(Graph &graph);
 
+	/**
+	 * Reduces @a graph to the largest strongly connected component of its turn-expanded graph, so that every
+	 * remaining vertex can be reached from every other one.
+	 */
+	void removeUnreachableParts(Graph &graph);
+
 	/**
 	 * Compute the distance between two nodes @a u and @a v using the haversine formula
 	 * @param u
@@ -128,104 +182,129 @@ private:
 		return degreeVal * M_PI / 180.0;
 	}
 
+	inline static int32_t toFixedPoint(float degrees) {
+		return (int32_t) std::lround(degrees * 1e7);
+	}
+
+	inline static float toDegrees(int32_t fixedPoint) {
+		return (float) (fixedPoint / 1e7);
+	}
+
+	/** @return the position of @a id in nodeIds or invalid_id if no way references it */
+	inline index findNode(Id id) const {
+		auto it = std::lower_bound(nodeIds.begin(), nodeIds.end(), id);
+		return it != nodeIds.end() && *it == id ? it - nodeIds.begin() : invalid_id;
+	}
+
+	/** @return whether the node @a id is referenced by a way and present in the file */
+	inline bool hasNode(Id id) const {
+		const index position = findNode(id);
+		return position != invalid_id && nodePresent[position];
+	}
+
+	inline Node getNode(index position) const {
+		return {toDegrees(nodeLat[position]), toDegrees(nodeLon[position])};
+	}
+
+	/** @return the position of the way @a id in ways or invalid_id */
+	inline index findWay(Id id) const {
+		auto it = std::lower_bound(wayIndex.begin(), wayIndex.end(), std::make_pair(id, (index) 0));
+		return it != wayIndex.end() && it->first == id ? it->second : invalid_id;
+	}
+
 	inline void extractNode(const std::vector<Attribute> &attributes) {
 		Id id = 0;
 		Node node = {0,0};
 		uint8_t numParsed = 0;
-		for (Attribute a : attributes) {
+		for (const Attribute &a : attributes) {
 			if (a.qName == "id") {
-				id = std::stoll(a.value);
-				numParsed++;
+				numParsed += parseId(a.value, id);
 			} else if (a.qName == "lat") {
-				node.lat = std::stof(a.value);
-				numParsed++;
+				numParsed += a.value.toFloat(node.lat);
 			} else if (a.qName == "lon") {
-				node.lon = std::stof(a.value);
-				numParsed++;
+				numParsed += a.value.toFloat(node.lon);
 			}
 		}
 
 		if (numParsed == 3) {
-			nodes.insert(std::make_pair(id, node));
-			currentNode = id;
-			validNode = true;
+			addNode(id, node.lat, node.lon);
 		}
 	}
 
 	inline void parseNodeTag(const std::vector<Attribute> &attributes) {
-		std::string tagKey = attributes[0].value;
-		if (tagKey == "amenity" || tagKey == "power" || SaxParser::stringStartsWith(tagKey, "addr") || tagKey == "natural" || tagKey == "shop" || tagKey == "tourism") {
+		const StringRef &tagKey = attributes[0].value;
+		if (tagKey == "amenity" || tagKey == "power" || tagKey.startsWith("addr") || tagKey == "natural" || tagKey == "shop" || tagKey == "tourism") {
 			validNode = false;
 		}
 	}
 
-	inline void parseWayTag(const std::vector<Attribute> &attributes) {
-		std::string tagKey = attributes[0].value;
-		std::string tagVal = attributes[1].value;
+	inline void parseWayTag(const StringRef &tagKey, const StringRef &tagVal) {
+		Way &way = ways.back();
 
 		if (tagKey == "maxspeed") {
 			//std::cout << tagVal << std::endl;
 			//if (!std::regex_match(tagVal, std::regex("^[A-Za-z]+$"))) {
-			if (isInteger(tagVal)) {
-				ways[currentWay].maxSpeed = std::stoi(tagVal);
+			int64_t maxSpeed;
+			if (isInteger(tagVal) && tagVal.toInteger(maxSpeed)) {
+				way.maxSpeed = maxSpeed;
 			}
 		} else if (tagKey == "maxheight") {
 			//std::cout << tagVal << std::endl;
-			if (isFloat(tagVal)) {
-				ways[currentWay].maxHeight = std::stof(tagVal);
+			float maxHeight;
+			if (isFloat(tagVal) && tagVal.toFloat(maxHeight)) {
+				way.maxHeight = maxHeight;
 			}
 		} else if (tagKey == "junction") {
 			if (tagVal == "roundabout" || tagVal == "mini_roundabout" || tagVal == "turning_loop") {
-				if (ways[currentWay].nodes.front() != ways[currentWay].nodes.back()) {
-					ways[currentWay].nodes.push_back(ways[currentWay].nodes.front());
-					ways[currentWay].oneway = true;
+				if (way.numNodes > 0 && wayNodeIds[way.firstNode] != wayNodeIds.back()) {
+					wayNodeIds.push_back(wayNodeIds[way.firstNode]);
+					way.numNodes++;
+					way.oneway = true;
 				}
 			}
 		} else if (tagKey == "oneway") {
 			if (tagVal == "yes" || tagVal == "1" || tagVal == "true") {
-				ways[currentWay].oneway = true;
+				way.oneway = true;
 			} else if (tagVal == "-1" || tagVal == "reverse") {
-				std::reverse(ways[currentWay].nodes.begin(), ways[currentWay].nodes.end());
-				ways[currentWay].oneway = true;
+				std::reverse(wayNodeIds.begin() + way.firstNode, wayNodeIds.end());
+				way.oneway = true;
 			}
 		} else if (tagKey == "highway") {
 			if (tagVal == "motorway") {
-				ways[currentWay].type = MOTORWAY;
+				way.type = MOTORWAY;
 			} else if (tagVal == "trunk") {
-				ways[currentWay].type = TRUNK;
+				way.type = TRUNK;
 			} else if (tagVal == "primary") {
-				ways[currentWay].type = PRIMARY;
+				way.type = PRIMARY;
 			} else if (tagVal == "secondary") {
-				ways[currentWay].type = SECONDARY;
+				way.type = SECONDARY;
 			} else if (tagVal == "tertiary") {
-				ways[currentWay].type = TERTIARY;
+				way.type = TERTIARY;
 			} else if (tagVal == "unclassified") {
-				ways[currentWay].type = UNCLASSIFIED;
+				way.type = UNCLASSIFIED;
 			} else if (tagVal == "residential") {
-				ways[currentWay].type = RESIDENTIAL;
+				way.type = RESIDENTIAL;
 			} else if (tagVal == "service") {
-				ways[currentWay].type = SERVICE;
+				way.type = SERVICE;
 			} else if (tagVal == "motorway_link") {
-				ways[currentWay].type = MOTORWAY_LINK;
+				way.type = MOTORWAY_LINK;
 			} else if (tagVal == "trunk_link") {
-				ways[currentWay].type = TRUNK_LINK;
+				way.type = TRUNK_LINK;
 			} else if (tagVal == "primary_link") {
-				ways[currentWay].type = PRIMARY_LINK;
+				way.type = PRIMARY_LINK;
 			} else if (tagVal == "secondary_link") {
-				ways[currentWay].type = SECONDARY_LINK;
+				way.type = SECONDARY_LINK;
 			} else if (tagVal == "tertiary_link") {
-				ways[currentWay].type = TERTIARY_LINK;
+				way.type = TERTIARY_LINK;
 			} else if (tagVal == "living_street") {
-				ways[currentWay].type = LIVING_STREET;
+				way.type = LIVING_STREET;
 			} else if (tagVal == "road") {
-				ways[currentWay].type = ROAD;
+				way.type = ROAD;
 			}
 		}
 	}
 
-	inline void parseRelationTag(const std::vector<Attribute> &attributes) {
-		std::string tagKey = attributes[0].value;
-		std::string tagVal = attributes[1].value;
+	inline void parseRelationTag(const StringRef &tagKey, const StringRef &tagVal) {
 		if (tagKey == "restriction") {
 			if (tagVal == "no_left_turn") {
 				currentRestriction.turnRestriction = NO_LEFT_TURN;
@@ -249,41 +328,33 @@ private:
 
 	inline void parseMember(const std::vector<Attribute> &attributes) {
 		Id refId = maxId;
-		enum Type {FROM, VIA, TO, INVALID};
-		Type type = INVALID;
+		StringRef role;
 		for (const Attribute &a : attributes) {
 			if (a.qName == "ref") {
-				refId = std::stoll(a.value);
+				parseId(a.value, refId);
 			} else if (a.qName == "role") {
-				if (a.value == "from") {
-					type = FROM;
-				} else if (a.value == "to") {
-					type = TO;
-				} else if (a.value == "via") {
-					type = VIA;
-				}
+				role = a.value;
 			}
 		}
 
-		if (refId != maxId && type != INVALID) {
-			if (type == FROM) {
-				currentWay = refId;
-			} else if (type == TO) {
-				currentRestriction.to = refId;
-			} else {
-				currentRestriction.via = refId;
-			}
-		}
+		addRelationMember(refId, role);
+	}
+
+	inline bool parseId(const StringRef &str, Id &id) {
+		int64_t value;
+		if (!str.toInteger(value)) return false;
+		id = value;
+		return true;
 	}
 
-	inline bool isInteger(const std::string &str) {
+	inline bool isInteger(const StringRef &str) {
 		for (unsigned i = 0; i < str.size(); ++i) {
 			if (!std::isdigit(str[i])) return false;
 		}
 		return true;
 	}
 
-	inline bool isFloat(const std::string &str) {
+	inline bool isFloat(const StringRef &str) {
 		for (unsigned i = 0; i < str.size(); ++i) {
 			if (!std::isdigit(str[i]) && str[i] != '.' && str[i] != ',') return false;
 		}
@@ -0,0 +1,74 @@
+/*
+ * OSMParserMain.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+#include <string>
+
+#include "../algorithm/ChainContraction.h"
+#include "../datastructures/EdgeGeometry.h"
+#include "../datastructures/Graph.h"
+#include "GraphIO.h"
+#include "OSMParser.h"
+
+int main(int argc, char* argv[]) {
+	if (argc != 3 && !(argc == 4 && std::string(argv[3]) == "--contract-chains")) {
+		std::cout << "Usage: " << argv[0] << " path_to_osm.bz2 path_to_output.graph.bz2 [--contract-chains]" << std::endl;
+		std::cout << "--contract-chains merges chains of degree-2 vertices into single edges and writes their geometry to path_to_output.geometry" << std::endl;
+		return 1;
+	}
+
+	std::string input(argv[1]);
+	std::string graphOutput(argv[2]);
+	const bool contractChains = argc == 4;
+
+	CRP::OSMParser osmParser;
+	CRP::Graph graph;
+	bool ok = osmParser.parseGraph(input, graph);
+	if (ok && contractChains) {
+		CRP::EdgeGeometry geometry;
+		CRP::ChainContraction contraction(graph);
+		graph = contraction.contract(geometry);
+		std::cout << "Removed " << contraction.getNumberOfRemovedVertices() << " vertices in chains, " << graph.numberOfVertices() << " vertices and "
+				<< graph.numberOfEdges() << " edges left" << std::endl;
+
+		const std::string graphExtension = ".graph.bz2";
+		std::string geometryOutput = graphOutput;
+		if (geometryOutput.size() >= graphExtension.size() && geometryOutput.compare(geometryOutput.size() - graphExtension.size(), graphExtension.size(), graphExtension) == 0) {
+			geometryOutput.erase(geometryOutput.size() - graphExtension.size());
+		}
+		ok = geometry.write(geometryOutput + ".geometry");
+	}
+	if (ok) {
+		ok = CRP::GraphIO::writeGraph(graph, graphOutput);
+	}
+
+	if (!ok) {
+		std::cout << "An error occured during parsing" << std::endl;
+	}
+
+	return 0;
+}
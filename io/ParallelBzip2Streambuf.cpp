@@ -0,0 +1,327 @@
+/*
+ * ParallelBzip2Streambuf.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ParallelBzip2Streambuf.h"
+#include "../constants.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <bzlib.h>
+#include "omp.h"
+
+namespace CRP {
+
+ParallelBzip2Streambuf::ParallelBzip2Streambuf(std::istream &compressed) : input(compressed), inputDone(false), error(false),
+		firstBit(0), scannedBytes(0), level(0) {
+	setg(nullptr, nullptr, nullptr);
+}
+
+ParallelBzip2Streambuf::int_type ParallelBzip2Streambuf::underflow() {
+	if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+	output.clear();
+	std::vector<Segment> segments;
+	while (output.empty() && nextSegments(segments)) {
+		std::vector<std::string> data(segments.size());
+		std::vector<uint8_t> decompressed(segments.size());
+
+		#pragma omp parallel for schedule(dynamic)
+		for (index i = 0; i < segments.size(); ++i) {
+			decompressed[i] = decompress(segments[i], data[i]);
+		}
+
+		for (index i = 0; i < segments.size(); ++i) {
+			index last = i;
+			if (!decompressed[i]) {
+				// the end of the segment may be a random occurrence of the magic number, retry with its successors
+				Segment merged = segments[i];
+				bool recovered = false;
+				for (index j = i+1; j < segments.size() && segments[j].beginBit == merged.endBit && !recovered; ++j) {
+					merged.endBit = segments[j].endBit;
+					if (decompress(merged, data[i])) {
+						recovered = true;
+						last = j;
+					}
+				}
+
+				if (!recovered) {
+					std::cout << "ERROR: corrupt bzip2 block" << std::endl;
+					error = true;
+					break;
+				}
+			}
+
+			output += data[i];
+			i = last;
+		}
+
+		if (error) break;
+	}
+
+	if (output.empty()) {
+		setg(nullptr, nullptr, nullptr);
+		return traits_type::eof();
+	}
+
+	char *begin = &output[0];
+	setg(begin, begin, begin + output.size());
+	return traits_type::to_int_type(*gptr());
+}
+
+bool ParallelBzip2Streambuf::readStreamHeader(size_t byte, uint8_t &streamLevel) const {
+	if (byte + 4 > window.size()) return false;
+	if (window[byte] != 'B' || window[byte+1] != 'Z' || window[byte+2] != 'h' || window[byte+3] < '1' || window[byte+3] > '9') return false;
+	streamLevel = window[byte+3] - '0';
+	return true;
+}
+
+void ParallelBzip2Streambuf::fillWindow() {
+	// drop the processed part of the window
+	const size_t shift = firstBit / 8;
+	window.erase(window.begin(), window.begin() + shift);
+	firstBit -= shift * 8;
+	for (Mark &mark : marks) {
+		mark.bit -= shift * 8;
+	}
+	scannedBytes = std::max(scannedBytes, shift) - shift;
+
+	size_t targetSize = omp_get_max_threads() * windowSizePerThread;
+	if (window.size() >= targetSize) {
+		// a single block does not fit into the window
+		targetSize = 2 * window.size();
+	}
+
+	const size_t oldSize = window.size();
+	window.resize(targetSize);
+	input.read(reinterpret_cast<char*>(&window[oldSize]), targetSize - oldSize);
+	const std::streamsize numRead = input.gcount();
+	window.resize(oldSize + std::max<std::streamsize>(numRead, 0));
+	if (numRead < (std::streamsize) (targetSize - oldSize)) {
+		inputDone = true;
+	}
+}
+
+void ParallelBzip2Streambuf::scanWindow() {
+	// a magic number starting in byte i can reach into byte i+6
+	if (window.size() < 7 || scannedBytes + 6 >= window.size()) return;
+	const size_t end = window.size() - 6;
+
+	const size_t chunkSize = 1 << 20;
+	const size_t numChunks = (end - scannedBytes + chunkSize - 1) / chunkSize;
+	std::vector<std::vector<Mark>> chunkMarks(numChunks);
+
+	#pragma omp parallel for schedule(dynamic)
+	for (index c = 0; c < numChunks; ++c) {
+		const size_t chunkBegin = scannedBytes + c * chunkSize;
+		const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+		for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+			uint64_t value = 0;
+			for (size_t k = 0; k < 8; ++k) {
+				value = (value << 8) | (i + k < window.size() ? window[i+k] : 0);
+			}
+
+			for (uint8_t s = 0; s < 8; ++s) {
+				const uint64_t candidate = (value >> (16 - s)) & 0xFFFFFFFFFFFFULL;
+				if (candidate == blockMagic) {
+					chunkMarks[c].push_back({i * 8 + s, BLOCK});
+				} else if (candidate == endOfStreamMagic) {
+					chunkMarks[c].push_back({i * 8 + s, END_OF_STREAM});
+				}
+			}
+		}
+	}
+
+	for (const std::vector<Mark> &chunk : chunkMarks) {
+		marks.insert(marks.end(), chunk.begin(), chunk.end());
+	}
+	scannedBytes = end;
+}
+
+bool ParallelBzip2Streambuf::nextSegments(std::vector<Segment> &segments) {
+	segments.clear();
+	while (!error) {
+		if (level == 0) {
+			// expecting a stream header or the end of the input
+			const size_t byte = firstBit / 8;
+			if (window.size() < byte + 4 && !inputDone) {
+				fillWindow();
+				continue;
+			}
+			if (window.size() <= byte) return false;
+			if (!readStreamHeader(byte, level)) {
+				std::cout << "ERROR: no bzip2 stream header" << std::endl;
+				error = true;
+				return false;
+			}
+			firstBit = (byte + 4) * 8;
+		}
+
+		scanWindow();
+
+		index m = 0;
+		while (m < marks.size() && level != 0) {
+			const Mark mark = marks[m];
+			if (mark.bit < firstBit) {
+				m++;
+				continue;
+			}
+
+			if (mark.type == END_OF_STREAM) {
+				// the stream CRC and the padding to a full byte follow, then the next stream or the end of the input
+				const size_t byte = (mark.bit + 48 + 32 + 7) / 8;
+				if (window.size() < byte + 4 && !inputDone) break;
+				uint8_t nextLevel;
+				if (window.size() <= byte) {
+					level = 0;
+					firstBit = byte * 8;
+					m++;
+				} else if (readStreamHeader(byte, nextLevel)) {
+					level = nextLevel;
+					firstBit = (byte + 4) * 8;
+					m++;
+				} else {
+					// random occurrence of the magic number inside a block
+					marks.erase(marks.begin() + m);
+				}
+				continue;
+			}
+
+			if (m + 1 == marks.size()) break;
+			const Mark &next = marks[m+1];
+			if (next.type == END_OF_STREAM) {
+				const size_t byte = (next.bit + 48 + 32 + 7) / 8;
+				if (window.size() < byte + 4 && !inputDone) break;
+				uint8_t nextLevel;
+				if (window.size() > byte && !readStreamHeader(byte, nextLevel)) {
+					marks.erase(marks.begin() + m + 1);
+					continue;
+				}
+			}
+
+			segments.push_back({mark.bit, next.bit, level});
+			firstBit = next.bit;
+			m++;
+		}
+		marks.erase(marks.begin(), marks.begin() + m);
+
+		if (!segments.empty()) return true;
+		if (level == 0) continue;
+
+		if (inputDone) {
+			std::cout << "ERROR: unexpected end of bzip2 stream" << std::endl;
+			error = true;
+			return false;
+		}
+		fillWindow();
+	}
+
+	return false;
+}
+
+std::string ParallelBzip2Streambuf::buildStream(const Segment &segment) const {
+	// stream header, the block itself, end of stream marker and the stream CRC, which equals the block CRC for a single block
+	std::string stream = "BZh";
+	stream.push_back('0' + segment.level);
+	stream.reserve(4 + (segment.endBit - segment.beginBit) / 8 + 12);
+
+	uint64_t bit = segment.beginBit;
+	const uint8_t shift = bit % 8;
+	for (size_t byte = bit / 8; bit + 8 <= segment.endBit; bit += 8, ++byte) {
+		if (shift == 0) {
+			stream.push_back(window[byte]);
+		} else {
+			stream.push_back((char) ((window[byte] << shift) | (window[byte+1] >> (8 - shift))));
+		}
+	}
+
+	uint64_t pending = 0;
+	uint8_t numPending = 0;
+	auto put = [&](uint64_t value, uint8_t numBits) {
+		pending = (pending << numBits) | (value & ((1ULL << numBits) - 1));
+		numPending += numBits;
+		while (numPending >= 8) {
+			numPending -= 8;
+			stream.push_back((char) (pending >> numPending));
+		}
+	};
+
+	const uint8_t remainingBits = segment.endBit - bit;
+	if (remainingBits > 0) {
+		put(readBits(bit, remainingBits), remainingBits);
+	}
+	put(endOfStreamMagic >> 24, 24);
+	put(endOfStreamMagic, 24);
+	put(readBits(segment.beginBit + 48, 32), 32);
+	if (numPending > 0) {
+		stream.push_back((char) (pending << (8 - numPending)));
+	}
+
+	return stream;
+}
+
+bool ParallelBzip2Streambuf::decompress(const Segment &segment, std::string &data) const {
+	std::string stream = buildStream(segment);
+
+	bz_stream bz;
+	std::memset(&bz, 0, sizeof(bz));
+	if (BZ2_bzDecompressInit(&bz, 0, 0) != BZ_OK) return false;
+
+	bz.next_in = &stream[0];
+	bz.avail_in = stream.size();
+	data.resize(std::max<size_t>(8 * stream.size(), 1 << 16));
+	size_t produced = 0;
+	int status = BZ_OK;
+	while (status == BZ_OK) {
+		if (produced == data.size()) {
+			data.resize(2 * data.size());
+		}
+		bz.next_out = &data[produced];
+		bz.avail_out = data.size() - produced;
+
+		const size_t producedBefore = produced;
+		const unsigned int availableBefore = bz.avail_in;
+		status = BZ2_bzDecompress(&bz);
+		produced = data.size() - bz.avail_out;
+		if (status == BZ_OK && produced == producedBefore && bz.avail_in == availableBefore) break;
+	}
+	BZ2_bzDecompressEnd(&bz);
+
+	data.resize(produced);
+	return status == BZ_STREAM_END;
+}
+
+uint64_t ParallelBzip2Streambuf::readBits(uint64_t bit, uint8_t numBits) const {
+	uint64_t value = 0;
+	for (uint64_t b = bit; b < bit + numBits; ++b) {
+		value = (value << 1) | ((window[b / 8] >> (7 - b % 8)) & 1);
+	}
+	return value;
+}
+
+} /* namespace CRP */
@@ -0,0 +1,113 @@
+/*
+ * ParallelBzip2Streambuf.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_PARALLELBZIP2STREAMBUF_H_
+#define IO_PARALLELBZIP2STREAMBUF_H_
+
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace CRP {
+
+/**
+ * Input stream buffer that decompresses a bzip2 file with several threads.
+ *
+ * The blocks of a bzip2 stream are compressed independently and start with a 48 bit magic number
+ * at an arbitrary bit position. The compressed input is read in windows, the block boundaries in a
+ * window are found by scanning for the magic numbers, and every complete block is rewritten as a
+ * standalone single-block stream that libbz2 decompresses on its own. The blocks of a window are
+ * decompressed in parallel and handed out in file order. Concatenated streams (as written by pbzip2)
+ * are supported.
+ *
+ * The magic number can occur by chance inside the compressed data. A block that fails to decompress
+ * is therefore merged with its successor and decompressed serially before the file is considered corrupt.
+ */
+class ParallelBzip2Streambuf : public std::streambuf {
+public:
+	/**
+	 * @param compressed the bzip2 compressed input, read sequentially
+	 */
+	explicit ParallelBzip2Streambuf(std::istream &compressed);
+
+	/** @return true if the input is not a valid bzip2 file; the stream ends at the last good block. */
+	inline bool failed() const {
+		return error;
+	}
+
+protected:
+	int_type underflow();
+
+private:
+	enum MarkType : uint8_t {
+		BLOCK,
+		END_OF_STREAM
+	};
+
+	// position of a magic number in bits relative to the start of the window
+	struct Mark {
+		uint64_t bit;
+		MarkType type;
+	};
+
+	struct Segment {
+		uint64_t beginBit;
+		uint64_t endBit;
+		uint8_t level;
+	};
+
+	static const uint64_t blockMagic = 0x314159265359ULL;
+	static const uint64_t endOfStreamMagic = 0x177245385090ULL;
+	static const size_t windowSizePerThread = 1 << 21;
+
+	std::istream &input;
+	bool inputDone;
+	bool error;
+
+	// compressed data, the first unprocessed block starts at firstBit
+	std::vector<uint8_t> window;
+	uint64_t firstBit;
+	size_t scannedBytes;
+	std::vector<Mark> marks;
+	uint8_t level;
+
+	std::string output;
+
+	bool readStreamHeader(size_t byte, uint8_t &streamLevel) const;
+	void fillWindow();
+	void scanWindow();
+	bool nextSegments(std::vector<Segment> &segments);
+	std::string buildStream(const Segment &segment) const;
+	bool decompress(const Segment &segment, std::string &data) const;
+	uint64_t readBits(uint64_t bit, uint8_t numBits) const;
+};
+
+} /* namespace CRP */
+
+#endif /* IO_PARALLELBZIP2STREAMBUF_H_ */
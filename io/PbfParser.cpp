@@ -0,0 +1,416 @@
+/*
+ * PbfParser.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "PbfParser.h"
+
+#include <zlib.h>
+#include <iostream>
+
+#include "omp.h"
+#include "ProtobufReader.h"
+
+namespace CRP {
+
+namespace {
+const uint32_t MAX_BLOB_HEADER_SIZE = 64 * 1024;
+const uint32_t MAX_BLOB_SIZE = 32 * 1024 * 1024;
+}
+
+bool PbfParser::parse(const std::string &inputFileName, OSMParser &osmParser) {
+	std::ifstream file(inputFileName, std::ios::binary);
+	if (!file.is_open()) {
+		std::cout << "Could not open " << inputFileName << std::endl;
+		return false;
+	}
+
+	const count batchSize = 8 * omp_get_max_threads();
+	std::vector<Blob> blobs;
+	std::vector<DecodedBlock> blocks;
+	std::vector<char> decoded;
+	bool endOfFile = false;
+	count numBlocks = 0;
+
+	while (!endOfFile) {
+		blobs.clear();
+		while (blobs.size() < batchSize) {
+			Blob blob;
+			if (!readBlob(file, blob, endOfFile)) {
+				std::cout << "Could not read block " << numBlocks + blobs.size() << std::endl;
+				return false;
+			}
+			if (endOfFile) break;
+			blobs.push_back(std::move(blob));
+		}
+
+		blocks.assign(blobs.size(), DecodedBlock());
+		decoded.assign(blobs.size(), false);
+#pragma omp parallel for schedule(dynamic)
+		for (index i = 0; i < blobs.size(); ++i) {
+			decoded[i] = decodeBlob(blobs[i], blocks[i]);
+			std::string().swap(blobs[i].data);
+		}
+
+		for (index i = 0; i < blocks.size(); ++i) {
+			if (!decoded[i]) {
+				std::cout << "Could not decode block " << numBlocks + i << std::endl;
+				return false;
+			}
+			dispatch(blocks[i], osmParser);
+		}
+		numBlocks += blocks.size();
+	}
+
+	std::cout << "Read " << numBlocks << " blocks" << std::endl;
+	return true;
+}
+
+bool PbfParser::readBlob(std::ifstream &file, Blob &blob, bool &endOfFile) const {
+	unsigned char lengthBytes[4];
+	file.read(reinterpret_cast<char*>(lengthBytes), 4);
+	if (file.gcount() == 0 && file.eof()) {
+		endOfFile = true;
+		return true;
+	}
+	if (file.gcount() != 4) return false;
+
+	const uint32_t headerSize = (lengthBytes[0] << 24) | (lengthBytes[1] << 16) | (lengthBytes[2] << 8) | lengthBytes[3];
+	if (headerSize > MAX_BLOB_HEADER_SIZE) return false;
+	std::string header(headerSize, '\0');
+	if (!file.read(&header[0], headerSize)) return false;
+
+	uint64_t dataSize = 0;
+	ProtobufReader headerReader(header.data(), header.size());
+	while (headerReader.next()) {
+		switch (headerReader.getFieldNumber()) {
+		case 1:
+			blob.type = headerReader.getString();
+			break;
+		case 3:
+			dataSize = headerReader.getVarint();
+			break;
+		default:
+			headerReader.skip();
+		}
+	}
+	if (headerReader.hasError() || dataSize > MAX_BLOB_SIZE) return false;
+
+	blob.data.resize(dataSize);
+	return dataSize == 0 || static_cast<bool>(file.read(&blob.data[0], dataSize));
+}
+
+bool PbfParser::decodeBlob(const Blob &blob, DecodedBlock &block) const {
+	if (blob.type != "OSMHeader" && blob.type != "OSMData") return true; // unknown blobs are skipped
+
+	std::string data;
+	if (!decompress(blob.data, data)) return false;
+
+	if (blob.type == "OSMHeader") {
+		return decodeHeaderBlock(data);
+	}
+	return decodePrimitiveBlock(data, block);
+}
+
+bool PbfParser::decompress(const std::string &blob, std::string &data) const {
+	const char *compressed = nullptr;
+	size_t compressedSize = 0;
+	uint64_t rawSize = 0;
+	bool raw = false;
+
+	ProtobufReader reader(blob.data(), blob.size());
+	while (reader.next()) {
+		switch (reader.getFieldNumber()) {
+		case 1:
+			data = reader.getString();
+			raw = true;
+			break;
+		case 2:
+			rawSize = reader.getVarint();
+			break;
+		case 3:
+			reader.getBytes(compressed, compressedSize);
+			break;
+		case 4:
+		case 5:
+		case 6:
+		case 7:
+			std::cout << "Unsupported compression of PBF block" << std::endl;
+			return false;
+		default:
+			reader.skip();
+		}
+	}
+	if (reader.hasError()) return false;
+	if (raw) return true;
+	if (compressed == nullptr || rawSize > MAX_BLOB_SIZE) return false;
+
+	data.resize(rawSize);
+	uLongf size = rawSize;
+	if (rawSize > 0 && uncompress(reinterpret_cast<Bytef*>(&data[0]), &size, reinterpret_cast<const Bytef*>(compressed), compressedSize) != Z_OK) {
+		return false;
+	}
+	return size == rawSize;
+}
+
+bool PbfParser::decodeHeaderBlock(const std::string &data) const {
+	ProtobufReader reader(data.data(), data.size());
+	while (reader.next()) {
+		if (reader.getFieldNumber() == 4) {
+			std::string feature = reader.getString();
+			if (feature != "OsmSchema-V0.6" && feature != "DenseNodes") {
+				std::cout << "Unsupported PBF feature " << feature << std::endl;
+				return false;
+			}
+		} else {
+			reader.skip();
+		}
+	}
+	return !reader.hasError();
+}
+
+bool PbfParser::decodePrimitiveBlock(const std::string &data, DecodedBlock &block) const {
+	int64_t granularity = 100;
+	int64_t latOffset = 0;
+	int64_t lonOffset = 0;
+	std::vector<ProtobufReader> groups;
+
+	ProtobufReader reader(data.data(), data.size());
+	while (reader.next()) {
+		switch (reader.getFieldNumber()) {
+		case 1: {
+			ProtobufReader stringTable = reader.getMessage();
+			while (stringTable.next()) {
+				if (stringTable.getFieldNumber() == 1) {
+					block.strings.push_back(stringTable.getString());
+				} else {
+					stringTable.skip();
+				}
+			}
+			if (stringTable.hasError()) return false;
+			break;
+		}
+		case 2:
+			groups.push_back(reader.getMessage());
+			break;
+		case 17:
+			granularity = reader.getVarint();
+			break;
+		case 19:
+			latOffset = reader.getVarint();
+			break;
+		case 20:
+			lonOffset = reader.getVarint();
+			break;
+		default:
+			reader.skip();
+		}
+	}
+	if (reader.hasError()) return false;
+
+	const count numStrings = block.strings.size();
+	auto toCoordinate = [&](int64_t value, int64_t offset) {
+		return (float) (1e-9 * (offset + granularity * value));
+	};
+	auto readTags = [&](std::vector<uint64_t> &keys, std::vector<uint64_t> &values, std::vector<Tag> &tags) {
+		if (keys.size() != values.size()) return false;
+		for (index i = 0; i < keys.size(); ++i) {
+			if (keys[i] >= numStrings || values[i] >= numStrings) return false;
+			tags.push_back(Tag(keys[i], values[i]));
+		}
+		return true;
+	};
+
+	std::vector<uint64_t> keys;
+	std::vector<uint64_t> values;
+	for (ProtobufReader &group : groups) {
+		while (group.next()) {
+			const uint32_t field = group.getFieldNumber();
+			if (field == 1) {
+				// a single node
+				Node node = {0, 0, 0};
+				ProtobufReader nodeReader = group.getMessage();
+				while (nodeReader.next()) {
+					switch (nodeReader.getFieldNumber()) {
+					case 1:
+						node.id = nodeReader.getSignedVarint();
+						break;
+					case 8:
+						node.lat = toCoordinate(nodeReader.getSignedVarint(), latOffset);
+						break;
+					case 9:
+						node.lon = toCoordinate(nodeReader.getSignedVarint(), lonOffset);
+						break;
+					default:
+						nodeReader.skip();
+					}
+				}
+				if (nodeReader.hasError()) return false;
+				block.nodes.push_back(node);
+				block.groups.push_back(std::make_pair(NODES, 1));
+			} else if (field == 2) {
+				// dense nodes, all values are delta coded
+				std::vector<int64_t> ids, lats, lons;
+				auto deltaDecode = [](std::vector<int64_t> &decodedValues) {
+					return [&decodedValues](uint64_t value) {
+						int64_t delta = ProtobufReader::decodeZigZag(value);
+						decodedValues.push_back(decodedValues.empty() ? delta : decodedValues.back() + delta);
+					};
+				};
+				ProtobufReader dense = group.getMessage();
+				while (dense.next()) {
+					switch (dense.getFieldNumber()) {
+					case 1:
+						dense.forPackedVarints(deltaDecode(ids));
+						break;
+					case 8:
+						dense.forPackedVarints(deltaDecode(lats));
+						break;
+					case 9:
+						dense.forPackedVarints(deltaDecode(lons));
+						break;
+					default:
+						dense.skip();
+					}
+				}
+				if (dense.hasError() || ids.size() != lats.size() || ids.size() != lons.size()) return false;
+				for (index i = 0; i < ids.size(); ++i) {
+					block.nodes.push_back({(Id) ids[i], toCoordinate(lats[i], latOffset), toCoordinate(lons[i], lonOffset)});
+				}
+				block.groups.push_back(std::make_pair(NODES, ids.size()));
+			} else if (field == 3) {
+				Way way;
+				way.id = 0;
+				keys.clear();
+				values.clear();
+				ProtobufReader wayReader = group.getMessage();
+				while (wayReader.next()) {
+					switch (wayReader.getFieldNumber()) {
+					case 1:
+						way.id = wayReader.getVarint();
+						break;
+					case 2:
+						wayReader.forPackedVarints([&](uint64_t key) { keys.push_back(key); });
+						break;
+					case 3:
+						wayReader.forPackedVarints([&](uint64_t value) { values.push_back(value); });
+						break;
+					case 8: {
+						int64_t ref = 0;
+						wayReader.forPackedVarints([&](uint64_t value) {
+							ref += ProtobufReader::decodeZigZag(value);
+							way.nodes.push_back(ref);
+						});
+						break;
+					}
+					default:
+						wayReader.skip();
+					}
+				}
+				if (wayReader.hasError() || !readTags(keys, values, way.tags)) return false;
+				block.ways.push_back(std::move(way));
+				block.groups.push_back(std::make_pair(WAYS, 1));
+			} else if (field == 4) {
+				Relation relation;
+				std::vector<uint64_t> roles;
+				keys.clear();
+				values.clear();
+				ProtobufReader relationReader = group.getMessage();
+				while (relationReader.next()) {
+					switch (relationReader.getFieldNumber()) {
+					case 2:
+						relationReader.forPackedVarints([&](uint64_t key) { keys.push_back(key); });
+						break;
+					case 3:
+						relationReader.forPackedVarints([&](uint64_t value) { values.push_back(value); });
+						break;
+					case 8:
+						relationReader.forPackedVarints([&](uint64_t role) { roles.push_back(role); });
+						break;
+					case 9: {
+						int64_t ref = 0;
+						relationReader.forPackedVarints([&](uint64_t value) {
+							ref += ProtobufReader::decodeZigZag(value);
+							relation.members.push_back({(Id) ref, 0});
+						});
+						break;
+					}
+					default:
+						relationReader.skip();
+					}
+				}
+				if (relationReader.hasError() || roles.size() != relation.members.size() || !readTags(keys, values, relation.tags)) return false;
+				for (index i = 0; i < roles.size(); ++i) {
+					if (roles[i] >= numStrings) return false;
+					relation.members[i].role = roles[i];
+				}
+				block.relations.push_back(std::move(relation));
+				block.groups.push_back(std::make_pair(RELATIONS, 1));
+			} else {
+				group.skip();
+			}
+		}
+		if (group.hasError()) return false;
+	}
+
+	return true;
+}
+
+void PbfParser::dispatch(const DecodedBlock &block, OSMParser &osmParser) const {
+	index nextNode = 0;
+	index nextWay = 0;
+	index nextRelation = 0;
+	for (const auto &group : block.groups) {
+		if (group.first == NODES) {
+			for (index i = nextNode; i < nextNode + group.second; ++i) {
+				const Node &node = block.nodes[i];
+				osmParser.addNode(node.id, node.lat, node.lon);
+			}
+			nextNode += group.second;
+		} else if (group.first == WAYS) {
+			const Way &way = block.ways[nextWay++];
+			osmParser.startWay(way.id);
+			for (Id node : way.nodes) {
+				osmParser.addWayNode(node);
+			}
+			for (const Tag &tag : way.tags) {
+				osmParser.addWayTag(block.strings[tag.first], block.strings[tag.second]);
+			}
+			osmParser.endWay();
+		} else {
+			const Relation &relation = block.relations[nextRelation++];
+			osmParser.startRelation();
+			for (const Member &member : relation.members) {
+				osmParser.addRelationMember(member.ref, block.strings[member.role]);
+			}
+			for (const Tag &tag : relation.tags) {
+				osmParser.addRelationTag(block.strings[tag.first], block.strings[tag.second]);
+			}
+			osmParser.endRelation();
+		}
+	}
+}
+
+} /* namespace CRP */
@@ -0,0 +1,108 @@
+/*
+ * PbfParser.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_PBFPARSER_H_
+#define IO_PBFPARSER_H_
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OSMParser.h"
+
+namespace CRP {
+
+/**
+ * Reads OSM PBF files and sends their nodes, ways and relations to an @ref OSMParser. The blocks of the file
+ * are decompressed and decoded in parallel in batches, the events are sent in the order of the file.
+ * Only zlib compressed and uncompressed blocks are supported.
+ */
+class PbfParser {
+public:
+	PbfParser() = default;
+
+	/**
+	 * Parses @a inputFileName and sends all elements to @a osmParser.
+	 * @param inputFileName the PBF file
+	 * @param osmParser receives the events
+	 * @return false if the file could not be read or is malformed
+	 */
+	bool parse(const std::string &inputFileName, OSMParser &osmParser);
+
+private:
+	typedef std::pair<uint32_t, uint32_t> Tag; // indices into the string table of the block
+
+	struct Blob {
+		std::string type;
+		std::string data;
+	};
+
+	struct Node {
+		Id id;
+		float lat;
+		float lon;
+	};
+
+	struct Way {
+		Id id;
+		std::vector<Id> nodes;
+		std::vector<Tag> tags;
+	};
+
+	struct Member {
+		Id ref;
+		uint32_t role;
+	};
+
+	struct Relation {
+		std::vector<Member> members;
+		std::vector<Tag> tags;
+	};
+
+	enum GROUP_TYPE {NODES, WAYS, RELATIONS};
+
+	struct DecodedBlock {
+		std::vector<std::string> strings;
+		std::vector<Node> nodes;
+		std::vector<Way> ways;
+		std::vector<Relation> relations;
+		// type and number of elements of the primitive groups in the order of the block
+		std::vector<std::pair<GROUP_TYPE, count>> groups;
+	};
+
+	bool readBlob(std::ifstream &file, Blob &blob, bool &endOfFile) const;
+	bool decodeBlob(const Blob &blob, DecodedBlock &block) const;
+	bool decompress(const std::string &blob, std::string &data) const;
+	bool decodeHeaderBlock(const std::string &data) const;
+	bool decodePrimitiveBlock(const std::string &data, DecodedBlock &block) const;
+	void dispatch(const DecodedBlock &block, OSMParser &osmParser) const;
+};
+
+} /* namespace CRP */
+
+#endif /* IO_PBFPARSER_H_ */
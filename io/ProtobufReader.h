@@ -0,0 +1,191 @@
+/*
+ * ProtobufReader.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_PROTOBUFREADER_H_
+#define IO_PROTOBUFREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CRP {
+
+/**
+ * Minimal reader for the protocol buffers wire format. It iterates over the fields of one message
+ * without copying, nested messages and packed repeated fields are read with new readers on the same memory.
+ * Malformed input sets an error flag and ends the iteration.
+ */
+class ProtobufReader {
+public:
+	enum WIRE_TYPE {VARINT = 0, FIXED64 = 1, LENGTH_DELIMITED = 2, FIXED32 = 5};
+
+	ProtobufReader() : pos(nullptr), end(nullptr), fieldNumber(0), wireType(0), error(false) {}
+	ProtobufReader(const char *data, size_t size) : pos(reinterpret_cast<const uint8_t*>(data)),
+			end(reinterpret_cast<const uint8_t*>(data) + size), fieldNumber(0), wireType(0), error(false) {}
+
+	/**
+	 * Advances to the next field. Its value has to be read or skipped before calling next() again.
+	 * @return false at the end of the message or if the message is malformed
+	 */
+	inline bool next() {
+		if (error || pos >= end) return false;
+		uint64_t key = readVarint();
+		fieldNumber = static_cast<uint32_t>(key >> 3);
+		wireType = static_cast<uint32_t>(key & 7);
+		return !error;
+	}
+
+	inline uint32_t getFieldNumber() const {
+		return fieldNumber;
+	}
+
+	inline uint32_t getWireType() const {
+		return wireType;
+	}
+
+	inline bool hasError() const {
+		return error;
+	}
+
+	inline uint64_t getVarint() {
+		if (wireType != VARINT) return fail();
+		return readVarint();
+	}
+
+	/** Reads a zigzag encoded sint32 or sint64. */
+	inline int64_t getSignedVarint() {
+		return decodeZigZag(getVarint());
+	}
+
+	/** Returns the value of a length delimited field as a reader. */
+	inline ProtobufReader getMessage() {
+		const char *data;
+		size_t size;
+		getBytes(data, size);
+		return ProtobufReader(data, size);
+	}
+
+	inline void getBytes(const char *&data, size_t &size) {
+		size = 0;
+		data = reinterpret_cast<const char*>(pos);
+		if (wireType != LENGTH_DELIMITED) {
+			fail();
+			return;
+		}
+		uint64_t length = readVarint();
+		if (error || length > static_cast<uint64_t>(end - pos)) {
+			fail();
+			return;
+		}
+		data = reinterpret_cast<const char*>(pos);
+		size = length;
+		pos += length;
+	}
+
+	inline std::string getString() {
+		const char *data;
+		size_t size;
+		getBytes(data, size);
+		return std::string(data, size);
+	}
+
+	inline void skip() {
+		switch (wireType) {
+		case VARINT:
+			readVarint();
+			break;
+		case FIXED64:
+			advance(8);
+			break;
+		case LENGTH_DELIMITED: {
+			const char *data;
+			size_t size;
+			getBytes(data, size);
+			break;
+		}
+		case FIXED32:
+			advance(4);
+			break;
+		default:
+			fail();
+		}
+	}
+
+	/**
+	 * Calls @a handle for every value of a packed repeated varint field.
+	 * @param handle must handle an uint64_t
+	 */
+	template<typename L>
+	bool forPackedVarints(L handle) {
+		ProtobufReader packed = getMessage();
+		while (!packed.error && packed.pos < packed.end) {
+			uint64_t value = packed.readVarint();
+			if (!packed.error) handle(value);
+		}
+		error |= packed.error;
+		return !error;
+	}
+
+	static inline int64_t decodeZigZag(uint64_t value) {
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+private:
+	const uint8_t *pos;
+	const uint8_t *end;
+	uint32_t fieldNumber;
+	uint32_t wireType;
+	bool error;
+
+	inline uint64_t readVarint() {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+			const uint8_t byte = *pos++;
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) return value;
+		}
+		return fail();
+	}
+
+	inline void advance(size_t bytes) {
+		if (bytes > static_cast<size_t>(end - pos)) {
+			fail();
+			return;
+		}
+		pos += bytes;
+	}
+
+	inline uint64_t fail() {
+		error = true;
+		pos = end;
+		return 0;
+	}
+};
+
+} /* namespace CRP */
+
+#endif /* IO_PROTOBUFREADER_H_ */
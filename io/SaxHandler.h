@@ -32,11 +32,14 @@
 #include <vector>
 #include <unordered_map>
 
+#include "StringRef.h"
+
 namespace CRP {
 
+/** Attribute name and raw value; both point into the parser's buffer. */
 struct Attribute {
-	std::string qName;
-	std::string value;
+	StringRef qName;
+	StringRef value;
 };
 
 class SaxHandler {
@@ -53,9 +56,9 @@ public:
 	 * @param uri TODO
 	 * @param localName TODO
 	 * @param qName The qualified name (with prefix), or the empty string if qualified names are not available.
-	 * @param attributes The attributes attached to this element.
+	 * @param attributes The attributes attached to this element. The names and values are only valid during the call.
 	 */
-	virtual void startElement(const std::string &uri, const std::string &localName, const std::string &qName, const std::vector<Attribute> &attributes) {}
+	virtual void startElement(const StringRef &uri, const StringRef &localName, const StringRef &qName, const std::vector<Attribute> &attributes) {}
 
 	/**
 	 * Receive notification of the end of an element.
@@ -63,7 +66,7 @@ public:
 	 * @param localName TODO
 	 * @param qName The qualified name (with prefix), or the empty string if qualified names are not available.
 	 */
-	virtual void endElement(const std::string &uri, const std::string &localName, const std::string &qName) {}
+	virtual void endElement(const StringRef &uri, const StringRef &localName, const StringRef &qName) {}
 };
 
 } /* namespace CRP */
@@ -26,43 +26,36 @@
  */
 
 #include "SaxParser.h"
+#include "ParallelBzip2Streambuf.h"
 #include "../constants.h"
 
 #include <fstream>
-#include <sstream>
 #include <iostream>
-
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
+#include <cstring>
 
 namespace CRP {
 
-bool SaxParser::parse(const std::string &inputFileName, SaxHandler &handler) {
-	std::ifstream file;
-	file.open(inputFileName);
-	if (!file.is_open()) return false;
+static inline bool isWhiteSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
 
-	std::string line;
-	bool ok = false;
-	while (!file.eof()) {
-		std::getline(file, line);
-		//std::cout << line << std::endl;
-		ok = parseLine(line, handler);
-		if (!ok) {
-			std::cout << "error in line " << line << std::endl;
-			break;
-		}
+// returns the first occurrence of pattern in [begin, end) or nullptr
+static inline const char* findPattern(const char *begin, const char *end, const char *pattern, size_t patternLength) {
+	while (end - begin >= (std::ptrdiff_t) patternLength) {
+		const char *candidate = static_cast<const char*>(std::memchr(begin, pattern[0], end - begin - patternLength + 1));
+		if (candidate == nullptr) return nullptr;
+		if (std::memcmp(candidate, pattern, patternLength) == 0) return candidate;
+		begin = candidate + 1;
 	}
+	return nullptr;
+}
 
-	file.close();
-
-	std::cout << "ElementStack: " << elementStack.size() << std::endl;
-	for (unsigned i = 0; i < elementStack.size(); ++i) {
-		Element e = elementStack.top(); elementStack.pop();
-		std::cout << e.qName << std::endl;
-	}
+bool SaxParser::parse(const std::string &inputFileName, SaxHandler &handler) {
+	std::ifstream file(inputFileName, std::ios_base::in | std::ios_base::binary);
+	if (!file.is_open()) return false;
 
-	ok = ok && elementStack.size() == 0;
+	bool ok = parseStream(file, handler);
+	file.close();
 
 	return ok;
 }
@@ -71,118 +64,182 @@ bool SaxParser::parseBZ2(const std::string &inputFileName, SaxHandler &handler)
 	std::ifstream file(inputFileName, std::ios_base::in | std::ios_base::binary);
 	if (!file.is_open()) return false;
 
-	boost::iostreams::filtering_streambuf<boost::iostreams::input> inbuf;
-	inbuf.push(boost::iostreams::bzip2_decompressor());
-	inbuf.push(file);
-
-	std::string line;
+	ParallelBzip2Streambuf inbuf(file);
 	std::istream instream(&inbuf);
-	bool ok = false;
-	while (std::getline(instream, line)) {
-		ok = parseLine(line, handler);
-		if (!ok) {
-			std::cout << "error in line " << line << std::endl;
-			break;
-		}
-	}
-
+	bool ok = parseStream(instream, handler) && !inbuf.failed();
 	file.close();
 
-	std::cout << "ElementStack: " << elementStack.size() << std::endl;
-	for (unsigned i = 0; i < elementStack.size(); ++i) {
-		Element e = elementStack.top(); elementStack.pop();
-		std::cout << e.qName << std::endl;
-	}
-
-	ok = ok && elementStack.size() == 0;
-
 	return ok;
 }
 
-bool SaxParser::parseLine(std::string &line, SaxHandler &handler) {
-	// remove front white space
-	index frontWhiteSpace = 0;
-	for (; frontWhiteSpace < line.size(); ++frontWhiteSpace) {
-		if (line[frontWhiteSpace] != ' ' && line[frontWhiteSpace] != '\t') break;
-	}
-
-	line = line.substr(frontWhiteSpace);
-
-	if (line.size() == 0) return true; // line is empty
-
-	if (stringStartsWith(line, "</")) { // end element
-		Element e = elementStack.top(); elementStack.pop();
-		handler.endElement(e.uri, e.localName, e.qName);
-	} else { // start element
-		std::string qName;
-		std::vector<Attribute> attributes;
-		bool isEmpty = false;
-
-		unsigned idx = 1;
-		for (; idx < line.size(); ++idx) {
-			if (line[idx] == ' ' || line[idx] == '\t' || line[idx] == '>') {
-				while (line[idx] == ' ' || line[idx] == '\t') {
-					idx++;
-				}
+bool SaxParser::parseStream(std::istream &stream, SaxHandler &handler) {
+	elementNames.clear();
+	elementNameOffsets.clear();
+
+	// [begin, end) is the unparsed part of the buffer, consumed counts the bytes already shifted out
+	std::vector<char> buffer(initialBufferSize);
+	size_t begin = 0;
+	size_t end = 0;
+	size_t consumed = 0;
+	bool eof = false;
+	bool ok = true;
+
+	while (true) {
+		const char *open = static_cast<const char*>(std::memchr(buffer.data() + begin, '<', end - begin));
+		if (open == nullptr) {
+			// only character data left, which is not reported
+			begin = end;
+		} else {
+			begin = open - buffer.data();
+			const char *next;
+			TokenStatus status = parseElement(open, buffer.data() + end, next, handler);
+			if (status == TOKEN_OK) {
+				begin = next - buffer.data();
+				continue;
+			} else if (status == TOKEN_ERROR) {
+				const char *lineEnd = static_cast<const char*>(std::memchr(open, '\n', end - begin));
+				std::cout << "error at byte " << consumed + begin << ": " << StringRef(open, (lineEnd == nullptr ? buffer.data() + end : lineEnd) - open) << std::endl;
+				ok = false;
 				break;
-			} else if (line[idx] == '?') {
-				// do nothing
-			} else {
-				qName += line[idx];
 			}
 		}
 
-		//std::cout << line << std::endl;
-		//std::cout << qName << std::endl;
-		bool doubleQuotes = true;
-		
-		Attribute curAttribute;
-		while (idx < line.size()) {
-			while (line[idx] == ' ') {
-				idx++;
-			}
-
-			if ((line[idx] == '/' && line[idx+1] == '>') || line[idx] == '?') {
-				handler.startElement("", "", qName, attributes);
-				handler.endElement("", "", qName);
-				isEmpty = true;
-				break;
-			} else if (line[idx] == '>') {
-				break;
+		if (eof) {
+			if (begin != end) {
+				std::cout << "error: unexpected end of file at byte " << consumed + begin << std::endl;
+				ok = false;
 			}
+			break;
+		}
 
-			// key
-			std::stringstream keyStream;
-			while (line[idx] != '=') {
-				keyStream << line[idx++];
-			}
-			idx++;
-			curAttribute.qName = keyStream.str();
+		// move the unfinished element to the front and refill the rest of the buffer
+		if (begin > 0) {
+			std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+			consumed += begin;
+			end -= begin;
+			begin = 0;
+		}
+		if (end == buffer.size()) {
+			buffer.resize(2 * buffer.size());
+		}
+		stream.read(buffer.data() + end, buffer.size() - end);
+		const std::streamsize numRead = stream.gcount();
+		if (numRead <= 0) {
+			eof = true;
+		} else {
+			end += numRead;
+		}
+	}
 
-			// value
-			if (line[idx] != '"' && line[idx] != '\'') {
-				return false;
-			}
-			doubleQuotes = line[idx] == '"';
-			idx++;
+	if (!elementNameOffsets.empty()) {
+		std::cout << "ElementStack: " << elementNameOffsets.size() << std::endl;
+		for (size_t i = elementNameOffsets.size(); i > 0; --i) {
+			const size_t nameEnd = i == elementNameOffsets.size() ? elementNames.size() : elementNameOffsets[i];
+			std::cout << StringRef(elementNames.data() + elementNameOffsets[i-1], nameEnd - elementNameOffsets[i-1]) << std::endl;
+		}
+	}
 
-			std::stringstream valStream;
-			while ((doubleQuotes && line[idx] != '"') || (!doubleQuotes && line[idx] != '\'')) {
-				valStream << line[idx++];
-			}
-			idx++;
-			curAttribute.value = valStream.str();
+	return ok && elementNameOffsets.empty();
+}
 
-			attributes.push_back(curAttribute);
+SaxParser::TokenStatus SaxParser::parseElement(const char *begin, const char *end, const char *&next, SaxHandler &handler) {
+	if (end - begin < 2) return TOKEN_INCOMPLETE;
+
+	if (begin[1] == '/') {
+		return parseEndElement(begin, end, next, handler);
+	} else if (begin[1] == '?') {
+		// processing instruction like the xml declaration
+		const char *close = findPattern(begin + 2, end, "?>", 2);
+		if (close == nullptr) return TOKEN_INCOMPLETE;
+		next = close + 2;
+		return TOKEN_OK;
+	} else if (begin[1] == '!') {
+		if (end - begin < 4) return TOKEN_INCOMPLETE;
+		const char *close;
+		if (begin[2] == '-' && begin[3] == '-') {
+			close = findPattern(begin + 4, end, "-->", 3);
+			if (close == nullptr) return TOKEN_INCOMPLETE;
+			next = close + 3;
+		} else {
+			// doctype declaration
+			close = static_cast<const char*>(std::memchr(begin + 2, '>', end - begin - 2));
+			if (close == nullptr) return TOKEN_INCOMPLETE;
+			next = close + 1;
 		}
+		return TOKEN_OK;
+	}
+
+	return parseStartElement(begin, end, next, handler);
+}
 
-		if (!isEmpty) {
-			handler.startElement("", "", qName, attributes);
-			elementStack.push({"", "", qName});
+SaxParser::TokenStatus SaxParser::parseStartElement(const char *begin, const char *end, const char *&next, SaxHandler &handler) {
+	// the handler is only called once the whole element is in the buffer, so an incomplete element can be retried after a refill
+	const char *pos = begin + 1;
+	while (pos < end && !isWhiteSpace(*pos) && *pos != '/' && *pos != '>') ++pos;
+	if (pos == end) return TOKEN_INCOMPLETE;
+	if (pos == begin + 1) return TOKEN_ERROR;
+	const StringRef qName(begin + 1, pos - begin - 1);
+
+	attributes.clear();
+	while (true) {
+		while (pos < end && isWhiteSpace(*pos)) ++pos;
+		if (pos == end) return TOKEN_INCOMPLETE;
+
+		if (*pos == '>') {
+			handler.startElement(StringRef(), StringRef(), qName, attributes);
+			elementNameOffsets.push_back(elementNames.size());
+			elementNames.append(qName.data(), qName.size());
+			next = pos + 1;
+			return TOKEN_OK;
+		} else if (*pos == '/') {
+			if (pos + 1 == end) return TOKEN_INCOMPLETE;
+			if (pos[1] != '>') return TOKEN_ERROR;
+			handler.startElement(StringRef(), StringRef(), qName, attributes);
+			handler.endElement(StringRef(), StringRef(), qName);
+			next = pos + 2;
+			return TOKEN_OK;
 		}
+
+		// key
+		const char *keyBegin = pos;
+		while (pos < end && *pos != '=' && !isWhiteSpace(*pos) && *pos != '/' && *pos != '>') ++pos;
+		const char *keyEnd = pos;
+		while (pos < end && isWhiteSpace(*pos)) ++pos;
+		if (pos == end) return TOKEN_INCOMPLETE;
+		if (*pos != '=' || keyBegin == keyEnd) return TOKEN_ERROR;
+		++pos;
+
+		// value
+		while (pos < end && isWhiteSpace(*pos)) ++pos;
+		if (pos == end) return TOKEN_INCOMPLETE;
+		const char quote = *pos;
+		if (quote != '"' && quote != '\'') return TOKEN_ERROR;
+		const char *valueBegin = ++pos;
+		const char *valueEnd = static_cast<const char*>(std::memchr(valueBegin, quote, end - valueBegin));
+		if (valueEnd == nullptr) return TOKEN_INCOMPLETE;
+
+		attributes.push_back({StringRef(keyBegin, keyEnd - keyBegin), StringRef(valueBegin, valueEnd - valueBegin)});
+		pos = valueEnd + 1;
 	}
+}
 
-	return true;
+SaxParser::TokenStatus SaxParser::parseEndElement(const char *begin, const char *end, const char *&next, SaxHandler &handler) {
+	const char *close = static_cast<const char*>(std::memchr(begin + 2, '>', end - begin - 2));
+	if (close == nullptr) return TOKEN_INCOMPLETE;
+
+	const char *nameEnd = begin + 2;
+	while (nameEnd < close && !isWhiteSpace(*nameEnd)) ++nameEnd;
+	if (elementNameOffsets.empty()) return TOKEN_ERROR;
+
+	const size_t offset = elementNameOffsets.back();
+	const StringRef qName(elementNames.data() + offset, elementNames.size() - offset);
+	if (qName != StringRef(begin + 2, nameEnd - begin - 2)) return TOKEN_ERROR;
+
+	handler.endElement(StringRef(), StringRef(), qName);
+	elementNames.resize(offset);
+	elementNameOffsets.pop_back();
+	next = close + 1;
+	return TOKEN_OK;
 }
 
 bool SaxParser::stringStartsWith(const std::string &str, const std::string &prefix) {
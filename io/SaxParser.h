@@ -29,7 +29,8 @@
 #define IO_SAXPARSER_H_
 
 #include <string>
-#include <stack>
+#include <vector>
+#include <istream>
 
 #include "SaxHandler.h"
 
@@ -46,17 +47,28 @@ public:
 	static bool stringStartsWith(const std::string &str, const std::string &prefix);
 
 private:
-	struct Element {
-		std::string uri;
-		std::string localName;
-		std::string qName;
+	enum TokenStatus {
+		TOKEN_OK,
+		TOKEN_INCOMPLETE,
+		TOKEN_ERROR
 	};
 
-	std::stack<Element> elementStack;
+	static const size_t initialBufferSize = 1 << 22;
 
-	bool parseLine(std::string &line, SaxHandler &handler);
+	// names of the open elements, stored back to back so that pushing and popping does not allocate
+	std::string elementNames;
+	std::vector<size_t> elementNameOffsets;
 
+	// reused for every start element
+	std::vector<Attribute> attributes;
 
+	bool parseStream(std::istream &stream, SaxHandler &handler);
+
+	TokenStatus parseElement(const char *begin, const char *end, const char *&next, SaxHandler &handler);
+
+	TokenStatus parseStartElement(const char *begin, const char *end, const char *&next, SaxHandler &handler);
+
+	TokenStatus parseEndElement(const char *begin, const char *end, const char *&next, SaxHandler &handler);
 };
 
 } /* namespace CRP */
@@ -0,0 +1,152 @@
+/*
+ * StringRef.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_STRINGREF_H_
+#define IO_STRINGREF_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace CRP {
+
+/**
+ * Non-owning view of a character range. Used by the SaxParser to hand element names and
+ * attribute spans to the handler without copying them out of its read buffer, so a StringRef
+ * is only valid until the handler callback returns.
+ */
+class StringRef {
+public:
+	StringRef() : ptr(nullptr), length(0) {}
+	StringRef(const char *data, size_t size) : ptr(data), length(size) {}
+	StringRef(const char *str) : ptr(str), length(std::strlen(str)) {}
+	StringRef(const std::string &str) : ptr(str.data()), length(str.size()) {}
+
+	inline const char* data() const {
+		return ptr;
+	}
+
+	inline size_t size() const {
+		return length;
+	}
+
+	inline bool empty() const {
+		return length == 0;
+	}
+
+	inline char operator[](size_t i) const {
+		return ptr[i];
+	}
+
+	inline const char* begin() const {
+		return ptr;
+	}
+
+	inline const char* end() const {
+		return ptr + length;
+	}
+
+	inline bool operator==(const StringRef &other) const {
+		return length == other.length && (length == 0 || std::memcmp(ptr, other.ptr, length) == 0);
+	}
+
+	inline bool operator!=(const StringRef &other) const {
+		return !(*this == other);
+	}
+
+	inline bool operator==(const char *str) const {
+		return *this == StringRef(str);
+	}
+
+	inline bool operator!=(const char *str) const {
+		return !(*this == str);
+	}
+
+	inline bool startsWith(const StringRef &prefix) const {
+		return length >= prefix.length && (prefix.length == 0 || std::memcmp(ptr, prefix.ptr, prefix.length) == 0);
+	}
+
+	inline std::string toString() const {
+		return std::string(ptr, length);
+	}
+
+	/**
+	 * Parses a leading integer like std::stoll, but without allocating.
+	 * @return false if the view does not start with a number.
+	 */
+	inline bool toInteger(int64_t &value) const {
+		char buffer[maxNumberLength + 1];
+		if (!terminate(buffer)) return false;
+		char *numberEnd;
+		value = std::strtoll(buffer, &numberEnd, 10);
+		return numberEnd != buffer;
+	}
+
+	/**
+	 * Parses a leading floating point number like std::stof, but without allocating.
+	 * @return false if the view does not start with a number.
+	 */
+	inline bool toFloat(float &value) const {
+		char buffer[maxNumberLength + 1];
+		if (!terminate(buffer)) return false;
+		char *numberEnd;
+		value = std::strtof(buffer, &numberEnd);
+		return numberEnd != buffer;
+	}
+
+private:
+	static const size_t maxNumberLength = 63;
+
+	const char *ptr;
+	size_t length;
+
+	// copies the view into a zero terminated stack buffer for the C conversion functions
+	inline bool terminate(char *buffer) const {
+		if (length == 0 || length > maxNumberLength) return false;
+		std::memcpy(buffer, ptr, length);
+		buffer[length] = '\0';
+		return true;
+	}
+};
+
+inline bool operator==(const char *str, const StringRef &ref) {
+	return ref == str;
+}
+
+inline bool operator!=(const char *str, const StringRef &ref) {
+	return ref != str;
+}
+
+inline std::ostream& operator<<(std::ostream &os, const StringRef &ref) {
+	return os.write(ref.data(), ref.size());
+}
+
+} /* namespace CRP */
+
+#endif /* IO_STRINGREF_H_ */
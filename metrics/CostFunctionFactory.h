@@ -0,0 +1,104 @@
+/*
+ * CostFunctionFactory.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef METRICS_COSTFUNCTIONFACTORY_H_
+#define METRICS_COSTFUNCTIONFACTORY_H_
+
+#include <memory>
+#include <string>
+
+#include "CostFunction.h"
+#include "DistanceFunction.h"
+#include "HopFunction.h"
+#include "ProfileFunction.h"
+#include "TimeFunction.h"
+#include "TruckFunction.h"
+
+namespace CRP {
+
+/**
+ * Returns true if @a metricType refers to a speed profile file.
+ * @param metricType
+ */
+inline bool isProfileMetric(const std::string &metricType) {
+	const std::string suffix = ".profile";
+	return metricType.size() > suffix.size() && metricType.compare(metricType.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Returns true if @a metricType is a truck metric of the form truck:<height>.
+ * @param metricType
+ */
+inline bool isTruckMetric(const std::string &metricType) {
+	return metricType.compare(0, 6, "truck:") == 0;
+}
+
+/**
+ * Creates the cost function for @a metricType, which is one of hop, dist and time, truck:<height> for a
+ * TruckFunction with the given height in meters or the path to a speed profile file ending in .profile
+ * (see ProfileFunction).
+ * @param metricType
+ * @return the cost function or nullptr if @a metricType is unknown or the profile could not be read
+ */
+inline std::unique_ptr<CostFunction> createCostFunction(const std::string &metricType) {
+	if (metricType == "hop") {
+		return std::unique_ptr<CostFunction>(new HopFunction());
+	} else if (metricType == "dist") {
+		return std::unique_ptr<CostFunction>(new DistanceFunction());
+	} else if (metricType == "time") {
+		return std::unique_ptr<CostFunction>(new TimeFunction());
+	} else if (isTruckMetric(metricType)) {
+		try {
+			return std::unique_ptr<CostFunction>(new TruckFunction(std::stof(metricType.substr(6))));
+		} catch (...) {
+			return nullptr;
+		}
+	} else if (isProfileMetric(metricType)) {
+		std::unique_ptr<ProfileFunction> profile(new ProfileFunction());
+		if (ProfileFunction::read(metricType, *profile)) {
+			return std::move(profile);
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Returns the file name under which the metric of @a metricType is stored. This is the metric type itself,
+ * truck_<height> for truck metrics or the name of the profile file without directory and extension.
+ * @param metricType
+ */
+inline std::string getMetricName(const std::string &metricType) {
+	if (isTruckMetric(metricType)) return "truck_" + metricType.substr(6);
+	if (!isProfileMetric(metricType)) return metricType;
+	std::size_t begin = metricType.find_last_of("/\\");
+	begin = (begin == std::string::npos) ? 0 : begin + 1;
+	return metricType.substr(begin, metricType.size() - std::string(".profile").size() - begin);
+}
+
+} /* namespace CRP */
+
+#endif /* METRICS_COSTFUNCTIONFACTORY_H_ */
@@ -42,7 +42,9 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <algorithm>
 #include "../timer.h"
+#include "omp.h"
 
 namespace CRP {
 
@@ -57,82 +59,49 @@ struct IntVectorHasher {
 	}
 };
 
+/** Identifies a turn table by its offset and the degrees of the vertex it is used at. */
+struct TurnTableKey {
+	index turnTablePtr;
+	count inDegree;
+	count outDegree;
+
+	bool operator==(const TurnTableKey &other) const {
+		return turnTablePtr == other.turnTablePtr && inDegree == other.inDegree && outDegree == other.outDegree;
+	}
+};
+
+struct TurnTableKeyHasher {
+	std::size_t operator()(const TurnTableKey &key) const {
+		return (static_cast<std::size_t>(key.turnTablePtr) << 16) ^ (key.inDegree << 8) ^ key.outDegree;
+	}
+};
+
 class Metric {
 public:
 	Metric() = default;
-	Metric(const Graph &graph, const OverlayGraph &overlayGraph, std::unique_ptr<CostFunction> costFunction) : costFunction(std::move(costFunction)) {
+	/**
+	 * Customizes the overlay graph for @a costFunction.
+	 * @param graph
+	 * @param overlayGraph
+	 * @param costFunction
+	 * @param stats if given, measurements of the customization are recorded in @a stats
+	 * @param queueType the priority queue used by the customization
+	 */
+	Metric(const Graph &graph, const OverlayGraph &overlayGraph, std::unique_ptr<CostFunction> costFunction, CustomizationStats* stats = nullptr,
+			QUEUE_TYPE queueType = QUATERNARY_HEAP)
+			: costFunction(std::move(costFunction)) {
 		std::cout << "Computing weights" << std::endl;
 #ifndef NPROFILE
 		pv start = get_micro_time();
 #endif
-		weights = OverlayWeights(graph, overlayGraph, *(this->costFunction));
+		weights = OverlayWeights(graph, overlayGraph, *(this->costFunction), stats, queueType);
 #ifndef NPROFILE
 		pv end = get_micro_time();
 		std::cout << "Took " << (double) (end - start) / 1000.0 << " ms" << std::endl;
 #endif
 		std::cout << "Done" << std::endl;
 
-		index matrixOffset = 0;
-		std::unordered_map<std::vector<int>, index, IntVectorHasher> matrixMap;
-		turnTableDiffs = std::vector<int>();
-		turnTablePtr = std::vector<index>(graph.numberOfVertices());
-
-		for (index v = 0; v < graph.numberOfVertices(); ++v) {
-			count n = graph.getInDegree(v);
-			count m = graph.getOutDegree(v);
-			if (n == 0 || m == 0) continue;
-			std::vector<int> entryTurnTableDifferences(n*n);
-			for (index i = 0; i < n; ++i) {
-				for (index j = 0; j < n; ++j) {
-					int maxDiff = (int) this->costFunction->getTurnCosts(graph.getTurnType(v, i, 0)) - (int) this->costFunction->getTurnCosts(graph.getTurnType(v, j, 0));
-					for (index k = 1; k < m; ++k) {
-						maxDiff = std::max(maxDiff, (int) this->costFunction->getTurnCosts(graph.getTurnType(v, i, k)) - (int) this->costFunction->getTurnCosts(graph.getTurnType(v, j, k)));
-					}
-					
-					
-					entryTurnTableDifferences[i * n + j] = maxDiff;
-				}
-			}
-
-			std::vector<int> exitTurnTableDifferences(m*m);
-			for (index i = 0; i < m; ++i) {
-				for (index j = 0; j < m; ++j) {
-					int maxDiff = (int) this->costFunction->getTurnCosts(graph.getTurnType(v, 0, i)) - (int) this->costFunction->getTurnCosts(graph.getTurnType(v, 0, j));
-					for (index k = 1; k < n; ++k) {
-						maxDiff = std::max(maxDiff, (int) this->costFunction->getTurnCosts(graph.getTurnType(v, k, i)) - (int) this->costFunction->getTurnCosts(graph.getTurnType(v, k, j)));
-					}
-
-					exitTurnTableDifferences[i * m + j] = maxDiff;
-				}
-			}
-
-
-			auto it = matrixMap.find(entryTurnTableDifferences);
-			if (it != matrixMap.end()) {
-				turnTablePtr[v] = it->second;
-			} else {
-				turnTablePtr[v] = matrixOffset;
-				matrixMap.insert(std::make_pair(entryTurnTableDifferences, matrixOffset));
-				for (index i = 0; i < entryTurnTableDifferences.size(); ++i) {
-					turnTableDiffs.push_back(entryTurnTableDifferences[i]);
-				}
-				matrixOffset += entryTurnTableDifferences.size();
-			}
-
-			it = matrixMap.find(exitTurnTableDifferences);
-			if (it != matrixMap.end()) {
-				turnTablePtr[v] |= it->second << 16;
-			} else {
-				turnTablePtr[v] |= matrixOffset << 16;
-				matrixMap.insert(std::make_pair(exitTurnTableDifferences, matrixOffset));
-				for (index i = 0; i < exitTurnTableDifferences.size(); ++i) {
-					turnTableDiffs.push_back(exitTurnTableDifferences[i]);
-				}
-				matrixOffset += exitTurnTableDifferences.size();
-			}
-		}
-
-		std::cout << "Found " << matrixMap.size() << " turn Matrices" << std::endl;
+		buildTurnTableDiffs(graph);
 	}
 	Metric(Metric &&other) = default;
 	Metric& operator=(Metric &&other) = default;
@@ -162,6 +131,21 @@ public:
 		return weights.getWeight(offset);
 	}
 
+	/**
+	 * Returns the cell weight with given @a offset into the transposed cell matrices (see OverlayGraph::forInNeighborsOf)
+	 * @param offset
+	 */
+	inline weight getTransposedCellWeight(index offset) const {
+		return weights.getTransposedWeight(offset);
+	}
+
+	/**
+	 * Returns true if the transposed cell matrices were built, i.e. if the metric was read for queries.
+	 */
+	inline bool hasTransposedCellWeights() const {
+		return weights.hasTransposedWeights();
+	}
+
 	/**
 	 * Returns max_k \{ T_v[i,k] - T_v[j,k] \} where i and j are entry points and T_v[i,k] is the turnCost from entry point i to exit point k.
 	 * This is used for stalling (see Section 4.2.1 in the CRP paper).
@@ -223,8 +207,10 @@ public:
 	 * @param stream
 	 * @param metric
 	 * @param costFunction
+	 * @param overlayGraph if given, the transposed cell matrices for the backward overlay search of the queries are
+	 * built for this overlay graph, which doubles the memory of the cell weights
 	 */
-	static bool read(std::ifstream &stream, Metric &metric, std::unique_ptr<CostFunction> costFunction) {
+	static bool read(std::ifstream &stream, Metric &metric, std::unique_ptr<CostFunction> costFunction, const OverlayGraph *overlayGraph = nullptr) {
 		if (!stream.is_open()) return false;
 
 		std::string line;
@@ -257,6 +243,7 @@ public:
 		}
 
 		metric.weights = OverlayWeights(w);
+		if (overlayGraph != nullptr) metric.weights.buildTransposedWeights(*overlayGraph);
 		metric.turnTablePtr = turnTablePtr;
 		metric.turnTableDiffs = turnTableDiffs;
 		metric.costFunction = std::move(costFunction);
@@ -269,6 +256,101 @@ private:
 	OverlayWeights weights;
 	std::vector<index> turnTablePtr;
 	std::vector<int> turnTableDiffs;
+
+	/**
+	 * Computes the turn table differences used for stalling. Vertices that share a turn table and have the same degrees
+	 * also share their difference matrices, so they are only computed once per distinct turn table in parallel.
+	 * @param graph
+	 */
+	void buildTurnTableDiffs(const Graph &graph) {
+		std::vector<weight> turnCosts(Graph::NONE + 1);
+		for (index t = 0; t < turnCosts.size(); ++t) {
+			turnCosts[t] = costFunction->getTurnCosts(static_cast<Graph::TURN_TYPE>(t));
+		}
+
+		// Find a representative vertex for every distinct turn table.
+		std::unordered_map<TurnTableKey, index, TurnTableKeyHasher> tableMap;
+		std::vector<index> representatives;
+		std::vector<index> tableOfVertex(graph.numberOfVertices(), invalid_id);
+		graph.forVertices([&](index v, const Vertex &vertex) {
+			count n = graph.getInDegree(v);
+			count m = graph.getOutDegree(v);
+			if (n == 0 || m == 0) return;
+			auto it = tableMap.insert(std::make_pair(TurnTableKey{vertex.turnTablePtr, n, m}, representatives.size()));
+			if (it.second) representatives.push_back(v);
+			tableOfVertex[v] = it.first->second;
+		});
+
+		std::vector<std::vector<int>> entryTurnTableDifferences(representatives.size());
+		std::vector<std::vector<int>> exitTurnTableDifferences(representatives.size());
+
+#pragma omp parallel for schedule(dynamic)
+		for (index r = 0; r < representatives.size(); ++r) {
+			const index v = representatives[r];
+			const count n = graph.getInDegree(v);
+			const count m = graph.getOutDegree(v);
+
+			std::vector<int> costs(n*m);
+			for (index i = 0; i < n; ++i) {
+				for (index k = 0; k < m; ++k) {
+					costs[i * m + k] = turnCosts[graph.getTurnType(v, i, k)];
+				}
+			}
+
+			std::vector<int>& entryDiffs = entryTurnTableDifferences[r];
+			entryDiffs.resize(n*n);
+			for (index i = 0; i < n; ++i) {
+				for (index j = 0; j < n; ++j) {
+					int maxDiff = costs[i * m] - costs[j * m];
+					for (index k = 1; k < m; ++k) {
+						maxDiff = std::max(maxDiff, costs[i * m + k] - costs[j * m + k]);
+					}
+					entryDiffs[i * n + j] = maxDiff;
+				}
+			}
+
+			std::vector<int>& exitDiffs = exitTurnTableDifferences[r];
+			exitDiffs.resize(m*m);
+			for (index i = 0; i < m; ++i) {
+				for (index j = 0; j < m; ++j) {
+					int maxDiff = costs[i] - costs[j];
+					for (index k = 1; k < n; ++k) {
+						maxDiff = std::max(maxDiff, costs[k * m + i] - costs[k * m + j]);
+					}
+					exitDiffs[i * m + j] = maxDiff;
+				}
+			}
+		}
+
+		// Merge equal difference matrices. Representatives are ordered by their first occurrence, hence the
+		// resulting layout is the same as if the vertices were processed one after another.
+		index matrixOffset = 0;
+		std::unordered_map<std::vector<int>, index, IntVectorHasher> matrixMap;
+		std::vector<index> tablePtr(representatives.size());
+		turnTableDiffs = std::vector<int>();
+
+		auto insertMatrix = [&](const std::vector<int>& matrix) {
+			auto it = matrixMap.insert(std::make_pair(matrix, matrixOffset));
+			if (it.second) {
+				turnTableDiffs.insert(turnTableDiffs.end(), matrix.begin(), matrix.end());
+				matrixOffset += matrix.size();
+			}
+			return it.first->second;
+		};
+
+		for (index r = 0; r < representatives.size(); ++r) {
+			tablePtr[r] = insertMatrix(entryTurnTableDifferences[r]);
+			tablePtr[r] |= insertMatrix(exitTurnTableDifferences[r]) << 16;
+		}
+
+		turnTablePtr = std::vector<index>(graph.numberOfVertices(), 0);
+#pragma omp parallel for schedule(static)
+		for (index v = 0; v < turnTablePtr.size(); ++v) {
+			if (tableOfVertex[v] != invalid_id) turnTablePtr[v] = tablePtr[tableOfVertex[v]];
+		}
+
+		std::cout << "Found " << matrixMap.size() << " turn Matrices for " << representatives.size() << " distinct turn tables" << std::endl;
+	}
 };
 
 } /* namespace CRP */
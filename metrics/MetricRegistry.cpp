@@ -0,0 +1,103 @@
+/*
+ * MetricRegistry.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MetricRegistry.h"
+
+#include <cassert>
+#include <limits>
+
+namespace CRP {
+
+MetricRegistry::MetricRegistry(std::vector<Metric>&& metrics, count maxReaders) : slots(new ReaderSlot[maxReaders]), maxReaders(maxReaders),
+		numReaders(0), current(new Version{0, std::move(metrics)}), globalEpoch(1) {
+	for (index i = 0; i < maxReaders; ++i) {
+		slots[i].epoch.store(0);
+	}
+}
+
+MetricRegistry::~MetricRegistry() {
+	for (auto &version : retired) {
+		delete version.first;
+	}
+	delete current.load();
+}
+
+index MetricRegistry::registerReader() {
+	index readerId = numReaders.fetch_add(1);
+	assert(readerId < maxReaders);
+	return readerId;
+}
+
+MetricRegistry::Snapshot MetricRegistry::acquire(index readerId) {
+	assert(readerId < numReaders.load());
+	ReaderSlot& slot = slots[readerId];
+	assert(slot.epoch.load() == 0);
+
+	// Announce the epoch before reading the current version. A writer that retires the version read below
+	// does so in a later epoch and will therefore see this reader as active.
+	slot.epoch.store(globalEpoch.load());
+	const Version* version = current.load();
+	return Snapshot(&slot, version);
+}
+
+count MetricRegistry::publish(std::vector<Metric>&& metrics) {
+	std::lock_guard<std::mutex> lock(writerMutex);
+	Version* next = new Version{current.load()->id + 1, std::move(metrics)};
+	Version* old = current.exchange(next);
+	const uint64_t retireEpoch = globalEpoch.fetch_add(1) + 1;
+	retired.push_back(std::make_pair(old, retireEpoch));
+	collectRetired();
+	return next->id;
+}
+
+count MetricRegistry::collect() {
+	std::lock_guard<std::mutex> lock(writerMutex);
+	return collectRetired();
+}
+
+count MetricRegistry::collectRetired() {
+	// A reader with epoch e may pin every version that was retired after e, i.e. with retire epoch > e.
+	uint64_t minEpoch = std::numeric_limits<uint64_t>::max();
+	const count registered = numReaders.load();
+	for (index i = 0; i < registered; ++i) {
+		const uint64_t epoch = slots[i].epoch.load();
+		if (epoch != 0 && epoch < minEpoch) minEpoch = epoch;
+	}
+
+	index j = 0;
+	for (index i = 0; i < retired.size(); ++i) {
+		if (retired[i].second <= minEpoch) {
+			delete retired[i].first;
+		} else {
+			retired[j++] = retired[i];
+		}
+	}
+	retired.resize(j);
+	return j;
+}
+
+} /* namespace CRP */
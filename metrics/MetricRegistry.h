@@ -0,0 +1,173 @@
+/*
+ * MetricRegistry.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef METRICS_METRICREGISTRY_H_
+#define METRICS_METRICREGISTRY_H_
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../constants.h"
+#include "Metric.h"
+
+namespace CRP {
+
+/**
+ * Rebindable reference to the metrics a query works on.
+ */
+class MetricView {
+public:
+	MetricView(const std::vector<Metric>& metrics) : metrics(&metrics) {}
+
+	inline const Metric& operator[](index i) const {
+		assert(i < metrics->size());
+		return (*metrics)[i];
+	}
+
+	inline count size() const {
+		return metrics->size();
+	}
+
+	inline void bind(const std::vector<Metric>& metrics) {
+		this->metrics = &metrics;
+	}
+
+private:
+	const std::vector<Metric>* metrics;
+};
+
+/**
+ * Holds versions of a set of metrics and allows to replace them while queries are running. Each query thread
+ * registers as a reader and pins the current version with a Snapshot for the duration of a query. Publishing a
+ * new version never blocks readers; old versions are reclaimed once no reader pins them anymore (epoch-based
+ * reclamation).
+ */
+class MetricRegistry {
+private:
+	struct Version {
+		count id;
+		std::vector<Metric> metrics;
+	};
+
+	/** Epoch of a reader, 0 if the reader does not pin a version. Padded to a cache line. */
+	struct ReaderSlot {
+		std::atomic<uint64_t> epoch;
+		char padding[64 - sizeof(std::atomic<uint64_t>)];
+	};
+
+public:
+	/**
+	 * Pins a version of the metrics. The version stays valid until the snapshot is destroyed.
+	 */
+	class Snapshot {
+	public:
+		Snapshot(Snapshot &&other) : slot(other.slot), version(other.version) {
+			other.slot = nullptr;
+		}
+		Snapshot(const Snapshot &other) = delete;
+		Snapshot& operator=(const Snapshot &other) = delete;
+
+		~Snapshot() {
+			if (slot != nullptr) slot->epoch.store(0, std::memory_order_release);
+		}
+
+		inline const std::vector<Metric>& getMetrics() const {
+			return version->metrics;
+		}
+
+		inline count getVersion() const {
+			return version->id;
+		}
+
+	private:
+		friend class MetricRegistry;
+		Snapshot(ReaderSlot* slot, const Version* version) : slot(slot), version(version) {}
+
+		ReaderSlot* slot;
+		const Version* version;
+	};
+
+	/**
+	 * Creates a registry with @a metrics as its first version.
+	 * @param metrics
+	 * @param maxReaders the maximum number of reader threads
+	 */
+	MetricRegistry(std::vector<Metric>&& metrics, count maxReaders);
+	~MetricRegistry();
+
+	MetricRegistry(const MetricRegistry &other) = delete;
+	MetricRegistry& operator=(const MetricRegistry &other) = delete;
+
+	/**
+	 * Registers a reader and returns its id. Each reader must only be used by one thread at a time.
+	 */
+	index registerReader();
+
+	/**
+	 * Pins the current version for the reader with @a readerId. A reader can only hold one snapshot at a time.
+	 * @param readerId
+	 */
+	Snapshot acquire(index readerId);
+
+	/**
+	 * Makes @a metrics the current version. Queries that already hold a snapshot keep working on their version.
+	 * @param metrics
+	 * @return the id of the new version
+	 */
+	count publish(std::vector<Metric>&& metrics);
+
+	/**
+	 * Frees all retired versions that are not pinned by any reader anymore.
+	 * @return the number of retired versions that are still pinned
+	 */
+	count collect();
+
+	inline count getCurrentVersion() const {
+		return current.load(std::memory_order_acquire)->id;
+	}
+
+private:
+	std::unique_ptr<ReaderSlot[]> slots;
+	const count maxReaders;
+	std::atomic<count> numReaders;
+
+	std::atomic<Version*> current;
+	std::atomic<uint64_t> globalEpoch;
+
+	// only accessed by writers while holding writerMutex
+	std::mutex writerMutex;
+	std::vector<std::pair<Version*, uint64_t>> retired;
+
+	count collectRetired();
+};
+
+} /* namespace CRP */
+
+#endif /* METRICS_METRICREGISTRY_H_ */
@@ -0,0 +1,158 @@
+/*
+ * ProfileFunction.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ProfileFunction.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace CRP {
+
+namespace {
+
+const char* streetTypeNames[] = {"motorway", "trunk", "primary", "secondary", "tertiary", "unclassified", "residential", "service",
+		"motorway_link", "trunk_link", "primary_link", "secondary_link", "tertiary_link", "living_street", "road"};
+
+const char* turnTypeNames[] = {"left", "right", "straight", "u_turn", "no_entry", "none"};
+
+bool parseCosts(const std::string &str, weight &costs) {
+	if (str == "inf") {
+		costs = inf_weight;
+		return true;
+	}
+	try {
+		costs = std::min<unsigned long>(std::stoul(str), inf_weight);
+	} catch (...) {
+		return false;
+	}
+	return true;
+}
+
+}
+
+ProfileFunction::ProfileFunction() : vehicleHeight(0) {
+	const float speeds[] = {100, 85, 70, 60, 50, 40, 20, 5, 60, 60, 55, 50, 40, 5, 50, 30};
+	std::copy(speeds, speeds + STREET_TYPE_COUNT, streetTypeSpeed);
+	std::fill(turnCosts, turnCosts + Graph::NONE + 1, 0);
+	turnCosts[Graph::U_TURN] = inf_weight;
+	compile();
+}
+
+bool ProfileFunction::read(const std::string &fileName, ProfileFunction &profile) {
+	std::ifstream stream(fileName);
+	if (!stream.is_open()) {
+		std::cout << "ERROR: Could not open profile " << fileName << std::endl;
+		return false;
+	}
+
+	std::string line;
+	index lineNumber = 0;
+	// default_speed only applies to the street types without a speed line, wherever it appears
+	std::vector<bool> hasSpeed(STREET_TYPE_COUNT, false);
+	float defaultSpeed = -1;
+	while (std::getline(stream, line)) {
+		++lineNumber;
+		std::istringstream tokens(line);
+		std::string key;
+		if (!(tokens >> key) || key[0] == '#') continue;
+
+		bool valid = false;
+		if (key == "speed") {
+			std::string type;
+			float speed;
+			if (tokens >> type >> speed && speed >= 0) {
+				const char** name = std::find(streetTypeNames, streetTypeNames + INVALID, type);
+				if (name != streetTypeNames + INVALID) {
+					profile.streetTypeSpeed[name - streetTypeNames] = speed;
+					hasSpeed[name - streetTypeNames] = true;
+					valid = true;
+				}
+			}
+		} else if (key == "default_speed") {
+			valid = (tokens >> defaultSpeed) && defaultSpeed >= 0;
+		} else if (key == "speed_class") {
+			SpeedClass speedClass;
+			if (tokens >> speedClass.maxSpeed >> speedClass.factor && speedClass.factor >= 0) {
+				profile.speedClasses.push_back(speedClass);
+				valid = true;
+			}
+		} else if (key == "turn") {
+			std::string type;
+			std::string costs;
+			if (tokens >> type >> costs) {
+				const char** name = std::find(turnTypeNames, turnTypeNames + Graph::NONE + 1, type);
+				if (name != turnTypeNames + Graph::NONE + 1 && name - turnTypeNames != Graph::NO_ENTRY) {
+					valid = parseCosts(costs, profile.turnCosts[name - turnTypeNames]);
+					// parsed graphs only keep what is reachable without U-turns, see StronglyConnectedComponents
+					valid &= name - turnTypeNames != Graph::U_TURN || profile.turnCosts[Graph::U_TURN] == inf_weight;
+				}
+			}
+		} else if (key == "max_height") {
+			valid = (tokens >> profile.vehicleHeight) && profile.vehicleHeight >= 0;
+		}
+
+		if (!valid) {
+			std::cout << "ERROR: " << fileName << ":" << lineNumber << ": invalid profile line: " << line << std::endl;
+			return false;
+		}
+	}
+
+	if (defaultSpeed >= 0) {
+		for (index type = 0; type < STREET_TYPE_COUNT; ++type) {
+			if (!hasSpeed[type]) profile.streetTypeSpeed[type] = defaultSpeed;
+		}
+	}
+
+	profile.compile();
+	return true;
+}
+
+void ProfileFunction::compile() {
+	std::sort(speedClasses.begin(), speedClasses.end(), [](const SpeedClass &a, const SpeedClass &b) {
+		return a.maxSpeed < b.maxSpeed;
+	});
+
+	speedTable.assign(STREET_TYPE_COUNT * SPEED_COUNT, 0);
+	for (index speed = 0; speed < SPEED_COUNT; ++speed) {
+		for (index type = 0; type < STREET_TYPE_COUNT; ++type) {
+			float effectiveSpeed = (speed == 0 || streetTypeSpeed[type] == 0) ? streetTypeSpeed[type] : speed;
+			for (const SpeedClass &speedClass : speedClasses) {
+				if (effectiveSpeed <= speedClass.maxSpeed) {
+					effectiveSpeed *= speedClass.factor;
+					break;
+				}
+			}
+			speedTable[speed * STREET_TYPE_COUNT + type] = effectiveSpeed;
+		}
+	}
+
+	turnCosts[Graph::NO_ENTRY] = inf_weight;
+}
+
+} /* namespace CRP */
@@ -0,0 +1,106 @@
+/*
+ * ProfileFunction.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef METRICS_PROFILEFUNCTION_H_
+#define METRICS_PROFILEFUNCTION_H_
+
+#include <string>
+#include <vector>
+
+#include "CostFunction.h"
+#include "../constants.h"
+
+namespace CRP {
+
+/**
+ * Cost function that computes travel times from a speed profile file. The profile is compiled into flat lookup
+ * tables when it is loaded, so the weight of an edge is a single table lookup and a division.
+ *
+ * A profile file consists of lines of the form "key values", lines starting with # are ignored:
+ * - speed <street type> <km/h>: speed on edges of this type without a maxspeed tag, 0 excludes the street type
+ * - default_speed <km/h>: speed for all street types without a speed line, including unknown ones
+ * - speed_class <km/h> <factor>: multiplies all speeds up to the given speed (and above the previous class) by factor
+ * - turn <left|right|straight|none> <costs|inf>: costs of a turn type, u_turn is only accepted with inf
+ * - max_height <m>: height of the vehicle, edges with a lower maxheight are excluded
+ *
+ * Street types are named as the highway tags in OpenStreetMap, e.g. motorway or living_street. Turns with
+ * NO_ENTRY or U_TURN always have infinite costs, since the OSMParser and the generator only keep the part of the
+ * graph that is strongly connected without these turns.
+ */
+class ProfileFunction : public CostFunction {
+public:
+	/** Creates a profile with the speeds and turn costs of TimeFunction. */
+	ProfileFunction();
+
+	virtual weight getWeight(const EdgeAttributes& attributes) const {
+		if (attributes.maxHeight > 0 && attributes.maxHeight < vehicleHeight) return inf_weight;
+		const float speed = speedTable[attributes.stdAttributes & (STREET_TYPE_COUNT * SPEED_COUNT - 1)];
+		if (speed <= 0) return inf_weight;
+		const float w = 3.6f * attributes.getLength() / speed;
+		return (w >= inf_weight) ? inf_weight : static_cast<weight>(w);
+	}
+
+	virtual weight getTurnCosts(const Graph::TURN_TYPE turnType) const {
+		return turnCosts[turnType];
+	}
+
+	/**
+	 * Reads the profile in @a fileName into @a profile. Settings that do not appear in the file keep their defaults.
+	 * @param fileName
+	 * @param profile
+	 * @return false if the file could not be read or contains an invalid line
+	 */
+	static bool read(const std::string &fileName, ProfileFunction &profile);
+
+	inline float getVehicleHeight() const {
+		return vehicleHeight;
+	}
+
+private:
+	static const count STREET_TYPE_COUNT = 16;
+	static const count SPEED_COUNT = 256;
+
+	struct SpeedClass {
+		float maxSpeed;
+		float factor;
+	};
+
+	// profile settings
+	float streetTypeSpeed[STREET_TYPE_COUNT];
+	std::vector<SpeedClass> speedClasses;
+	float vehicleHeight;
+
+	// compiled tables, indexed like the lower 12 bits of EdgeAttributes::stdAttributes (speed << 4 | street type)
+	std::vector<float> speedTable;
+	weight turnCosts[Graph::NONE + 1];
+
+	void compile();
+};
+
+} /* namespace CRP */
+
+#endif /* METRICS_PROFILEFUNCTION_H_ */
@@ -0,0 +1,63 @@
+/*
+ * TruckFunction.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef METRICS_TRUCKFUNCTION_H_
+#define METRICS_TRUCKFUNCTION_H_
+
+#include <algorithm>
+
+#include "TimeFunction.h"
+#include "../constants.h"
+
+namespace CRP {
+
+/**
+ * Metric that computes the travel time of a truck with a given height. Edges whose maxheight is below the height
+ * of the truck get infinite weight, so they are excluded during customization. Speeds are capped at @a maxSpeed.
+ */
+class TruckFunction : public TimeFunction {
+public:
+	TruckFunction(float height, Speed maxSpeed = 80) : height(height), maxSpeed(maxSpeed) {}
+
+	virtual weight getWeight(const EdgeAttributes& attributes) const {
+		if (attributes.maxHeight > 0 && attributes.maxHeight < height) return inf_weight;
+		weight minTime = static_cast<weight>(3.6f * attributes.getLength() / maxSpeed);
+		return std::max(TimeFunction::getWeight(attributes), std::min(minTime, inf_weight));
+	}
+
+	inline float getHeight() const {
+		return height;
+	}
+
+private:
+	float height;
+	Speed maxSpeed;
+};
+
+} /* namespace CRP */
+
+#endif /* METRICS_TRUCKFUNCTION_H_ */
@@ -0,0 +1,190 @@
+/*
+ * Pipeline.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../algorithm/InertialFlowPartitioner.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../io/GraphIO.h"
+#include "../io/OSMParser.h"
+#include "../metrics/CostFunctionFactory.h"
+#include "../metrics/Metric.h"
+#include "../precalculation/CellNumbers.h"
+#include "../timer.h"
+
+using namespace std;
+
+struct Stage {
+	string name;
+	double time;
+	long peakRSS;
+};
+
+/** Returns the peak resident set size of this process in KB. */
+long getPeakRSS() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+bool endsWith(const string &str, const string &suffix) {
+	return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc != 5) {
+		cout << "Usage: " << argv[0] << " path_to_osm.bz2 path_to_mlp output_directory metric_types" << endl;
+		cout << "Runs parsing, partitioning, precalculation and customization in memory and only writes the final graph, overlay graph and metrics." << endl;
+		cout << "Instead of path_to_mlp, inertial:SIZE1,SIZE2,... computes the partition. metric_types is a comma separated list of metric types or all." << endl;
+		cout << "An already parsed graph (ending in .graph.bz2) can be given instead of the OSM file." << endl;
+		return 1;
+	}
+
+	string inputFile(argv[1]);
+	string partition(argv[2]);
+	string outputDir(argv[3]);
+	string metricTypes(argv[4]);
+	if (!outputDir.empty() && outputDir.back() != '/') outputDir += "/";
+
+	string inputName = inputFile.substr(inputFile.find_last_of("/\\") + 1);
+	string baseName = inputName.substr(0, inputName.find_first_of("."));
+
+	vector<string> types;
+	if (metricTypes == "all") {
+		types = {"hop", "dist", "time"};
+	} else {
+		stringstream stream(metricTypes);
+		string type;
+		while (getline(stream, type, ',')) {
+			types.push_back(type);
+		}
+	}
+	for (const string &type : types) {
+		if (!CRP::createCostFunction(type)) {
+			cout << "unknown metric " << type << endl;
+			return 1;
+		}
+	}
+
+	vector<Stage> stages;
+	bool ok = true;
+	auto runStage = [&](const string &name, function<bool()> stage) {
+		if (!ok) return;
+		cout << "== " << name << endl;
+		long long start = get_micro_time();
+		ok = stage();
+		stages.push_back({name, (get_micro_time() - start) / 1000.0, getPeakRSS()});
+		if (!ok) cout << name << " failed" << endl;
+	};
+
+	CRP::Graph graph;
+	CRP::MultiLevelPartition mlp;
+	vector<CRP::count> maxCellSizes;
+	const bool computePartition = CRP::InertialFlowPartitioner::isSpecification(partition);
+	if (computePartition && !CRP::InertialFlowPartitioner::parseSpecification(partition, maxCellSizes)) return 1;
+	unique_ptr<CRP::OverlayGraph> overlayGraph;
+	vector<CRP::Metric> metrics;
+
+	if (endsWith(inputFile, ".graph.bz2")) {
+		runStage("read graph", [&]() {
+			return CRP::GraphIO::readGraph(graph, inputFile);
+		});
+	} else {
+		runStage("parse", [&]() {
+			CRP::OSMParser osmParser;
+			return osmParser.parseGraph(inputFile, graph);
+		});
+	}
+
+	runStage("partition", [&]() {
+		if (!computePartition) {
+			mlp.read(partition);
+			return mlp.getNumberOfVertices() == graph.numberOfVertices();
+		}
+
+		CRP::InertialFlowPartitioner partitioner(graph);
+		mlp = partitioner.partition(maxCellSizes);
+		for (CRP::level l = 0; l < mlp.getNumberOfLevels(); ++l) {
+			cout << "Level " << (int) l << ": " << mlp.getNumberOfCellsInLevel(l) << " cells, "
+					<< partitioner.getNumberOfBoundaryEdges(l) << " boundary edges" << endl;
+		}
+		return mlp.getNumberOfVertices() == graph.numberOfVertices();
+	});
+
+	runStage("precalculation", [&]() {
+		CRP::buildCellNumbers(graph, mlp);
+		graph.sortVerticesByCellNumber();
+		overlayGraph.reset(new CRP::OverlayGraph(graph, mlp));
+		return true;
+	});
+
+	runStage("customization", [&]() {
+		for (const string &type : types) {
+			metrics.emplace_back(graph, *overlayGraph, CRP::createCostFunction(type));
+		}
+		return true;
+	});
+
+	runStage("write", [&]() {
+		bool written = CRP::GraphIO::writeGraph(graph, outputDir + baseName + ".graph.bz2");
+		written &= CRP::GraphIO::writeOverlayGraph(*overlayGraph, outputDir + baseName + ".overlay");
+		if (computePartition) {
+			mlp.write(outputDir + baseName + ".mlp");
+		}
+
+		string metricDir = outputDir + "metrics/";
+		mkdir(metricDir.c_str(), 0755);
+		for (size_t i = 0; i < types.size(); ++i) {
+			ofstream stream(metricDir + CRP::getMetricName(types[i]));
+			written &= CRP::Metric::write(stream, metrics[i]);
+		}
+		return written;
+	});
+
+	cout << endl << setw(16) << left << "stage" << setw(12) << right << "time [ms]" << setw(16) << "peak RSS [MB]" << endl;
+	double totalTime = 0;
+	for (const Stage &stage : stages) {
+		cout << setw(16) << left << stage.name << setw(12) << right << fixed << setprecision(1) << stage.time
+				<< setw(16) << stage.peakRSS / 1024.0 << endl;
+		totalTime += stage.time;
+	}
+	cout << setw(16) << left << "total" << setw(12) << right << totalTime << setw(16) << getPeakRSS() / 1024.0 << endl;
+
+	return ok ? 0 : 1;
+}
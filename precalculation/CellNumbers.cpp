@@ -0,0 +1,60 @@
+/*
+ * CellNumbers.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CellNumbers.h"
+
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace CRP {
+
+void buildCellNumbers(Graph& graph, const MultiLevelPartition& mlp) {
+	std::vector<pv> cellNumbers;
+	cellNumbers.reserve(mlp.getNumberOfCellsInLevel(0));
+	std::unordered_map<pv, index> pvMap;
+	pvMap.reserve(mlp.getNumberOfCellsInLevel(0));
+
+	graph.forVertices([&](index u, Vertex& vertex) {
+		pv cellNumber = mlp.getCellNumber(u);
+		auto it = pvMap.find(cellNumber);
+		if (it == pvMap.end()) {
+			cellNumbers.push_back(cellNumber);
+			pvMap[cellNumber] = cellNumbers.size() - 1;
+			vertex.pvPtr = cellNumbers.size() - 1;
+		} else {
+			vertex.pvPtr = it->second;
+		}
+	});
+
+	assert(cellNumbers.size() == mlp.getNumberOfCellsInLevel(0));
+	assert(pvMap.size() == mlp.getNumberOfCellsInLevel(0));
+
+	graph.setCellNumbers(cellNumbers);
+}
+
+} /* namespace CRP */
@@ -0,0 +1,46 @@
+/*
+ * CellNumbers.h
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PRECALCULATION_CELLNUMBERS_H_
+#define PRECALCULATION_CELLNUMBERS_H_
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+
+namespace CRP {
+
+/**
+ * Stores the distinct cell numbers of @a mlp in @a graph and lets every vertex point to its cell number.
+ * This has to be done before the vertices are sorted by their cell numbers.
+ * @param graph the graph
+ * @param mlp a multi-level partition of @a graph
+ */
+void buildCellNumbers(Graph& graph, const MultiLevelPartition& mlp);
+
+} /* namespace CRP */
+
+#endif /* PRECALCULATION_CELLNUMBERS_H_ */
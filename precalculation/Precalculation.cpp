@@ -21,43 +21,22 @@
  */
 
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "../algorithm/InertialFlowPartitioner.h"
 #include "../datastructures/MultiLevelPartition.h"
 #include "../io/GraphIO.h"
 #include "../datastructures/Graph.h"
 #include "../datastructures/OverlayGraph.h"
+#include "CellNumbers.h"
 
 using namespace std;
 
-namespace CRP {
-
-void buildCellNumbers(Graph& graph, const MultiLevelPartition& mlp) {
-	std::vector<pv> cellNumbers;
-	cellNumbers.reserve(mlp.getNumberOfCellsInLevel(0));
-	std::unordered_map<pv, index> pvMap;
-	pvMap.reserve(mlp.getNumberOfCellsInLevel(0));
-
-	graph.forVertices([&](index u, Vertex& vertex) {
-		pv cellNumber = mlp.getCellNumber(u);
-		auto it = pvMap.find(cellNumber);
-		if (it == pvMap.end()) {
-			cellNumbers.push_back(cellNumber);
-			pvMap[cellNumber] = cellNumbers.size() - 1;
-			vertex.pvPtr = cellNumbers.size() - 1;
-		} else {
-			vertex.pvPtr = it->second;
-		}
-	});
-
-	assert(cellNumbers.size() == mlp.getNumberOfCellsInLevel(0));
-	assert(pvMap.size() == mlp.getNumberOfCellsInLevel(0));
-
-	graph.setCellNumbers(cellNumbers);
-}
-}
 int main(int argc, char* argv[]) {
 	if (argc != 4) {
 		cout << "Usage:" << argv[0] << " pathToGraph pathToMLP pathToOutputDirectory" << endl;
+		cout << "Instead of pathToMLP, inertial:SIZE1,SIZE2,... computes a partition with the given maximum cell sizes per level (starting with the lowest level) and writes it to the output directory." << endl;
 		return 1;
 	}
 
@@ -71,13 +50,30 @@ int main(int argc, char* argv[]) {
 	string overlayGraphFile = outputDir + graphName.substr(0, graphName.find_first_of(".")) + ".overlay";
 
 
-	CRP::MultiLevelPartition mlp;
-	mlp.read(mlpFileName);
-
 	cout << "Reading graph" << endl;
 	CRP::Graph graph;
 	CRP::GraphIO::readGraph(graph, graphFileName);
 
+	CRP::MultiLevelPartition mlp;
+	vector<CRP::count> maxCellSizes;
+	if (CRP::InertialFlowPartitioner::isSpecification(mlpFileName)) {
+		if (!CRP::InertialFlowPartitioner::parseSpecification(mlpFileName, maxCellSizes)) return 1;
+		cout << "Partitioning graph" << endl;
+		CRP::InertialFlowPartitioner partitioner(graph);
+		mlp = partitioner.partition(maxCellSizes);
+		if (mlp.getNumberOfVertices() != graph.numberOfVertices()) return 1;
+		for (CRP::level l = 0; l < mlp.getNumberOfLevels(); ++l) {
+			cout << "Level " << (int) l << ": " << mlp.getNumberOfCellsInLevel(l) << " cells, "
+					<< partitioner.getNumberOfBoundaryEdges(l) << " boundary edges" << endl;
+		}
+
+		string mlpFile = outputDir + graphName.substr(0, graphName.find_first_of(".")) + ".mlp";
+		cout << "Writing partition " << mlpFile << endl;
+		mlp.write(mlpFile);
+	} else {
+		mlp.read(mlpFileName);
+	}
+
 	CRP::buildCellNumbers(graph, mlp);
 	graph.sortVerticesByCellNumber();
 
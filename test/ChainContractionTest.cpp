@@ -0,0 +1,146 @@
+/*
+ * ChainContractionTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/ChainContraction.h"
+#include "../datastructures/EdgeGeometry.h"
+#include "../datastructures/Graph.h"
+#include "../io/GraphIO.h"
+#include "../metrics/DistanceFunction.h"
+
+#include "../constants.h"
+
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Turn-aware Dijkstra on the edges of @a graph with the distance metric.
+ * @return the distance from @a source to every vertex
+ */
+vector<CRP::weight> distances(const CRP::Graph &graph, CRP::index source) {
+	CRP::DistanceFunction distance;
+	vector<CRP::weight> edgeDist(graph.numberOfEdges(), inf_weight);
+	vector<CRP::weight> vertexDist(graph.numberOfVertices(), inf_weight);
+	typedef pair<CRP::weight, CRP::index> QueueEntry;
+	priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> queue;
+
+	vertexDist[source] = 0;
+	for (CRP::index e = graph.getExitOffset(source); e < graph.getExitOffset(source) + graph.getOutDegree(source); ++e) {
+		edgeDist[e] = distance.getWeight(graph.getForwardEdge(e).attributes);
+		queue.push({edgeDist[e], e});
+	}
+
+	while (!queue.empty()) {
+		const QueueEntry entry = queue.top();
+		queue.pop();
+		const CRP::index e = entry.second;
+		if (entry.first > edgeDist[e]) continue;
+
+		const CRP::ForwardEdge &edge = graph.getForwardEdge(e);
+		vertexDist[edge.head] = min(vertexDist[edge.head], edgeDist[e]);
+		for (CRP::index f = graph.getExitOffset(edge.head); f < graph.getExitOffset(edge.head) + graph.getOutDegree(edge.head); ++f) {
+			const CRP::weight turnCosts = distance.getTurnCosts(graph.getTurnType(edge.head, edge.entryPoint, graph.getExitOrder(edge.head, f)));
+			if (turnCosts == inf_weight) continue;
+			const CRP::weight newDist = edgeDist[e] + turnCosts + distance.getWeight(graph.getForwardEdge(f).attributes);
+			if (newDist < edgeDist[f]) {
+				edgeDist[f] = newDist;
+				queue.push({newDist, f});
+			}
+		}
+	}
+
+	return vertexDist;
+}
+
+/**
+ * Contracts the degree-2 chains of a graph and checks that the distances between the remaining vertices do not change
+ * and that every chain can be drawn.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		cout << argv[0] << " pathToGraph [numSources]" << endl;
+		return 1;
+	}
+
+	string graphFile = argv[1];
+	const CRP::count numSources = argc > 2 ? stoul(argv[2]) : 20;
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	if (!CRP::GraphIO::readGraph(graph, graphFile)) {
+		cout << "ERROR: could not read " << graphFile << endl;
+		return 1;
+	}
+
+	CRP::EdgeGeometry geometry;
+	CRP::ChainContraction contraction(graph);
+	CRP::Graph contracted = contraction.contract(geometry);
+	cout << "Removed " << contraction.getNumberOfRemovedVertices() << " of " << graph.numberOfVertices() << " vertices and "
+			<< graph.numberOfEdges() - contracted.numberOfEdges() << " of " << graph.numberOfEdges() << " edges, "
+			<< geometry.numberOfChains() << " chains with " << geometry.numberOfPoints() << " points" << endl;
+
+	// the remaining vertices keep their order
+	vector<CRP::index> oldId;
+	CRP::index v = 0;
+	contracted.forVertices([&](CRP::index u, const CRP::Vertex &vertex) {
+		while (graph.getCoordinate(v).lat != vertex.coord.lat || graph.getCoordinate(v).lon != vertex.coord.lon) ++v;
+		oldId.push_back(v++);
+	});
+
+	bool ok = oldId.size() == contracted.numberOfVertices() && graph.numberOfVertices() - oldId.size() == contraction.getNumberOfRemovedVertices();
+
+	CRP::count numPoints = 0;
+	contracted.forEdges([&](CRP::index u, CRP::index w, CRP::index) {
+		geometry.forIntermediatePoints(contracted.getCoordinate(u), contracted.getCoordinate(w), [&](const CRP::Coordinate &) {
+			numPoints++;
+		});
+	});
+	if (numPoints < geometry.numberOfPoints()) {
+		cout << "only " << numPoints << " of " << geometry.numberOfPoints() << " points reachable through edges" << endl;
+		ok = false;
+	}
+
+	mt19937 generator(42);
+	uniform_int_distribution<CRP::index> sourceDistribution(0, contracted.numberOfVertices() - 1);
+	for (CRP::index i = 0; i < numSources && ok; ++i) {
+		const CRP::index source = sourceDistribution(generator);
+		vector<CRP::weight> expected = distances(graph, oldId[source]);
+		vector<CRP::weight> actual = distances(contracted, source);
+		for (CRP::index t = 0; t < contracted.numberOfVertices(); ++t) {
+			if (expected[oldId[t]] != actual[t]) {
+				cout << "distance " << source << " -> " << t << " not equal: " << expected[oldId[t]] << " != " << actual[t] << endl;
+				ok = false;
+			}
+		}
+	}
+
+	cout << (ok ? "all distances equal" : "FAILED") << endl;
+	return ok ? 0 : 1;
+}
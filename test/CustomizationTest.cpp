@@ -0,0 +1,174 @@
+/*
+ * CustomizationTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/OverlayWeights.h"
+#include "../datastructures/CustomizationStats.h"
+#include "../io/GraphIO.h"
+#include "../metrics/CostFunctionFactory.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <iostream>
+#include <memory>
+#include <iomanip>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include "omp.h"
+
+using namespace std;
+
+/**
+ * Estimates the bytes that the customization of level @a l reads and writes. Each scanned arc reads the arc
+ * (a ForwardEdge and its turn in the lowest level, an overlay id and a cell weight above) and the distance and
+ * round of its head, each cell writes its weight matrix. Caches are ignored, so this is only a rough estimate.
+ */
+static double estimateLevelBytes(const CRP::LevelStats& levelStats, const std::vector<CRP::CellStats>& cells) {
+	const double bytesPerArc = levelStats.l == 1
+			? sizeof(CRP::ForwardEdge) + sizeof(CRP::Graph::TURN_TYPE) + sizeof(CRP::weight) + sizeof(CRP::index)
+			: sizeof(CRP::index) + 2 * sizeof(CRP::weight) + sizeof(CRP::index);
+	double bytes = levelStats.scannedArcs * bytesPerArc;
+	for (const CRP::CellStats& cell : cells) {
+		if (cell.l == levelStats.l) bytes += (double) cell.numEntryPoints * cell.numExitPoints * sizeof(CRP::weight);
+	}
+	return bytes;
+}
+
+/**
+ * Customizes each metric with 1, 2, 4, ... threads and reports the best time of each level over all repetitions,
+ * the speedup over one thread and the estimated memory bandwidth. Graph and overlay graph are read only once.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 4) {
+		std::cout << argv[0] << " pathToGraph pathToOverlayGraph metricTypes [repetitions] [maxThreads]" << std::endl;
+		std::cout << "metricTypes is a comma-separated list of metric types or 'all'" << std::endl;
+		return 1;
+	}
+
+	std::string graphFile = argv[1];
+	std::string overlayGraphFile = argv[2];
+	std::string metricTypes = argv[3];
+	const int repetitions = argc > 4 ? std::stoi(argv[4]) : 3;
+	const int maxThreads = argc > 5 ? std::stoi(argv[5]) : omp_get_max_threads();
+	if (repetitions < 1 || maxThreads < 1) {
+		std::cout << "ERROR: repetitions and maxThreads must be positive" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::string> types;
+	if (metricTypes == "all") {
+		types = {"hop", "dist", "time"};
+	} else {
+		std::istringstream stream(metricTypes);
+		std::string type;
+		while (std::getline(stream, type, ',')) {
+			types.push_back(type);
+		}
+	}
+
+	std::vector<std::unique_ptr<CRP::CostFunction>> costFunctions;
+	for (const std::string& type : types) {
+		costFunctions.push_back(CRP::createCostFunction(type));
+		if (!costFunctions.back()) {
+			std::cout << "ERROR: Unknown metric type " << type << std::endl;
+			return 1;
+		}
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	std::cout << "Done" << std::endl;
+
+	const CRP::level levelCount = overlayGraph.getLevelInfo().getLevelCount();
+
+	std::vector<int> threadCounts;
+	for (int t = 1; t < maxThreads; t *= 2) {
+		threadCounts.push_back(t);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (size_t m = 0; m < types.size(); ++m) {
+		std::cout << std::endl << "Metric " << CRP::getMetricName(types[m]) << std::endl;
+		std::cout << std::setw(8) << "threads" << std::setw(7) << "level" << std::setw(12) << "time [ms]" << std::setw(10) << "speedup"
+				<< std::setw(13) << "utilization" << std::setw(11) << "GB/s" << std::endl;
+
+		std::vector<long long> singleThreadLevelTimes;
+		long long singleThreadTime = 0;
+		for (int numThreads : threadCounts) {
+			omp_set_num_threads(numThreads);
+
+			// best time of each level and of the whole customization, including the transposed weights
+			std::vector<long long> levelTimes(levelCount, std::numeric_limits<long long>::max());
+			std::vector<double> levelUtilization(levelCount, 0);
+			std::vector<double> levelBytes(levelCount, 0);
+			long long totalTime = std::numeric_limits<long long>::max();
+			for (int r = 0; r < repetitions; ++r) {
+				CRP::CustomizationStats stats;
+				long long start = get_micro_time();
+				CRP::OverlayWeights weights(graph, overlayGraph, *costFunctions[m], &stats);
+				totalTime = std::min(totalTime, get_micro_time() - start);
+
+				const std::vector<CRP::CellStats> cells = stats.getCells();
+				for (const CRP::LevelStats& levelStats : stats.getLevels()) {
+					const CRP::index i = levelStats.l - 1;
+					if (levelStats.getWallTime() < levelTimes[i]) {
+						levelTimes[i] = levelStats.getWallTime();
+						levelUtilization[i] = levelStats.getUtilization();
+					}
+					levelBytes[i] = estimateLevelBytes(levelStats, cells);
+				}
+			}
+
+			if (numThreads == 1) {
+				singleThreadLevelTimes = levelTimes;
+				singleThreadTime = totalTime;
+			}
+
+			std::cout << std::fixed;
+			for (CRP::level l = 1; l <= levelCount; ++l) {
+				const long long time = std::max(levelTimes[l - 1], 1ll);
+				std::cout << std::setw(8) << numThreads << std::setw(7) << (int) l << std::setprecision(1) << std::setw(12) << time / 1000.0
+						<< std::setprecision(2) << std::setw(10) << (double) singleThreadLevelTimes[l - 1] / time
+						<< std::setw(13) << levelUtilization[l - 1] << std::setw(11) << levelBytes[l - 1] / time / 1000.0 << std::endl;
+			}
+			const long long time = std::max(totalTime, 1ll);
+			std::cout << std::setw(8) << numThreads << std::setw(7) << "total" << std::setprecision(1) << std::setw(12) << time / 1000.0
+					<< std::setprecision(2) << std::setw(10) << (double) singleThreadTime / time << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * MetricRegistryTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQuery.h"
+#include "../algorithm/PathUnpacker.h"
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryResult.h"
+#include "../io/GraphIO.h"
+#include "../metrics/Metric.h"
+#include "../metrics/MetricRegistry.h"
+#include "../metrics/DistanceFunction.h"
+#include "../metrics/TimeFunction.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <iostream>
+#include <memory>
+#include <iomanip>
+#include <random>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+#include "omp.h"
+
+using namespace std;
+
+/**
+ * Replaces the metric of a registry while other threads run queries. Versions with an even id use the time
+ * metric, versions with an odd id the distance metric. Every query must return the result of the version it
+ * started with.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 5) {
+		std::cout << argv[0] << " numQueries pathToGraph pathToOverlayGraph numUpdates" << std::endl;
+		return 1;
+	}
+
+	CRP::count numQueries = std::stoi(argv[1]);
+	std::string graphFile = argv[2];
+	std::string overlayGraphFile = argv[3];
+	CRP::count numUpdates = std::stoi(argv[4]);
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	auto customize = [&](CRP::count version) {
+		std::vector<CRP::Metric> metrics;
+		if (version % 2 == 0) {
+			metrics.push_back(CRP::Metric(graph, overlayGraph, std::unique_ptr<CRP::CostFunction>(new CRP::TimeFunction())));
+		} else {
+			metrics.push_back(CRP::Metric(graph, overlayGraph, std::unique_ptr<CRP::CostFunction>(new CRP::DistanceFunction())));
+		}
+		return metrics;
+	};
+
+	auto vertex_rand = std::bind(std::uniform_int_distribution<CRP::index>(0, graph.numberOfVertices()-1), mt19937(get_micro_time()));
+	std::vector<std::pair<CRP::index, CRP::index>> queries(numQueries);
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		queries[i] = std::make_pair(vertex_rand(), vertex_rand());
+	}
+
+	std::cout << "Computing reference results" << std::endl;
+	std::vector<std::vector<CRP::weight>> expected(2, std::vector<CRP::weight>(numQueries));
+	for (CRP::index v = 0; v < 2; ++v) {
+		std::vector<CRP::Metric> metrics = customize(v);
+		CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+		CRP::CRPQuery<> query(graph, overlayGraph, metrics, pathUnpacker);
+		for (CRP::index i = 0; i < numQueries; ++i) {
+			expected[v][i] = query.vertexQuery(queries[i].first, queries[i].second, 0).pathWeight;
+		}
+	}
+
+	const int numThreads = std::max(2, omp_get_max_threads());
+	CRP::MetricRegistry registry(customize(0), numThreads);
+	std::atomic<bool> done(false);
+	std::atomic<CRP::count> errors(0);
+	std::atomic<CRP::count> queriesRun(0);
+	std::atomic<CRP::count> versionChanges(0);
+	long long publishTime = 0;
+
+	std::cout << "Running queries with " << numThreads - 1 << " threads while publishing " << numUpdates << " updates" << std::endl;
+#pragma omp parallel num_threads(numThreads)
+	{
+		if (omp_get_thread_num() == 0) {
+			for (CRP::index u = 1; u <= numUpdates; ++u) {
+				std::vector<CRP::Metric> metrics = customize(u);
+				long long start = get_micro_time();
+				registry.publish(std::move(metrics));
+				publishTime += get_micro_time() - start;
+			}
+			done = true;
+		} else {
+			CRP::index reader = registry.registerReader();
+			std::vector<CRP::Metric> empty;
+			CRP::PathUnpacker pathUnpacker(graph, overlayGraph, empty);
+			CRP::CRPQuery<> query(graph, overlayGraph, empty, pathUnpacker);
+			CRP::count lastVersion = 0;
+			CRP::index i = omp_get_thread_num();
+			while (!done || i < numQueries) {
+				const CRP::index q = i % numQueries;
+				CRP::MetricRegistry::Snapshot snapshot = registry.acquire(reader);
+				query.bindMetrics(snapshot.getMetrics());
+				CRP::QueryResult result = query.vertexQuery(queries[q].first, queries[q].second, 0);
+				if (result.pathWeight != expected[snapshot.getVersion() % 2][q]) {
+					errors++;
+				}
+				if (snapshot.getVersion() != lastVersion) {
+					versionChanges++;
+					lastVersion = snapshot.getVersion();
+				}
+				queriesRun++;
+				i += numThreads - 1;
+			}
+		}
+	}
+
+	CRP::count pinned = registry.collect();
+	std::cout << std::setprecision(3);
+	std::cout << "Ran " << queriesRun << " queries, observed " << versionChanges << " version changes, final version " << registry.getCurrentVersion() << std::endl;
+	std::cout << "Avg publish time = " << (double) publishTime / std::max<CRP::count>(numUpdates, 1) << " us. Versions still pinned: " << pinned << std::endl;
+	std::cout << "Wrong results: " << errors << std::endl;
+
+	return errors == 0 && pinned == 0 ? 0 : 1;
+}
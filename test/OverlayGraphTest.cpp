@@ -26,7 +26,11 @@
  */
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "../constants.h"
@@ -37,6 +41,7 @@
 #include "../datastructures/OverlayWeights.h"
 #include "../io/GraphIO.h"
 #include "../metrics/HopFunction.h"
+#include "../precalculation/CellNumbers.h"
 
 namespace CRP {
 class HopFunction;
@@ -44,30 +49,6 @@ class HopFunction;
 
 namespace CRP {
 
-void buildCellNumbers(Graph& graph, const MultiLevelPartition& mlp) {
-	std::vector<pv> cellNumbers;
-	cellNumbers.reserve(mlp.getNumberOfCellsInLevel(0));
-	std::unordered_map<pv, index> pvMap;
-	pvMap.reserve(mlp.getNumberOfCellsInLevel(0));
-
-	graph.forVertices([&](index u, Vertex& vertex) {
-		pv cellNumber = mlp.getCellNumber(u);
-		auto it = pvMap.find(cellNumber);
-		if (it == pvMap.end()) {
-			cellNumbers.push_back(cellNumber);
-			pvMap[cellNumber] = cellNumbers.size() - 1;
-			vertex.pvPtr = cellNumbers.size() - 1;
-		} else {
-			vertex.pvPtr = it->second;
-		}
-	});
-
-	assert(cellNumbers.size() == mlp.getNumberOfCellsInLevel(0));
-	assert(pvMap.size() == mlp.getNumberOfCellsInLevel(0));
-
-	graph.setCellNumbers(cellNumbers);
-}
-
 Graph buildGraph() {
 	std::vector<Vertex> vertices;
 	vertices.push_back({0, 0, 0, 0, {0, 0}});
@@ -160,11 +141,48 @@ void testCell(const OverlayGraph& og, pv cellNumber, level lev, index entryPoint
 	}
 }
 
+std::string readFile(const std::string &fileName) {
+	std::ifstream file(fileName, std::ios::binary);
+	std::stringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+/**
+ * Builds the overlay graph of @a graph with the serial and the parallel builder and checks that
+ * the written graphs and overlay graphs are byte-identical.
+ */
+bool testParallelBuilder(const Graph& graph, const MultiLevelPartition& mlp) {
+	Graph serialGraph = graph;
+	Graph parallelGraph = graph;
+	OverlayGraph serialOverlayGraph(serialGraph, mlp, false);
+	OverlayGraph parallelOverlayGraph(parallelGraph, mlp, true);
+
+	GraphIO::writeGraph(serialGraph, "serial.graph.bz2");
+	GraphIO::writeGraph(parallelGraph, "parallel.graph.bz2");
+	GraphIO::writeOverlayGraph(serialOverlayGraph, "serial.overlay");
+	GraphIO::writeOverlayGraph(parallelOverlayGraph, "parallel.overlay");
+
+	bool identical = readFile("serial.graph.bz2") == readFile("parallel.graph.bz2")
+			&& readFile("serial.overlay") == readFile("parallel.overlay");
+
+	std::remove("serial.graph.bz2");
+	std::remove("parallel.graph.bz2");
+	std::remove("serial.overlay");
+	std::remove("parallel.overlay");
+	return identical;
+}
+
 } /* namespace CRP */
 
 
 
 int main(int argc, char **argv) {
+	if (argc != 1 && argc != 3) {
+		std::cout << "Usage: " << argv[0] << " [path_to_graph path_to_mlp]" << std::endl;
+		return 1;
+	}
+
 	CRP::Graph g = CRP::buildGraph();
 	std::cout << "graph built" << std::endl;
 
@@ -179,6 +197,10 @@ int main(int argc, char **argv) {
 	std::cout << "sorting vertices by cell number" << std::endl;
 	g.sortVerticesByCellNumber();
 
+	std::cout << "comparing serial and parallel overlay graph builder" << std::endl;
+	bool identical = CRP::testParallelBuilder(g, mlp);
+	assert(identical);
+
 	std::cout << "building overlay graph" << std::endl;
 	CRP::OverlayGraph og(g, mlp);
 
@@ -229,4 +251,19 @@ int main(int argc, char **argv) {
 
 		});
 	}
+
+	if (argc == 3) {
+		CRP::Graph graph;
+		CRP::GraphIO::readGraph(graph, argv[1]);
+		CRP::MultiLevelPartition partition;
+		partition.read(argv[2]);
+		CRP::buildCellNumbers(graph, partition);
+		graph.sortVerticesByCellNumber();
+
+		std::cout << "comparing serial and parallel overlay graph builder on " << argv[1] << std::endl;
+		identical = CRP::testParallelBuilder(graph, partition);
+		std::cout << (identical ? "builders agree" : "builders differ") << std::endl;
+		assert(identical);
+	}
+	return identical ? 0 : 1;
 }
@@ -0,0 +1,135 @@
+/*
+ * ParallelQueryTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQueryUni.h"
+#include "../algorithm/Dijkstra.h"
+#include "../algorithm/ParallelCRPQuery.h"
+#include "../algorithm/PathUnpacker.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryResult.h"
+#include "../generator/SyntheticGraph.h"
+#include "../metrics/CostFunctionFactory.h"
+#include "../metrics/Metric.h"
+#include "../precalculation/CellNumbers.h"
+
+#include "../constants.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Returns the id of the backward edge that belongs to the forward edge @a e.
+ */
+CRP::index toBackwardEdge(const CRP::Graph &graph, CRP::index e) {
+	const CRP::ForwardEdge &edge = graph.getForwardEdge(e);
+	return graph.getEntryOffset(edge.head) + edge.entryPoint;
+}
+
+/**
+ * Runs the edge query from @a sourceEdgeId to @a targetEdgeId with the parallel query, the unidirectional query and
+ * Dijkstra and reports it if the distances differ. The parallel query is repeated, since its result must not depend on
+ * how its two threads are scheduled.
+ */
+bool checkQuery(CRP::Query &dijkstra, CRP::Query &uni, CRP::Query &parallel, CRP::index sourceEdgeId, CRP::index targetEdgeId, const string &kind) {
+	const CRP::weight expected = dijkstra.edgeQuery(sourceEdgeId, targetEdgeId, 0).pathWeight;
+	const CRP::weight uniWeight = uni.edgeQuery(sourceEdgeId, targetEdgeId, 0).pathWeight;
+	bool ok = uniWeight == expected;
+	CRP::weight parallelWeight = expected;
+	for (int i = 0; i < 3 && ok; ++i) {
+		parallelWeight = parallel.edgeQuery(sourceEdgeId, targetEdgeId, 0).pathWeight;
+		ok = parallelWeight == expected;
+	}
+	if (!ok) {
+		cout << kind << " query " << sourceEdgeId << " -> " << targetEdgeId << ": Dijkstra " << expected << ", uni " << uniWeight << ", parallel " << parallelWeight << endl;
+	}
+	return ok;
+}
+
+/**
+ * Generates a grid with many one-way streets and forbidden turns and compares the parallel query with Dijkstra and
+ * the unidirectional query on random edge pairs, on pairs a few edges apart and on pairs where the target edge leaves
+ * the head of the source edge.
+ */
+int main(int argc, char *argv[]) {
+	const CRP::count numQueries = argc > 1 ? stoul(argv[1]) : 1000;
+
+	CRP::SyntheticGraph generator(11, 0.3f, 0.2f);
+	CRP::Graph graph;
+	if (!generator.generateGrid(graph, 60, 60)) return 1;
+	CRP::MultiLevelPartition mlp = CRP::SyntheticGraph::partition(graph, {16, 256});
+	CRP::buildCellNumbers(graph, mlp);
+	graph.sortVerticesByCellNumber();
+	CRP::OverlayGraph overlayGraph(graph, mlp);
+	vector<CRP::Metric> metrics;
+	metrics.emplace_back(graph, overlayGraph, CRP::createCostFunction("time"));
+
+	CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+	CRP::Dijkstra<> dijkstra(graph, overlayGraph, metrics);
+	CRP::CRPQueryUni<> uni(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::ParallelCRPQuery<> parallel(graph, overlayGraph, metrics, pathUnpacker);
+
+	mt19937 rng(42);
+	uniform_int_distribution<CRP::index> edgeDistribution(0, graph.numberOfEdges() - 1);
+	uniform_int_distribution<CRP::count> stepDistribution(1, 20);
+	CRP::count errors = 0;
+
+	cout << "Checking random pairs" << endl;
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		const CRP::index sourceEdgeId = edgeDistribution(rng);
+		const CRP::index targetEdgeId = edgeDistribution(rng);
+		errors += !checkQuery(dijkstra, uni, parallel, sourceEdgeId, targetEdgeId, "random");
+	}
+
+	cout << "Checking nearby pairs" << endl;
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		const CRP::index sourceEdgeId = edgeDistribution(rng);
+		CRP::index e = sourceEdgeId;
+		for (CRP::count steps = stepDistribution(rng); steps > 0; --steps) {
+			const CRP::index v = graph.getForwardEdge(e).head;
+			e = graph.getExitOffset(v) + rng() % graph.getOutDegree(v);
+		}
+		errors += !checkQuery(dijkstra, uni, parallel, sourceEdgeId, toBackwardEdge(graph, e), "nearby");
+	}
+
+	cout << "Checking adjacent pairs" << endl;
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		const CRP::index sourceEdgeId = edgeDistribution(rng);
+		const CRP::index v = graph.getForwardEdge(sourceEdgeId).head;
+		for (CRP::index e = graph.getExitOffset(v); e < graph.getExitOffset(v) + graph.getOutDegree(v); ++e) {
+			errors += !checkQuery(dijkstra, uni, parallel, sourceEdgeId, toBackwardEdge(graph, e), "adjacent");
+		}
+	}
+
+	cout << (errors == 0 ? "all checks passed" : to_string(errors) + " queries FAILED") << endl;
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+/*
+ * QueryReplayTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQuery.h"
+#include "../algorithm/CRPQueryUni.h"
+#include "../algorithm/ParallelCRPQuery.h"
+#include "../algorithm/PathUnpacker.h"
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryLog.h"
+#include "../datastructures/QueryResult.h"
+#include "../io/GraphIO.h"
+#include "../metrics/Metric.h"
+#include "../metrics/CostFunctionFactory.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <iostream>
+#include <memory>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "omp.h"
+
+using namespace std;
+
+/**
+ * Prints number, mean, percentiles and maximum of @a latencies in milliseconds.
+ */
+void printLatencies(const std::string &name, std::vector<long long> latencies) {
+	if (latencies.empty()) return;
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&](double p) {
+		return latencies[std::min((size_t) (p * latencies.size()), latencies.size() - 1)] / 1000.0;
+	};
+	long long sum = 0;
+	for (long long latency : latencies) sum += latency;
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << std::setw(12) << std::left << name << std::right << std::setw(10) << latencies.size() << std::setw(10) << sum / 1000.0 / latencies.size()
+			<< std::setw(10) << percentile(0.5) << std::setw(10) << percentile(0.9) << std::setw(10) << percentile(0.99)
+			<< std::setw(10) << percentile(0.999) << std::setw(10) << latencies.back() / 1000.0 << std::endl;
+}
+
+/**
+ * Writes a log of @a numQueries queries between random edges whose arrivals form a Poisson process with
+ * @a queriesPerSecond queries per second.
+ */
+int record(int argc, char *argv[]) {
+	if (argc < 6) {
+		std::cout << argv[0] << " record pathToGraph numQueries queriesPerSecond pathToLog [--path-ratio=P] [--metrics=N] [--seed=N]" << std::endl;
+		return 1;
+	}
+
+	std::string graphFile = argv[2];
+	CRP::count numQueries = std::stoul(argv[3]);
+	double queriesPerSecond = std::stod(argv[4]);
+	std::string logFile = argv[5];
+	double pathRatio = 1.0;
+	CRP::count numMetrics = 1;
+	uint32_t seed = 42;
+	for (int i = 6; i < argc; ++i) {
+		std::string arg(argv[i]);
+		if (arg.compare(0, 13, "--path-ratio=") == 0) {
+			pathRatio = std::stod(arg.substr(13));
+		} else if (arg.compare(0, 10, "--metrics=") == 0) {
+			numMetrics = std::stoul(arg.substr(10));
+		} else if (arg.compare(0, 7, "--seed=") == 0) {
+			seed = std::stoul(arg.substr(7));
+		} else {
+			std::cout << "unknown option " << arg << std::endl;
+			return 1;
+		}
+	}
+	if (queriesPerSecond <= 0 || numMetrics < 1) {
+		std::cout << "ERROR: queriesPerSecond and the number of metrics must be positive" << std::endl;
+		return 1;
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	std::mt19937 rand(seed);
+	std::uniform_int_distribution<CRP::index> edgeDistribution(0, graph.numberOfEdges() - 1);
+	std::uniform_int_distribution<CRP::index> metricDistribution(0, numMetrics - 1);
+	std::uniform_real_distribution<double> modeDistribution(0, 1);
+	std::exponential_distribution<double> interArrivalTime(queriesPerSecond / 1000000.0);
+
+	CRP::QueryLog log;
+	double arrivalTime = 0;
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		if (i > 0) arrivalTime += interArrivalTime(rand);
+		const CRP::index sourceEdge = edgeDistribution(rand);
+		const CRP::index targetEdge = edgeDistribution(rand);
+		const CRP::QueryLog::OUTPUT_MODE outputMode = modeDistribution(rand) < pathRatio ? CRP::QueryLog::PATH : CRP::QueryLog::WEIGHT_ONLY;
+		log.add({(long long) arrivalTime, sourceEdge, targetEdge, metricDistribution(rand), outputMode});
+	}
+
+	if (!log.write(logFile)) {
+		std::cout << "ERROR: could not write " << logFile << std::endl;
+		return 1;
+	}
+	std::cout << "Wrote " << log.size() << " queries over " << log.getDuration() / 1000000.0 << " s" << std::endl;
+	return 0;
+}
+
+/**
+ * Runs the queries of a log with a pool of threads, each with its own query object. In closed-loop mode every
+ * thread starts its next query as soon as the previous one is done and the latency is the time of the query. In
+ * open-loop mode a query is not started before its arrival time, divided by the speed factor, and the latency
+ * includes the time it waited for a free thread.
+ */
+int replay(int argc, char *argv[]) {
+	if (argc < 7) {
+		std::cout << argv[0] << " replay pathToGraph pathToOverlayGraph metricDirectory metricTypes pathToLog [--open-loop] [--speed=F] [--threads=N] [--engine=bi|uni|par]" << std::endl;
+		std::cout << "metricTypes is a comma separated list, metric id i of the log uses the i-th metric" << std::endl;
+		return 1;
+	}
+
+	std::string graphFile = argv[2];
+	std::string overlayGraphFile = argv[3];
+	std::string metricDirectory = argv[4];
+	std::string metricTypes = argv[5];
+	std::string logFile = argv[6];
+	if (!metricDirectory.empty() && metricDirectory.back() != '/') metricDirectory += "/";
+
+	bool openLoop = false;
+	double speed = 1.0;
+	int numThreads = 1;
+	std::string engine = "bi";
+	for (int i = 7; i < argc; ++i) {
+		std::string arg(argv[i]);
+		if (arg == "--open-loop") {
+			openLoop = true;
+		} else if (arg.compare(0, 8, "--speed=") == 0) {
+			speed = std::stod(arg.substr(8));
+		} else if (arg.compare(0, 10, "--threads=") == 0) {
+			numThreads = std::stoi(arg.substr(10));
+		} else if (arg.compare(0, 9, "--engine=") == 0) {
+			engine = arg.substr(9);
+		} else {
+			std::cout << "unknown option " << arg << std::endl;
+			return 1;
+		}
+	}
+	if (speed <= 0 || numThreads < 1 || (engine != "bi" && engine != "uni" && engine != "par")) {
+		std::cout << "ERROR: invalid speed, number of threads or engine" << std::endl;
+		return 1;
+	}
+
+	CRP::QueryLog log;
+	if (!log.read(logFile)) {
+		std::cout << "ERROR: " << logFile << " is no valid query log" << std::endl;
+		return 1;
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	cout << "Reading metrics" << endl;
+	std::vector<CRP::Metric> metrics;
+	std::stringstream types(metricTypes);
+	std::string metricType;
+	while (std::getline(types, metricType, ',')) {
+		std::unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+		if (!costFunction) {
+			std::cout << "ERROR: Unknown metric type " << metricType << std::endl;
+			return 1;
+		}
+		std::ifstream stream(metricDirectory + CRP::getMetricName(metricType));
+		if (!stream.is_open()) {
+			std::cout << "ERROR: could not open " << metricDirectory + CRP::getMetricName(metricType) << std::endl;
+			return 1;
+		}
+		metrics.emplace_back();
+		CRP::Metric::read(stream, metrics.back(), std::move(costFunction), &overlayGraph);
+	}
+
+	for (CRP::index i = 0; i < log.size(); ++i) {
+		const CRP::QueryLog::LoggedQuery &query = log.getQuery(i);
+		if (query.sourceEdge >= graph.numberOfEdges() || query.targetEdge >= graph.numberOfEdges() || query.metricId >= metrics.size()) {
+			std::cout << "ERROR: query " << i << " does not fit the graph or the metrics" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "Done" << std::endl;
+	std::cout << "Replaying " << log.size() << " queries " << (openLoop ? "open-loop" : "closed-loop") << " with " << numThreads
+			<< " threads" << std::endl;
+
+	std::vector<long long> latencies(log.size());
+	std::vector<long long> waitingTimes(log.size());
+	std::atomic<CRP::index> nextQuery(0);
+	long long start = 0;
+	std::atomic<long long> end(0);
+
+#pragma omp parallel num_threads(numThreads)
+	{
+		// the search contexts are set up before the clock starts
+		CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+		std::unique_ptr<CRP::Query> query;
+		if (engine == "uni") {
+			query.reset(new CRP::CRPQueryUni<>(graph, overlayGraph, metrics, pathUnpacker));
+		} else if (engine == "par") {
+			query.reset(new CRP::ParallelCRPQuery<>(graph, overlayGraph, metrics, pathUnpacker));
+		} else {
+			query.reset(new CRP::CRPQuery<>(graph, overlayGraph, metrics, pathUnpacker));
+		}
+
+#pragma omp barrier
+#pragma omp master
+		start = get_micro_time();
+#pragma omp barrier
+
+		for (CRP::index i = nextQuery++; i < log.size(); i = nextQuery++) {
+			const CRP::QueryLog::LoggedQuery &loggedQuery = log.getQuery(i);
+			const long long arrival = start + (long long) (loggedQuery.arrivalTime / speed);
+			long long queryStart = get_micro_time();
+			if (openLoop && queryStart < arrival) {
+				std::this_thread::sleep_for(std::chrono::microseconds(arrival - queryStart));
+				queryStart = get_micro_time();
+			}
+
+			query->setUnpackPaths(loggedQuery.outputMode == CRP::QueryLog::PATH);
+			query->edgeQuery(loggedQuery.sourceEdge, loggedQuery.targetEdge, loggedQuery.metricId);
+			const long long queryEnd = get_micro_time();
+
+			waitingTimes[i] = openLoop ? std::max(queryStart - arrival, 0ll) : 0;
+			latencies[i] = queryEnd - queryStart + waitingTimes[i];
+			long long lastEnd = end.load();
+			while (queryEnd > lastEnd && !end.compare_exchange_weak(lastEnd, queryEnd)) {}
+		}
+	}
+
+	const double seconds = std::max(end.load() - start, 1ll) / 1000000.0;
+	std::cout << std::fixed << std::setprecision(3) << "Time: " << seconds << " s, throughput: " << std::setprecision(1) << log.size() / seconds << " queries/s";
+	if (openLoop) {
+		std::cout << " (offered: " << log.size() / std::max(log.getDuration() / speed / 1000000.0, 1e-6) << " queries/s)";
+	}
+	std::cout << std::endl;
+
+	std::vector<long long> weightOnlyLatencies;
+	std::vector<long long> pathLatencies;
+	CRP::count lateQueries = 0;
+	for (CRP::index i = 0; i < log.size(); ++i) {
+		if (log.getQuery(i).outputMode == CRP::QueryLog::PATH) {
+			pathLatencies.push_back(latencies[i]);
+		} else {
+			weightOnlyLatencies.push_back(latencies[i]);
+		}
+		if (waitingTimes[i] > 1000) lateQueries++;
+	}
+
+	std::cout << std::setw(12) << std::left << "latency [ms]" << std::right << std::setw(10) << "queries" << std::setw(10) << "mean"
+			<< std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+	printLatencies("all", latencies);
+	printLatencies("weight only", weightOnlyLatencies);
+	printLatencies("path", pathLatencies);
+	if (openLoop) {
+		std::cout << "Queries that waited more than 1 ms for a thread: " << lateQueries << std::endl;
+	}
+
+	return 0;
+}
+
+/**
+ * Records query logs with synthetic traffic and replays query logs against the query algorithms, either as fast as
+ * possible or at the recorded arrival times.
+ */
+int main(int argc, char *argv[]) {
+	const std::string mode = argc > 1 ? argv[1] : "";
+	if (mode == "record") {
+		return record(argc, argv);
+	} else if (mode == "replay") {
+		return replay(argc, argv);
+	}
+
+	std::cout << argv[0] << " record pathToGraph numQueries queriesPerSecond pathToLog [--path-ratio=P] [--metrics=N] [--seed=N]" << std::endl;
+	std::cout << argv[0] << " replay pathToGraph pathToOverlayGraph metricDirectory metricTypes pathToLog [--open-loop] [--speed=F] [--threads=N] [--engine=bi|uni|par]" << std::endl;
+	return 1;
+}
@@ -35,10 +35,7 @@
 #include "../datastructures/QueryResult.h"
 #include "../io/GraphIO.h"
 #include "../metrics/Metric.h"
-#include "../metrics/DistanceFunction.h"
-#include "../metrics/HopFunction.h"
-#include "../metrics/TimeFunction.h"
-#include "../metrics/CostFunction.h"
+#include "../metrics/CostFunctionFactory.h"
 
 #include "../timer.h"
 #include "../constants.h"
@@ -47,9 +44,42 @@
 #include <memory>
 #include <iomanip>
 #include <fstream>
+#include <random>
+#include <functional>
 
 using namespace std;
 
+/**
+ * @return the time in microseconds that @a query takes for all @a queries. If compiled with QUERYSTATS, the
+ * statistics of the queries are added to @a stats.
+ */
+long long runQueries(CRP::Query &query, const std::vector<std::pair<CRP::index, CRP::index>> &queries, CRP::QueryStats &stats) {
+	long long sum = 0;
+	for (const std::pair<CRP::index, CRP::index> &q : queries) {
+		long long start = get_micro_time();
+		CRP::QueryResult result = query.vertexQuery(q.first, q.second, 0);
+		sum += get_micro_time() - start;
+		QUERY_STATS(stats += result.stats;)
+	}
+	return sum;
+}
+
+#ifdef QUERYSTATS
+void printStats(const std::string &name, const CRP::QueryStats &stats, CRP::count numQueries) {
+	const double n = numQueries;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << name << " (avg per query): settled graph vertices = " << stats.settledGraphVertices / n
+			<< ", settled overlay vertices = " << stats.getSettledOverlayVertices() / n << " (";
+	for (CRP::level l = 1; l < stats.settledOverlayVertices.size(); ++l) {
+		std::cout << (l > 1 ? ", " : "") << "level " << (int) l << ": " << stats.settledOverlayVertices[l] / n;
+	}
+	std::cout << "), relaxed edges = " << stats.relaxedEdges / n << ", stalled labels = " << stats.stalledLabels / n
+			<< ", pushes = " << stats.queuePushes / n << ", decrease keys = " << stats.decreaseKeys / n
+			<< ", meeting point updates = " << stats.meetingPointUpdates / n << ", search = " << stats.searchTime / n
+			<< " us, unpack = " << stats.unpackTime / n << " us" << std::endl;
+}
+#endif
+
 int main(int argc, char *argv[]) {
 	if (argc < 6) {
 		std::cout << argv[0] << " numQueries pathToGraph pathToOverlayGraph pathToMetric metricType" << std::endl;
@@ -73,22 +103,14 @@ int main(int argc, char *argv[]) {
 
 	cout << "Reading metric" << endl;
 	vector<CRP::Metric> metrics(1);
-	if (metricType == "dist") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::DistanceFunction()));
-		stream.close();
-	} else if (metricType == "hop") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::HopFunction()));
-		stream.close();
-	} else if (metricType == "time") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::TimeFunction()));
-		stream.close();
-	} else {
+	std::unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+	if (!costFunction) {
 		std::cout << "ERROR: Unknown metic type " << metricType << std::endl;
 		return 1;
 	}
+	std::ifstream stream(metricPath);
+	CRP::Metric::read(stream, metrics[0], std::move(costFunction), &overlayGraph);
+	stream.close();
 
 	std::cout << "Done" << std::endl;
 
@@ -97,14 +119,16 @@ int main(int argc, char *argv[]) {
 	                           mt19937(get_micro_time()));
 
 	CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
-	CRP::CRPQueryUni query(graph, overlayGraph, metrics, pathUnpacker);
-	CRP::CRPQuery biQuery(graph, overlayGraph, metrics, pathUnpacker);
-	CRP::ParallelCRPQuery parQuery(graph, overlayGraph, metrics, pathUnpacker);
-	long long start;
-	long long end;
+	CRP::CRPQueryUni<> query(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::CRPQuery<> biQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::ParallelCRPQuery<> parQuery(graph, overlayGraph, metrics, pathUnpacker);
 	CRP::index sum = 0;
 	CRP::index biSum = 0;
 	CRP::index parSum = 0;
+	CRP::QueryStats uniStats;
+	CRP::QueryStats biStats;
+	CRP::QueryStats parStats;
+	CRP::QueryStats otherQueueStats;
 	
 	std::vector<std::pair<CRP::index, CRP::index>> queries(numQueries);
 	for (CRP::index i = 0; i < numQueries; ++i) {
@@ -112,37 +136,22 @@ int main(int argc, char *argv[]) {
 	}
 
 	std::cout << "Running uni queries" << std::endl;		
-	for (std::pair<CRP::index, CRP::index> &q : queries) {
-		CRP::index source = q.first;
-		CRP::index target = q.second;
-
-		start = get_micro_time();
-        query.vertexQuery(source, target, 0);
-        end = get_micro_time();			
-        sum += end - start;
-	}
+	sum = runQueries(query, queries, uniStats);
 
 	std::cout << "Running bi queries" << std::endl;	
-	for (std::pair<CRP::index, CRP::index> &q : queries) {
-		CRP::index source = q.first;
-		CRP::index target = q.second;
-
-		start = get_micro_time();
-		biQuery.vertexQuery(source, target, 0);
-		end = get_micro_time();				
-		biSum += end - start;
-	}
+	biSum = runQueries(biQuery, queries, biStats);
 
 	std::cout << "Running parallel queries" << std::endl;
-	for (std::pair<CRP::index, CRP::index> &q : queries) {
-		CRP::index source = q.first;
-		CRP::index target = q.second;
-
-		start = get_micro_time();
-		parQuery.vertexQuery(source, target, 0);
-		end = get_micro_time();		
-		parSum += end - start;
-	}
+	parSum = runQueries(parQuery, queries, parStats);
+
+	std::cout << "Running bi queries with other priority queues" << std::endl;
+	CRP::CRPQuery<CRP::BinaryIDQueue> binaryHeapQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::CRPQuery<CRP::OctaryIDQueue> octaryHeapQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::CRPQuery<CRP::RadixIDQueue> radixHeapQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::index binaryHeapSum = runQueries(binaryHeapQuery, queries, otherQueueStats) / 1000;
+	CRP::index octaryHeapSum = runQueries(octaryHeapQuery, queries, otherQueueStats) / 1000;
+	CRP::index radixHeapSum = runQueries(radixHeapQuery, queries, otherQueueStats) / 1000;
+
 	sum /= 1000;
 	biSum /= 1000;
 	parSum /= 1000;
@@ -150,6 +159,16 @@ int main(int argc, char *argv[]) {
 	std::cout << "Uni Took " << sum << " ms. Avg = " << (double)sum/(double)numQueries << " ms." << std::endl;
 	std::cout << "Bi Took " << biSum << " ms. Avg = " << (double)biSum/(double)numQueries << " ms." << std::endl;
 	std::cout << "Par Took " << parSum << " ms. Avg = " << (double)parSum/(double)numQueries << " ms." << std::endl;
+	std::cout << "Par speedup over Bi = " << (double)biSum/(double)parSum << std::endl;
+	std::cout << "Bi (binary heap) Took " << binaryHeapSum << " ms. Avg = " << (double)binaryHeapSum/(double)numQueries << " ms." << std::endl;
+	std::cout << "Bi (8-ary heap) Took " << octaryHeapSum << " ms. Avg = " << (double)octaryHeapSum/(double)numQueries << " ms." << std::endl;
+	std::cout << "Bi (radix heap) Took " << radixHeapSum << " ms. Avg = " << (double)radixHeapSum/(double)numQueries << " ms." << std::endl;
+
+#ifdef QUERYSTATS
+	printStats("Uni", uniStats, numQueries);
+	printStats("Bi", biStats, numQueries);
+	printStats("Par", parStats, numQueries);
+#endif
 
 
 	return 0;
@@ -0,0 +1,183 @@
+/*
+ * RankQueryTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQuery.h"
+#include "../algorithm/CRPQueryUni.h"
+#include "../algorithm/Dijkstra.h"
+#include "../algorithm/ParallelCRPQuery.h"
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryResult.h"
+#include "../io/GraphIO.h"
+#include "../metrics/Metric.h"
+#include "../metrics/CostFunctionFactory.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct RankQuery {
+	CRP::index source;
+	CRP::index target;
+	CRP::count logRank; // the target has Dijkstra rank 2^logRank
+};
+
+/** @return the @a p quantile of the sorted @a times (nearest rank) */
+long long percentile(const std::vector<long long> &times, double p) {
+	const size_t rank = std::max(1.0, std::ceil(p * times.size()));
+	return times[std::min(rank, times.size()) - 1];
+}
+
+/**
+ * Builds Dijkstra-rank query sets and reports the latency percentiles of each query algorithm per rank. For every
+ * random source, a plain Dijkstra search yields one target per rank 2^k. Every query algorithm runs the same warm-up
+ * queries first. Both sets use fixed seeds, so that the results of two builds can be compared line by line.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 7) {
+		std::cout << argv[0] << " numSources pathToGraph pathToOverlayGraph pathToMetric metricType outputFile [--seed=N] [--warmup=N]" << std::endl;
+		return 1;
+	}
+
+	CRP::count numSources = std::stoi(argv[1]);
+	std::string graphFile = argv[2];
+	std::string overlayGraphFile = argv[3];
+	std::string metricPath = argv[4];
+	std::string metricType = argv[5];
+	std::string outputFile = argv[6];
+	unsigned seed = 42;
+	CRP::count numWarmupQueries = 100;
+	for (int i = 7; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg.compare(0, 7, "--seed=") == 0) {
+			seed = std::stoul(arg.substr(7));
+		} else if (arg.compare(0, 9, "--warmup=") == 0) {
+			numWarmupQueries = std::stoi(arg.substr(9));
+		} else {
+			std::cout << "ERROR: Unknown option " << arg << std::endl;
+			return 1;
+		}
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	cout << "Reading metric" << endl;
+	vector<CRP::Metric> metrics(1);
+	std::unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+	if (!costFunction) {
+		std::cout << "ERROR: Unknown metric type " << metricType << std::endl;
+		return 1;
+	}
+	std::ifstream stream(metricPath);
+	CRP::Metric::read(stream, metrics[0], std::move(costFunction), &overlayGraph);
+	stream.close();
+
+	std::cout << "Done" << std::endl;
+
+	std::mt19937 rand(seed);
+	std::uniform_int_distribution<CRP::index> vertexDistribution(0, graph.numberOfVertices() - 1);
+
+	std::cout << "Computing Dijkstra ranks" << std::endl;
+	CRP::Dijkstra<> dijkstra(graph, overlayGraph, metrics);
+	std::vector<RankQuery> queries;
+	CRP::count maxLogRank = 0;
+	for (CRP::index i = 0; i < numSources; ++i) {
+		const CRP::index source = vertexDistribution(rand);
+		std::vector<CRP::index> order = dijkstra.computeSettleOrder(source, 0);
+		for (CRP::count logRank = 0; (1u << logRank) < order.size(); ++logRank) {
+			queries.push_back({source, order[1u << logRank], logRank});
+			maxLogRank = std::max(maxLogRank, logRank);
+		}
+	}
+
+	CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+	CRP::CRPQueryUni<> uniQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::CRPQuery<> biQuery(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::ParallelCRPQuery<> parQuery(graph, overlayGraph, metrics, pathUnpacker);
+	std::vector<std::pair<std::string, CRP::Query*>> engines = {{"Uni", &uniQuery}, {"Bi", &biQuery}, {"Par", &parQuery}};
+
+	std::ofstream output(outputFile);
+	if (!output.is_open()) {
+		std::cout << "ERROR: Could not open " << outputFile << std::endl;
+		return 1;
+	}
+	output << "engine,rank,queries,p50,p90,p99,max" << std::endl;
+
+	std::cout << "Latencies in us per rank" << std::endl;
+	std::cout << std::setw(6) << "engine" << std::setw(10) << "rank" << std::setw(8) << "queries" << std::setw(10) << "p50"
+			<< std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+	for (const std::pair<std::string, CRP::Query*> &engine : engines) {
+		// every engine gets the same warm-up queries, drawn independently of the measured ones
+		std::mt19937 warmupRand(seed + 1);
+		for (CRP::count i = 0; i < numWarmupQueries; ++i) {
+			const CRP::index source = vertexDistribution(warmupRand);
+			engine.second->vertexQuery(source, vertexDistribution(warmupRand), 0);
+		}
+
+		std::vector<std::vector<long long>> times(maxLogRank + 1);
+		for (const RankQuery &query : queries) {
+			long long start = get_micro_time();
+			engine.second->vertexQuery(query.source, query.target, 0);
+			times[query.logRank].push_back(get_micro_time() - start);
+		}
+
+		for (CRP::count logRank = 0; logRank <= maxLogRank; ++logRank) {
+			std::vector<long long> &rankTimes = times[logRank];
+			if (rankTimes.empty()) continue;
+			std::sort(rankTimes.begin(), rankTimes.end());
+			const long long p50 = percentile(rankTimes, 0.5);
+			const long long p90 = percentile(rankTimes, 0.9);
+			const long long p99 = percentile(rankTimes, 0.99);
+			const CRP::count rank = 1u << logRank;
+
+			output << engine.first << "," << rank << "," << rankTimes.size() << "," << p50 << "," << p90 << "," << p99 << "," << rankTimes.back() << std::endl;
+			std::cout << std::setw(6) << engine.first << std::setw(10) << rank << std::setw(8) << rankTimes.size() << std::setw(10) << p50
+					<< std::setw(10) << p90 << std::setw(10) << p99 << std::setw(10) << rankTimes.back() << std::endl;
+		}
+	}
+	output.close();
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * SyntheticGraphTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQuery.h"
+#include "../algorithm/Dijkstra.h"
+#include "../algorithm/PathUnpacker.h"
+#include "../datastructures/Graph.h"
+#include "../datastructures/MultiLevelPartition.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryResult.h"
+#include "../generator/SyntheticGraph.h"
+#include "../metrics/CostFunctionFactory.h"
+#include "../metrics/Metric.h"
+#include "../precalculation/CellNumbers.h"
+
+#include "../constants.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Checks that the forward and backward edges of @a graph match and that every vertex can be entered and left.
+ */
+bool checkGraph(const CRP::Graph &graph) {
+	for (CRP::index u = 0; u < graph.numberOfVertices(); ++u) {
+		if (graph.getInDegree(u) == 0 || graph.getOutDegree(u) == 0) {
+			cout << "vertex " << u << " has in-degree " << graph.getInDegree(u) << " and out-degree " << graph.getOutDegree(u) << endl;
+			return false;
+		}
+		for (CRP::index e = graph.getExitOffset(u); e < graph.getExitOffset(u) + graph.getOutDegree(u); ++e) {
+			if (graph.getTailOfForwardEdge(e) != u) {
+				cout << "forward edge " << e << " of " << u << " has no matching backward edge" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks that the cells of @a mlp respect the maximum cell sizes and that every cell is contained in a cell of the
+ * next higher level.
+ */
+bool checkPartition(const CRP::MultiLevelPartition &mlp, const vector<CRP::count> &maxCellSizes) {
+	for (CRP::level l = 0; l < mlp.getNumberOfLevels(); ++l) {
+		vector<CRP::count> cellSizes(mlp.getNumberOfCellsInLevel(l), 0);
+		vector<CRP::index> parent(mlp.getNumberOfCellsInLevel(l), invalid_id);
+		for (CRP::index v = 0; v < mlp.getNumberOfVertices(); ++v) {
+			const CRP::index cell = mlp.getCell(l, v);
+			cellSizes[cell]++;
+			if (l + 1u < mlp.getNumberOfLevels()) {
+				const CRP::index parentCell = mlp.getCell(l + 1, v);
+				if (parent[cell] != invalid_id && parent[cell] != parentCell) {
+					cout << "cell " << cell << " of level " << (int) l << " is in several cells of the next level" << endl;
+					return false;
+				}
+				parent[cell] = parentCell;
+			}
+		}
+		for (CRP::count size : cellSizes) {
+			if (size == 0 || size > maxCellSizes[l]) {
+				cout << "cell of level " << (int) l << " has " << size << " vertices" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Builds overlay graph and time metric of @a graph and compares the bidirectional CRP query with Dijkstra.
+ */
+bool checkQueries(CRP::Graph &graph, const CRP::MultiLevelPartition &mlp, CRP::count numQueries) {
+	CRP::buildCellNumbers(graph, mlp);
+	graph.sortVerticesByCellNumber();
+	CRP::OverlayGraph overlayGraph(graph, mlp);
+	vector<CRP::Metric> metrics;
+	metrics.emplace_back(graph, overlayGraph, CRP::createCostFunction("time"));
+
+	CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+	CRP::Dijkstra<> dijkstra(graph, overlayGraph, metrics);
+	CRP::CRPQuery<> query(graph, overlayGraph, metrics, pathUnpacker);
+
+	mt19937 generator(42);
+	uniform_int_distribution<CRP::index> vertexDistribution(0, graph.numberOfVertices() - 1);
+	CRP::count errors = 0;
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		const CRP::index s = vertexDistribution(generator);
+		const CRP::index t = vertexDistribution(generator);
+		const CRP::weight expected = dijkstra.vertexQuery(s, t, 0).pathWeight;
+		const CRP::weight actual = query.vertexQuery(s, t, 0).pathWeight;
+		if (expected != actual || expected == inf_weight) {
+			cout << "query " << s << " -> " << t << ": Dijkstra " << expected << ", CRP " << actual << endl;
+			errors++;
+		}
+	}
+	return errors == 0;
+}
+
+/**
+ * Generates a small grid and a small geometric graph with their partitions, checks their structure and compares CRP
+ * queries on them with Dijkstra. All vertices must be reachable, since only the largest strongly connected component
+ * is kept.
+ */
+int main(int argc, char *argv[]) {
+	const CRP::count numQueries = argc > 1 ? stoul(argv[1]) : 200;
+	const vector<CRP::count> maxCellSizes = {32, 256, 2048};
+	bool ok = true;
+
+	for (const string type : {"grid", "geometric"}) {
+		cout << "Generating " << type << " graph" << endl;
+		CRP::SyntheticGraph generator(7, 0.2f, 0.05f);
+		CRP::Graph graph;
+		if (type == "grid") {
+			ok &= generator.generateGrid(graph, 60, 50);
+		} else {
+			ok &= generator.generateGeometric(graph, 3000, 2, 6);
+		}
+
+		// the same seed generates the same graph
+		CRP::SyntheticGraph sameGenerator(7, 0.2f, 0.05f);
+		CRP::Graph sameGraph;
+		if (type == "grid") {
+			sameGenerator.generateGrid(sameGraph, 60, 50);
+		} else {
+			sameGenerator.generateGeometric(sameGraph, 3000, 2, 6);
+		}
+		if (sameGraph.numberOfEdges() != graph.numberOfEdges() || sameGraph.getTurnTables() != graph.getTurnTables()) {
+			cout << "graphs with the same seed differ" << endl;
+			ok = false;
+		}
+
+		ok = ok && checkGraph(graph);
+		CRP::MultiLevelPartition mlp = CRP::SyntheticGraph::partition(graph, maxCellSizes);
+		ok = ok && mlp.getNumberOfVertices() == graph.numberOfVertices() && checkPartition(mlp, maxCellSizes);
+		ok = ok && checkQueries(graph, mlp, numQueries);
+	}
+
+	cout << (ok ? "all checks passed" : "FAILED") << endl;
+	return ok ? 0 : 1;
+}
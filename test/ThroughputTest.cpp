@@ -0,0 +1,161 @@
+/*
+ * ThroughputTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../algorithm/CRPQuery.h"
+#include "../algorithm/PathUnpacker.h"
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../datastructures/QueryResult.h"
+#include "../io/GraphIO.h"
+#include "../metrics/Metric.h"
+#include "../metrics/CostFunctionFactory.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <iostream>
+#include <memory>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include "omp.h"
+
+using namespace std;
+
+/**
+ * Runs the same query mix with 1, 2, 4, ... threads and reports the throughput and the scaling efficiency. Graph,
+ * overlay graph and metric are shared, each thread has its own query and path unpacker. The results of all runs
+ * are compared with the ones of the single-threaded run.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 6) {
+		std::cout << argv[0] << " numQueries pathToGraph pathToOverlayGraph pathToMetric metricType [maxThreads]" << std::endl;
+		return 1;
+	}
+
+	CRP::count numQueries = std::stoi(argv[1]);
+	std::string graphFile = argv[2];
+	std::string overlayGraphFile = argv[3];
+	std::string metricPath = argv[4];
+	std::string metricType = argv[5];
+	const int maxThreads = argc > 6 ? std::stoi(argv[6]) : omp_get_max_threads();
+	if (maxThreads < 1) {
+		std::cout << "ERROR: maxThreads must be positive" << std::endl;
+		return 1;
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	cout << "Reading metric" << endl;
+	vector<CRP::Metric> metrics(1);
+	std::unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+	if (!costFunction) {
+		std::cout << "ERROR: Unknown metric type " << metricType << std::endl;
+		return 1;
+	}
+	std::ifstream stream(metricPath);
+	CRP::Metric::read(stream, metrics[0], std::move(costFunction), &overlayGraph);
+	stream.close();
+
+	std::cout << "Done" << std::endl;
+
+	// fixed seed, so that every run and every build uses the same query mix
+	std::mt19937 rand(42);
+	std::uniform_int_distribution<CRP::index> vertexDistribution(0, graph.numberOfVertices() - 1);
+	std::vector<std::pair<CRP::index, CRP::index>> queries(numQueries);
+	for (CRP::index i = 0; i < numQueries; ++i) {
+		queries[i].first = vertexDistribution(rand);
+		queries[i].second = vertexDistribution(rand);
+	}
+
+	std::vector<int> threadCounts;
+	for (int t = 1; t < maxThreads; t *= 2) {
+		threadCounts.push_back(t);
+	}
+	threadCounts.push_back(maxThreads);
+
+	std::vector<CRP::weight> expected;
+	std::vector<CRP::weight> results(numQueries);
+	double singleThreadThroughput = 0;
+	CRP::count errors = 0;
+
+	std::cout << std::setw(8) << "threads" << std::setw(12) << "time [ms]" << std::setw(14) << "queries/s" << std::setw(10) << "speedup"
+			<< std::setw(12) << "efficiency" << std::endl;
+	for (int numThreads : threadCounts) {
+		long long start = 0;
+		long long end = 0;
+
+#pragma omp parallel num_threads(numThreads)
+		{
+			// the search contexts are set up before the clock starts
+			CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
+			CRP::CRPQuery<> query(graph, overlayGraph, metrics, pathUnpacker);
+
+#pragma omp barrier
+#pragma omp master
+			start = get_micro_time();
+#pragma omp barrier
+
+#pragma omp for schedule(dynamic, 16)
+			for (CRP::index i = 0; i < numQueries; ++i) {
+				results[i] = query.vertexQuery(queries[i].first, queries[i].second, 0).pathWeight;
+			}
+
+#pragma omp master
+			end = get_micro_time();
+		}
+
+		if (expected.empty()) {
+			expected = results;
+		} else {
+			for (CRP::index i = 0; i < numQueries; ++i) {
+				if (results[i] != expected[i]) errors++;
+			}
+		}
+
+		const double seconds = std::max(end - start, 1ll) / 1000000.0;
+		const double throughput = numQueries / seconds;
+		if (numThreads == 1) singleThreadThroughput = throughput;
+		const double speedup = throughput / singleThreadThroughput;
+
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << std::setw(8) << numThreads << std::setw(12) << seconds * 1000 << std::setw(14) << throughput
+				<< std::setprecision(2) << std::setw(10) << speedup << std::setw(12) << speedup / numThreads << std::endl;
+	}
+
+	std::cout << "Wrong results: " << errors << std::endl;
+
+	return errors == 0 ? 0 : 1;
+}
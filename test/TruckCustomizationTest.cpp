@@ -0,0 +1,100 @@
+/*
+ * TruckCustomizationTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Michael Wegner & Matthias Wolf
+ *
+ * Copyright (c) 2016 Michael Wegner and Matthias Wolf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../datastructures/Graph.h"
+#include "../datastructures/OverlayGraph.h"
+#include "../io/GraphIO.h"
+#include "../metrics/Metric.h"
+#include "../metrics/TruckFunction.h"
+
+#include "../timer.h"
+#include "../constants.h"
+
+#include <iostream>
+#include <memory>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Customizes one truck metric per height class and reports how many height classes can be customized per minute.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 6) {
+		std::cout << argv[0] << " pathToGraph pathToOverlayGraph minHeight maxHeight heightStep" << std::endl;
+		return 1;
+	}
+
+	std::string graphFile = argv[1];
+	std::string overlayGraphFile = argv[2];
+	float minHeight = std::stof(argv[3]);
+	float maxHeight = std::stof(argv[4]);
+	float heightStep = std::stof(argv[5]);
+	if (heightStep <= 0 || maxHeight < minHeight) {
+		std::cout << "ERROR: invalid height classes" << std::endl;
+		return 1;
+	}
+
+	cout << "Reading graph" << endl;
+	CRP::Graph graph;
+	CRP::GraphIO::readGraph(graph, graphFile);
+
+	cout << "Reading overlay graph" << endl;
+	CRP::OverlayGraph overlayGraph;
+	CRP::GraphIO::readOverlayGraph(overlayGraph, overlayGraphFile);
+
+	std::vector<float> heights;
+	for (float height = minHeight; height <= maxHeight + 1e-3f; height += heightStep) {
+		heights.push_back(height);
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	long long totalTime = 0;
+	for (float height : heights) {
+		CRP::count closedEdges = 0;
+		graph.forOutEdges([&](const CRP::ForwardEdge& edge, CRP::index) {
+			if (edge.attributes.maxHeight > 0 && edge.attributes.maxHeight < height) closedEdges++;
+		});
+
+		long long start = get_micro_time();
+		CRP::Metric metric(graph, overlayGraph, std::unique_ptr<CRP::CostFunction>(new CRP::TruckFunction(height)));
+		long long end = get_micro_time();
+		totalTime += end - start;
+
+		std::vector<CRP::weight> weights = metric.getWeights();
+		CRP::count infiniteWeights = std::count(weights.begin(), weights.end(), inf_weight);
+		std::cout << "Height " << height << " m: " << closedEdges << " closed edges, " << infiniteWeights << " of " << weights.size()
+				<< " overlay weights infinite, took " << (double) (end - start) / 1000.0 << " ms" << std::endl;
+	}
+
+	double avgTime = (double) totalTime / heights.size();
+	std::cout << "Customized " << heights.size() << " height classes. Avg = " << avgTime / 1000.0 << " ms." << std::endl;
+	std::cout << "Height classes per minute: " << 60.0 * 1000000.0 / avgTime << std::endl;
+
+	return 0;
+}
@@ -35,10 +35,7 @@
 #include "../datastructures/QueryResult.h"
 #include "../io/GraphIO.h"
 #include "../metrics/Metric.h"
-#include "../metrics/DistanceFunction.h"
-#include "../metrics/HopFunction.h"
-#include "../metrics/TimeFunction.h"
-#include "../metrics/CostFunction.h"
+#include "../metrics/CostFunctionFactory.h"
 
 #include "../timer.h"
 #include "../constants.h"
@@ -47,6 +44,8 @@
 #include <memory>
 #include <iomanip>
 #include <fstream>
+#include <random>
+#include <functional>
 
 using namespace std;
 
@@ -73,22 +72,14 @@ int main(int argc, char *argv[]) {
 
 	cout << "Reading metric" << endl;
 	vector<CRP::Metric> metrics(1);
-	if (metricType == "dist") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::DistanceFunction()));
-		stream.close();
-	} else if (metricType == "hop") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::HopFunction()));
-		stream.close();
-	} else if (metricType == "time") {
-		std::ifstream stream(metricPath);
-		CRP::Metric::read(stream, metrics[0], std::unique_ptr<CRP::CostFunction>(new CRP::TimeFunction()));
-		stream.close();
-	} else {
+	std::unique_ptr<CRP::CostFunction> costFunction = CRP::createCostFunction(metricType);
+	if (!costFunction) {
 		std::cout << "ERROR: Unknown metic type " << metricType << std::endl;
 		return 1;
 	}
+	std::ifstream stream(metricPath);
+	CRP::Metric::read(stream, metrics[0], std::move(costFunction), &overlayGraph);
+	stream.close();
 
 	std::cout << "Done" << std::endl;
 
@@ -97,7 +88,7 @@ int main(int argc, char *argv[]) {
 	                           mt19937(get_micro_time()));
 
 	CRP::PathUnpacker pathUnpacker(graph, overlayGraph, metrics);
-	CRP::CRPQueryUni query(graph, overlayGraph, metrics, pathUnpacker);
+	CRP::CRPQueryUni<> query(graph, overlayGraph, metrics, pathUnpacker);
 		
 	std::vector<std::pair<CRP::index, CRP::index>> queries(numQueries);
 	for (CRP::index i = 0; i < numQueries; ++i) {